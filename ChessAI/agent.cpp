@@ -5,155 +5,551 @@
 #include "move/moveUtil.h"
 #include "util/bitboard/bitboardSet.h"
 #include "util/threadPool.h"
+#include "search/staticExchange.h"
+#include "evaluation/pieceSquareTables.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 
 using namespace util;
 using move::Move;
+using search::Score;
 
 using util::bitboard::BitboardSet;
 
-typedef std::chrono::high_resolution_clock::time_point chronoTime;
-typedef std::chrono::duration<std::chrono::nanoseconds> chronoDuration;
-
-const double PIECE_VALUES[PIECE_TYPE_COUNT] = { 2, 4, 4, 6, 10, 0 }, CHECK_VALUE = 1;
-const double FULL_TEAM_VALUE = PIECE_VALUES[PAWN] * FILE_COUNT
-+ PIECE_VALUES[KNIGHT] * 2
-+ PIECE_VALUES[BISHOP] * 2
-+ PIECE_VALUES[ROOK] * 2
-+ PIECE_VALUES[QUEEN];
-
-Agent::Agent(ChessState& chessState, const Color player, const int quiescentSearchDepth, const int depthLimit) :
-	_chessState(chessState),
+template <typename EvaluationPolicy, typename SearchPolicy>
+SearchAgent<EvaluationPolicy, SearchPolicy>::SearchAgent(ChessState& chessState, const Color player, const int searchDepth, const search::SearchParameters& searchParameters) :
 	_player(player),
-	_quiescentSearchDepth(quiescentSearchDepth),
-	_depthLimit(depthLimit)
+	_chessState(chessState),
+	_searchDepth(searchDepth),
+	_searchParameters(searchParameters),
+	_reductionTable(searchParameters),
+	_nodeCount(0),
+	_searchNodeCount(0),
+	_stopSearch(false),
+	_transpositionTable(searchParameters.transpositionTableSize),
+	_evaluator(searchParameters),
+	_evaluationCache(searchParameters.evaluationCacheSize),
+	_principalVariationTable(std::make_unique<search::PrincipalVariationTable>()),
+	_timeManager(nullptr)
 {
-	if (depthLimit < quiescentSearchDepth)
+	if (searchDepth < 1)
 	{
-		throw std::exception("depthLimit must be greater than or equal to quiescentSearchDepth");
+		throw std::exception("searchDepth must be at least 1");
 	}
 }
 
-Color Agent::getPlayer() const
+template <typename EvaluationPolicy, typename SearchPolicy>
+SearchAgent<EvaluationPolicy, SearchPolicy>::~SearchAgent()
+{
+	stopPondering();
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+Color SearchAgent<EvaluationPolicy, SearchPolicy>::getPlayer() const
 {
 	return _player;
 }
 
-Move Agent::getMove()
+template <typename EvaluationPolicy, typename SearchPolicy>
+Move SearchAgent<EvaluationPolicy, SearchPolicy>::getMove()
+{
+	stopPondering();
+
+	_stopSearch.store(false);
+	return getIterativeDeepeningMove(_chessState, getMaxDepth(_searchDepth));
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+Move SearchAgent<EvaluationPolicy, SearchPolicy>::getMove(const double timeRemaining)
+{
+	// A fixed move time replaces the allocation from the clock
+	const auto createTimeManager = [this, timeRemaining](const std::chrono::steady_clock::time_point& startTime) {
+		return _searchLimits.moveTime.has_value()
+			? search::TimeManager(_searchLimits.moveTime.value(), startTime)
+			: search::TimeManager(timeRemaining, _chessState.getFullTurnCount(), startTime);
+	};
+	Move result;
+
+	if (_ponderThread.joinable() && _ponderState->getZobristKey() == _chessState.getZobristKey() && _ponderState->getBoard() == _chessState.getBoard())
+	{
+		// Ponder hit: the background search becomes the real search once it is given a clock. Time spent pondering
+		// counts towards the move's allocation, so a long enough ponder answers immediately.
+		search::TimeManager timeManager = createTimeManager(_ponderStartTime);
+		if (timeManager.isSoftLimitReached())
+		{
+			_stopSearch.store(true);
+		}
+		_timeManager.store(&timeManager);
+		_ponderThread.join();
+		result = _ponderMove;
+	}
+	else
+	{
+		stopPondering();
+
+		search::TimeManager timeManager = createTimeManager(std::chrono::steady_clock::now());
+		_stopSearch.store(false);
+		_timeManager.store(&timeManager);
+		result = getIterativeDeepeningMove(_chessState, getMaxDepth(search::MAX_PLY));
+	}
+
+	_timeManager.store(nullptr);
+	return result;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+std::vector<search::AnalysisLine> SearchAgent<EvaluationPolicy, SearchPolicy>::getAnalysis(const int lineCount)
 {
+	stopPondering();
+
+	_stopSearch.store(false);
+	return getIterativeDeepeningLines(_chessState, getMaxDepth(_searchDepth), lineCount);
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+void SearchAgent<EvaluationPolicy, SearchPolicy>::setSearchLimits(const search::SearchLimits& searchLimits)
+{
+	stopPondering();
+
+	_searchLimits = searchLimits;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+void SearchAgent<EvaluationPolicy, SearchPolicy>::startPondering()
+{
+	stopPondering();
+
 	const Color enemyPlayer = ~_player;
-	const std::vector<Move> moves = move::getValidMoves(_chessState, _player);
-	std::vector<std::pair<Move, std::future<double>>> moveValuePairs;
+	if (_chessState.getNextTurn() != enemyPlayer)
+	{
+		return;
+	}
 
-	for (const Move& move : moves)
+	// The previous search stored its expected reply for the current game state
+	const std::optional<search::TranspositionEntry> entry = _transpositionTable.probe(_chessState.getZobristKey(), 0);
+	if (!entry.has_value() || !entry->move.has_value())
 	{
-		std::future<double> futureMoveValue = util::ThreadPool::getInstance().submit([this, move, enemyPlayer, newState = _chessState]() mutable {
-			newState.update(_player, move.source, move.destination);
-			return -this->getNegaMaxValue(enemyPlayer, newState, 1, -DBL_MAX, DBL_MAX);
-		});
+		return;
+	}
 
-		moveValuePairs.push_back(std::make_pair(move, std::move(futureMoveValue)));
+	const Move expectedMove = entry->move.value();
+	const std::vector<Move> enemyMoves = move::getValidMoves(_chessState, enemyPlayer);
+	if (std::find(enemyMoves.begin(), enemyMoves.end(), expectedMove) == enemyMoves.end())
+	{
+		return;
 	}
 
-	Move result;
-	double maxValue = -DBL_MAX;
-	for (std::pair<Move, std::future<double>>& moveValuePair : moveValuePairs)
+	_ponderState = std::make_unique<ChessState>(_chessState);
+	_ponderState->update(enemyPlayer, expectedMove);
+	if (_ponderState->getNextTurn() != _player)
+	{
+		return;
+	}
+
+	_stopSearch.store(false);
+	_ponderStartTime = std::chrono::steady_clock::now();
+	_ponderThread = std::thread([this]() {
+		_ponderMove = getIterativeDeepeningMove(*_ponderState, getMaxDepth(search::MAX_PLY));
+	});
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+void SearchAgent<EvaluationPolicy, SearchPolicy>::stopPondering()
+{
+	if (_ponderThread.joinable())
 	{
-		std::future<double> moveFuture = std::move(moveValuePair.second);
-		moveFuture.wait();
-		const double moveValue = moveFuture.get();
+		_stopSearch.store(true);
+		_ponderThread.join();
+	}
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+uint64_t SearchAgent<EvaluationPolicy, SearchPolicy>::getNodeCount() const
+{
+	return _nodeCount.load(std::memory_order_relaxed);
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+const search::SearchStatistics& SearchAgent<EvaluationPolicy, SearchPolicy>::getSearchStatistics() const
+{
+	return _searchStatistics;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+Move SearchAgent<EvaluationPolicy, SearchPolicy>::getIterativeDeepeningMove(const ChessState& rootState, const int maxDepth)
+{
+	const std::vector<search::AnalysisLine> lines = getIterativeDeepeningLines(rootState, maxDepth, 1);
+	return lines.empty() ? Move() : lines.front().move;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+std::vector<search::AnalysisLine> SearchAgent<EvaluationPolicy, SearchPolicy>::getIterativeDeepeningLines(const ChessState& rootState, const int maxDepth, const int lineCount)
+{
+	const std::vector<Move> validMoves = move::getValidMoves(rootState, _player);
+	if (validMoves.empty())
+	{
+		return std::vector<search::AnalysisLine>();
+	}
+
+	const uint64_t rootKey = rootState.getZobristKey();
+	const std::optional<search::TranspositionEntry> rootEntry = _transpositionTable.probe(rootKey, 0);
+	std::vector<Move> rootMoves;
+	for (const auto& entry : getOrderedMoveIndexMap(rootState, _player, validMoves, rootEntry.has_value() ? rootEntry->move : std::nullopt))
+	{
+		rootMoves.push_back(validMoves[entry.second]);
+	}
+
+	std::vector<search::AnalysisLine> result(std::min((size_t)std::max(lineCount, 1), rootMoves.size()));
+	for (size_t lineIndex = 0; lineIndex < result.size(); lineIndex++)
+	{
+		result[lineIndex].move = rootMoves[lineIndex];
+		result[lineIndex].principalVariation = { rootMoves[lineIndex] };
+	}
+
+	search::SearchStatistics statistics;
+	if (_timeManager.load() != nullptr && rootMoves.size() == 1)
+	{
+		_searchStatistics = statistics;
+		return result;
+	}
+
+	_transpositionTable.incrementGeneration();
+	_searchNodeCount.store(0, std::memory_order_relaxed);
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	for (int depth = 1; depth <= maxDepth && !_stopSearch.load(); depth++)
+	{
+		// Each line is the best of the root moves not already covered by an earlier line, so the lines of an
+		// iteration share its move ordering and transposition table entries
+		std::vector<search::AnalysisLine> iterationLines(result.size());
+		size_t completedLineCount = 0;
+		for (size_t lineIndex = 0; lineIndex < result.size() && !_stopSearch.load(); lineIndex++)
+		{
+			// Aspiration windows: the score rarely moves far between iterations, so a narrow window around the previous
+			// score prunes more, and is widened whenever the score falls outside of it
+			const Score previousValue = result[lineIndex].value;
+			Score window = _searchParameters.aspirationWindow;
+			Score alpha = -search::SCORE_INFINITE, beta = search::SCORE_INFINITE;
+			if (_searchParameters.aspirationWindows && depth >= _searchParameters.aspirationMinDepth && !search::isMateScore(previousValue))
+			{
+				alpha = std::max(previousValue - window, -search::SCORE_INFINITE);
+				beta = std::min(previousValue + window, search::SCORE_INFINITE);
+			}
+
+			while (!_stopSearch.load())
+			{
+				std::vector<Move> principalVariation;
+				const Score value = getRootValue(rootState, rootMoves, lineIndex, depth, alpha, beta, principalVariation, statistics);
+				window *= 2;
+
+				if (_stopSearch.load())
+				{
+					break;
+				}
+				else if (value <= alpha)
+				{
+					alpha = std::max(previousValue - window, -search::SCORE_INFINITE);
+				}
+				else if (value >= beta)
+				{
+					beta = std::min(previousValue + window, search::SCORE_INFINITE);
+				}
+				else
+				{
+					iterationLines[lineIndex] = { rootMoves[lineIndex], value, depth, getVerifiedPrincipalVariation(rootState, principalVariation) };
+					completedLineCount++;
+					break;
+				}
+			}
+		}
+
+		// A partially completed iteration may rank the same move in two lines, so only complete iterations are kept
+		if (completedLineCount < result.size())
+		{
+			break;
+		}
 
-		if (moveValue >= maxValue)
+		result = std::move(iterationLines);
+		statistics.depth = depth;
+		statistics.score = result.front().value;
+		_transpositionTable.store(rootKey, 0, result.front().move, result.front().value, depth, search::Bound::EXACT);
+
+		if (isNodeLimitReached())
 		{
-			maxValue = moveValue;
-			result = moveValuePair.first;
+			break;
+		}
+
+		// The time manager may be attached part way through a search when pondering, so it is checked every iteration
+		search::TimeManager* timeManager = _timeManager.load();
+		if (timeManager != nullptr && !_stopSearch.load())
+		{
+			timeManager->completeIteration(result.front().move, result.front().value);
+			if (timeManager->isSoftLimitReached())
+			{
+				break;
+			}
 		}
 	}
 
+	statistics.elapsedTime = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+	_nodeCount.fetch_add(statistics.nodeCount, std::memory_order_relaxed);
+	_searchStatistics = statistics;
+
 	return result;
 }
 
-Move Agent::getMove(const double timeRemaining)
+template <typename EvaluationPolicy, typename SearchPolicy>
+Score SearchAgent<EvaluationPolicy, SearchPolicy>::getRootValue(const ChessState& rootState, std::vector<Move>& rootMoves, const size_t firstMoveIndex, const int depth, Score alpha, const Score beta,
+	std::vector<Move>& principalVariation, search::SearchStatistics& statistics)
 {
-	Move result;
+	const Color enemyPlayer = ~_player;
+	const auto getChildValue = [this, &rootState, enemyPlayer, depth](const Move& move, const Score childAlpha, const Score childBeta, search::SearchStatistics& childStatistics) {
+		ChessState newState(rootState);
+		newState.update(_player, move.source, move.destination);
 
-	const chronoTime startTime = std::chrono::high_resolution_clock::now();
-	double timeElapsed = 0.0;
-	int depth = 1;
+		// Root moves may be searched by any thread, so each one starts the line of the thread searching it
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.setRootState(rootState);
+			_evaluator.pushGameState(newState);
+		}
+		const Score value = -getNegaMaxValue(enemyPlayer, newState, depth - 1, 1, -childBeta, -childAlpha, childStatistics);
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.popGameState();
+		}
+		return value;
+	};
+
+	// Only the calling thread searches with an open window, so it is the only thread that writes lines to the table
+	const auto getPrincipalVariation = [this](const Move& move) {
+		std::vector<Move> result = { move };
+		const std::vector<Move> childLine = _principalVariationTable->getLine(1);
+		result.insert(result.end(), childLine.begin(), childLine.end());
+		return result;
+	};
+
+	// Each task counts into its own cache line, so threads never contend on the counters; the calling thread uses the
+	// first move's statistics
+	std::vector<search::ThreadSearchStatistics> taskStatistics(rootMoves.size());
+	search::SearchStatistics& callerStatistics = taskStatistics[firstMoveIndex].statistics;
+
+	// The first move is expected to be the best, so it is searched alone to establish alpha for the others
+	Score maxValue = getChildValue(rootMoves[firstMoveIndex], alpha, beta, callerStatistics);
+	size_t optimalIndex = firstMoveIndex;
+	principalVariation = getPrincipalVariation(rootMoves[firstMoveIndex]);
+	alpha = std::max(maxValue, alpha);
+
+	if (alpha < beta)
+	{
+		// A single-threaded search searches the other moves in order as they are collected, each against the best value
+		// so far, so nothing is submitted to the thread pool
+		const bool isParallel = !_searchLimits.singleThreaded;
+		std::vector<std::future<Score>> futureMoveValues;
+		std::vector<Score> taskAlphas;
+		for (size_t i = firstMoveIndex + 1; isParallel && i < rootMoves.size(); i++)
+		{
+			taskAlphas.push_back(alpha);
+			futureMoveValues.push_back(util::ThreadPool::getInstance().submit([this, &getChildValue, &taskStatistics = taskStatistics[i].statistics, move = rootMoves[i], alpha]() {
+				const Score value = getChildValue(move, alpha, alpha + 1, taskStatistics);
+				reportNodeCount(taskStatistics);
+				return value;
+			}));
+		}
 
-	do
+		// Every future is waited on since the tasks reference this frame
+		for (size_t i = firstMoveIndex + 1; i < rootMoves.size(); i++)
+		{
+			const Score taskAlpha = isParallel ? taskAlphas[i - firstMoveIndex - 1] : alpha;
+			Score value;
+			if (isParallel)
+			{
+				value = futureMoveValues[i - firstMoveIndex - 1].get();
+			}
+			else
+			{
+				value = getChildValue(rootMoves[i], alpha, alpha + 1, taskStatistics[i].statistics);
+				reportNodeCount(taskStatistics[i].statistics);
+			}
+
+			// A move that beat the null window it was submitted with may be better than the best so far, even if alpha has
+			// since been raised past its value, so it is searched again against the current alpha before the full window
+			if (value > taskAlpha && alpha < beta && !_stopSearch.load())
+			{
+				if (alpha != taskAlpha)
+				{
+					value = getChildValue(rootMoves[i], alpha, alpha + 1, callerStatistics);
+				}
+
+				if (value > alpha && !_stopSearch.load())
+				{
+					value = getChildValue(rootMoves[i], alpha, beta, callerStatistics);
+					if (value > maxValue)
+					{
+						principalVariation = getPrincipalVariation(rootMoves[i]);
+					}
+				}
+			}
+
+			if (value > maxValue)
+			{
+				maxValue = value;
+				optimalIndex = i;
+			}
+			alpha = std::max(value, alpha);
+		}
+	}
+
+	reportNodeCount(callerStatistics);
+	for (const search::ThreadSearchStatistics& threadStatistics : taskStatistics)
 	{
-		result = getMove();
-		timeElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
-		depth += 1;
-	} while (timeHeuristic(timeElapsed, timeRemaining));
+		statistics += threadStatistics.statistics;
+	}
 
-	return result;
+	// Values from a stopped search are incomplete, so the order is left as the last completed search found it
+	if (!_stopSearch.load())
+	{
+		std::rotate(rootMoves.begin() + firstMoveIndex, rootMoves.begin() + optimalIndex, rootMoves.begin() + optimalIndex + 1);
+	}
+
+	return maxValue;
 }
 
-double Agent::evaluateGameState(const ChessState& chessState, const Color player) const
+template <typename EvaluationPolicy, typename SearchPolicy>
+std::vector<Move> SearchAgent<EvaluationPolicy, SearchPolicy>::getVerifiedPrincipalVariation(const ChessState& rootState, const std::vector<Move>& line) const
 {
-	double result = 0.0;
-	const Color enemyPlayer = ~player;
-	double capturePoints = FULL_TEAM_VALUE;
-	const BitboardSet& board = chessState.getBoard();
-	for (int i = PieceType::PAWN; i < PieceType::KING; i++)
-	{
-		const PieceType pieceType = (PieceType)i;
-		const double pieceValue = PIECE_VALUES[pieceType];
-		const Bitboard pieceBoard = board.getBitboard(player, pieceType);
-		if (pieceBoard)
+	std::vector<Move> result;
+	std::vector<uint64_t> visitedKeys = { rootState.getZobristKey() };
+	ChessState chessState(rootState);
+
+	// Every move must be legal in the game state it is played from; the line is cut at the first that is not
+	const auto playMove = [&](const Move& move) {
+		const Color player = chessState.getNextTurn();
+		if (player == Color::NEUTRAL)
+		{
+			return false;
+		}
+
+		const std::vector<Move> validMoves = move::getValidMoves(chessState, player);
+		if (std::find(validMoves.begin(), validMoves.end(), move) == validMoves.end())
 		{
-			result += std::popcount(board.getBitboard(player, pieceType)) * pieceValue;
+			return false;
 		}
 
-		const Bitboard enemyPieceBoard = board.getBitboard(enemyPlayer, pieceType);
-		if (enemyPieceBoard)
+		chessState.update(player, move);
+		result.push_back(move);
+		visitedKeys.push_back(chessState.getZobristKey());
+		return true;
+	};
+
+	for (const Move& move : line)
+	{
+		if (!playMove(move))
 		{
-			capturePoints -= std::popcount(board.getBitboard(enemyPlayer, pieceType)) * pieceValue;
+			return result;
 		}
 	}
 
-	result += capturePoints;
-	result += move::inCheck(enemyPlayer, chessState) * CHECK_VALUE;
-	result -= move::inCheck(player, chessState) * CHECK_VALUE;
+	// Lines cut short by a stopped search or the horizon are continued with the exact entries of the transposition table
+	while (result.size() < search::MAX_PLY)
+	{
+		const std::optional<search::TranspositionEntry> entry = _transpositionTable.probe(chessState.getZobristKey(), (int)result.size());
+		if (!entry.has_value() || !entry->move.has_value() || entry->bound != search::Bound::EXACT || !playMove(entry->move.value()))
+		{
+			break;
+		}
+
+		// A repeated game state would continue the line forever
+		if (std::count(visitedKeys.begin(), visitedKeys.end(), visitedKeys.back()) > 1)
+		{
+			break;
+		}
+	}
 
 	return result;
 }
 
-bool Agent::timeHeuristic(const double timeElapsed, const double timeRemaining) const
+template <typename EvaluationPolicy, typename SearchPolicy>
+Score SearchAgent<EvaluationPolicy, SearchPolicy>::evaluateGameState(const ChessState& chessState, const Color player, search::SearchStatistics& statistics)
 {
-	double turnTime = 0.01 * timeRemaining;
+	if constexpr (!EvaluationPolicy::CACHE_EVALUATIONS)
+	{
+		return _evaluator.evaluate(chessState, player, statistics);
+	}
+
+	// The key covers the next turn, and the player being scored is always the one whose turn it is
+	const uint64_t key = chessState.getZobristKey();
+	const std::optional<Score> cachedValue = _evaluationCache.probe(key);
+	statistics.evaluationCacheProbeCount++;
+	if (cachedValue.has_value())
+	{
+		statistics.evaluationCacheHitCount++;
+		return cachedValue.value();
+	}
 
-	return timeElapsed < turnTime;
+	const Score value = _evaluator.evaluate(chessState, player, statistics);
+	_evaluationCache.store(key, value);
+	return value;
 }
 
-bool Agent::isQuiescent(const ChessState& chessState, const std::vector<Move>& validMoves) const
+template <typename EvaluationPolicy, typename SearchPolicy>
+bool SearchAgent<EvaluationPolicy, SearchPolicy>::visitNode(search::SearchStatistics& statistics, const int ply)
 {
-	const BitboardSet& board = chessState.getBoard();
-	for (const Move& move : validMoves)
+	statistics.nodeCount++;
+	statistics.selectiveDepth = std::max(statistics.selectiveDepth, ply);
+	if (statistics.nodeCount % SearchPolicy::STOP_POLL_INTERVAL == 0)
 	{
-		if (board.posIsOccupied(move.destination))
+		_searchNodeCount.fetch_add(SearchPolicy::STOP_POLL_INTERVAL, std::memory_order_relaxed);
+		const search::TimeManager* timeManager = _timeManager.load();
+		if (isNodeLimitReached() || (timeManager != nullptr && timeManager->isHardLimitReached()))
 		{
-			return false;
+			_stopSearch.store(true, std::memory_order_relaxed);
 		}
 	}
 
-	return true;
+	return _stopSearch.load(std::memory_order_relaxed);
 }
 
-double Agent::getMoveValue(const ChessState& chessState, const Color player, const Move& move) const
+template <typename EvaluationPolicy, typename SearchPolicy>
+void SearchAgent<EvaluationPolicy, SearchPolicy>::reportNodeCount(const search::SearchStatistics& statistics)
 {
-	static const double BASE_CAPTURE_SCORE = 1000;
+	_searchNodeCount.fetch_add(statistics.nodeCount % SearchPolicy::STOP_POLL_INTERVAL, std::memory_order_relaxed);
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+bool SearchAgent<EvaluationPolicy, SearchPolicy>::isNodeLimitReached() const
+{
+	return _searchLimits.maxNodes.has_value() && _searchNodeCount.load(std::memory_order_relaxed) >= _searchLimits.maxNodes.value();
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+int SearchAgent<EvaluationPolicy, SearchPolicy>::getMaxDepth(const int depth) const
+{
+	return _searchLimits.maxDepth.has_value() ? std::clamp(_searchLimits.maxDepth.value(), 1, depth) : depth;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+int SearchAgent<EvaluationPolicy, SearchPolicy>::getMoveValue(const ChessState& chessState, const Color player, const Move& move) const
+{
+	static const int BASE_CAPTURE_SCORE = 1000000, BASE_LOSING_CAPTURE_SCORE = -1000000;
 	const Color enemyPlayer = ~player;
 	const util::bitboard::BitboardSet& board = chessState.getBoard();
-	double result = 0.0;
+	int result = 0;
 
-	if (board.posIsOccupied(move.destination))
+	if (move::isCapture(chessState, player, move))
 	{
+		// Captures that do not lose material are searched first, most valuable victim first,
+		// while captures that lose material once recaptured are searched after every quiet move
+		const Score exchangeValue = search::getStaticExchangeValue(chessState, player, move);
+		if (exchangeValue < 0)
+		{
+			return BASE_LOSING_CAPTURE_SCORE + exchangeValue;
+		}
+
 		const PieceType capturedPieceType = board.getPieceType(move.destination, enemyPlayer);
-		result += BASE_CAPTURE_SCORE + PIECE_VALUES[capturedPieceType];
+		return BASE_CAPTURE_SCORE + SearchPolicy::CAPTURE_ORDER_VALUES[capturedPieceType == PieceType::NONE ? PieceType::PAWN : capturedPieceType];
 	}
 	else
 	{
@@ -161,107 +557,374 @@ double Agent::getMoveValue(const ChessState& chessState, const Color player, con
 		// piece is moving backwards
 		if (deltaY < 0)
 		{
-			result -= 0.5;
+			result -= 1;
 		}
 		// piece is moving forwards
 		else
 		{
-			result += 0.5;
+			result += 1;
 		}
 	}
 
-	const auto historyTable = _player == player ? _allyHistoryTable : _enemyHistoryTable;
-	const auto it = historyTable.find(move);
-	if (it != historyTable.end())
-	{
-		const double historyTableScore = it->second;
-		result += historyTableScore;
-	}
+	const search::HistoryTable& historyTable = _player == player ? _allyHistoryTable : _enemyHistoryTable;
+	result += historyTable.getScore(move);
 
 	return result;
 }
 
-MoveIndexMap Agent::getOrderedMoveIndexMap(const ChessState& chessState, const Color player, const std::vector<Move>& moves) const
+template <typename EvaluationPolicy, typename SearchPolicy>
+MoveIndexMap SearchAgent<EvaluationPolicy, SearchPolicy>::getOrderedMoveIndexMap(const ChessState& chessState, const Color player, const std::vector<Move>& moves, const std::optional<Move>& hashMove) const
 {
 	MoveIndexMap result;
 
 	for (int i = 0; i < moves.size(); i++)
 	{
 		const Move& move = moves[i];
-		result.insert({ getMoveValue(chessState, player, move), i });
+		// The best move found by a previous search of the game state is the most likely to be best again
+		const int moveValue = move == hashMove ? std::numeric_limits<int>::max() : getMoveValue(chessState, player, move);
+		result.insert({ moveValue, i });
 	}
 
 	return result;
 }
 
-double Agent::getNegaMaxValue(const Color player, const ChessState& chessState, const int searchDepth, double alpha, double beta)
+template <typename EvaluationPolicy, typename SearchPolicy>
+Score SearchAgent<EvaluationPolicy, SearchPolicy>::getGameOverValue(const Color player, const ChessState& chessState, const int ply) const
+{
+	const std::optional<Color> winner = chessState.getWinner();
+	if (winner == player)
+	{
+		return search::mateIn(ply);
+	}
+	else if (winner == ~player)
+	{
+		return search::matedIn(ply);
+	}
+
+	return search::SCORE_DRAW;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+Score SearchAgent<EvaluationPolicy, SearchPolicy>::getNegaMaxValue(const Color player, ChessState& chessState, const int depth, const int ply, Score alpha, Score beta, search::SearchStatistics& statistics, const bool allowNullMove)
 {
 	const Color enemyPlayer = ~player;
-	if (chessState.getWinner().has_value())
+	const bool isPrincipalVariation = beta - alpha > 1;
+	if (isPrincipalVariation)
+	{
+		_principalVariationTable->clear(ply);
+	}
+
+	if (chessState.getNextTurn() == Color::NEUTRAL)
 	{
-		const Color winner = chessState.getWinner().value();
-		if (winner == player)
+		return getGameOverValue(player, chessState, ply);
+	}
+
+	// Mate distance pruning: a shorter mate has already been found closer to the root
+	alpha = std::max(alpha, search::matedIn(ply));
+	beta = std::min(beta, search::mateIn(ply + 1));
+	if (alpha >= beta)
+	{
+		return alpha;
+	}
+
+	if (depth <= 0)
+	{
+		return getQuiescenceValue(player, chessState, ply, alpha, beta, statistics);
+	}
+
+	if (visitNode(statistics, ply))
+	{
+		return search::SCORE_DRAW;
+	}
+
+	// A previous search of the game state to at least the same depth may already bound its score. Principal
+	// variation nodes are always searched so the score of the expected line is exact.
+	const uint64_t zobristKey = chessState.getZobristKey();
+	const std::optional<search::TranspositionEntry> hashEntry = _transpositionTable.probe(zobristKey, ply);
+	statistics.transpositionProbeCount++;
+	statistics.transpositionHitCount += hashEntry.has_value();
+	if (hashEntry.has_value() && !isPrincipalVariation && hashEntry->depth >= depth)
+	{
+		const search::TranspositionEntry& entry = hashEntry.value();
+		if (entry.bound == search::Bound::EXACT
+			|| (entry.bound == search::Bound::LOWER && entry.value >= beta)
+			|| (entry.bound == search::Bound::UPPER && entry.value <= alpha))
 		{
-			return DBL_MAX;
+			return entry.value;
 		}
-		else if (winner == enemyPlayer)
+	}
+	const Score originalAlpha = alpha;
+
+	// Pruning decisions rely on the static evaluation, which is meaningless while in check
+	const bool isInCheck = move::inCheck(player, chessState);
+	const Score staticValue = isInCheck ? -search::SCORE_INFINITE : evaluateGameState(chessState, player, statistics);
+
+	// Reverse futility pruning: near the leaves, a position far above beta is not expected to fall below it
+	if (_searchParameters.reverseFutilityPruning && !isInCheck && depth <= _searchParameters.reverseFutilityMaxDepth && !search::isMateScore(beta))
+	{
+		const Score marginValue = staticValue - _searchParameters.reverseFutilityMargin * depth;
+		if (marginValue >= beta)
 		{
-			return -DBL_MAX;
+			return marginValue;
 		}
-		else
+	}
+
+	// Null move pruning: if passing the turn still fails high, a real move almost certainly would as well.
+	// Zugzwang breaks that assumption, so it is avoided in check, without pieces besides pawns, and twice in a row.
+	if (_searchParameters.nullMovePruning && allowNullMove && !isInCheck
+		&& depth >= _searchParameters.nullMoveMinDepth && !search::isMateScore(beta) && staticValue >= beta)
+	{
+		const BitboardSet& board = chessState.getBoard();
+		const Bitboard pawnsAndKing = board.getBitboard(player, PieceType::PAWN) | board.getBitboard(player, PieceType::KING);
+		const bool hasNonPawnMaterial = (board.getOccupancyBoard(player) & ~pawnsAndKing) != 0;
+
+		if (hasNonPawnMaterial)
 		{
-			return 0;
+			const int reduction = depth >= _searchParameters.nullMoveDeepDepth ? _searchParameters.nullMoveDeepReduction : _searchParameters.nullMoveReduction;
+			const std::optional<MoveHistoryNode> evictedMove = chessState.makeNullMove();
+			Score nullValue = -getNegaMaxValue(enemyPlayer, chessState, depth - 1 - reduction, ply + 1, -beta, -beta + 1, statistics, false);
+			chessState.unmakeNullMove(evictedMove);
+
+			if (nullValue >= beta)
+			{
+				// Mates found after passing the turn are not proven, so they are not reported
+				if (search::isMateScore(nullValue))
+				{
+					nullValue = beta;
+				}
+
+				// Deep cutoffs are verified by a reduced search without null moves to catch remaining zugzwangs
+				if (depth < _searchParameters.nullMoveVerificationDepth
+					|| getNegaMaxValue(player, chessState, depth - reduction, ply, beta - 1, beta, statistics, false) >= beta)
+				{
+					return nullValue;
+				}
+			}
 		}
 	}
 
 	const std::vector<Move> playerMoves = move::getValidMoves(chessState, player);
-	double maxValue = -DBL_MAX;
-	if (!playerMoves.empty())
+	if (playerMoves.empty())
+	{
+		// Checkmate is reported through the winner, so a player without moves has been stalemated
+		return search::SCORE_DRAW;
+	}
+
+	// Futility pruning: near the leaves, quiet moves cannot raise a position far below alpha up to it
+	const bool isFutile = _searchParameters.futilityPruning && !isInCheck && depth <= _searchParameters.futilityMaxDepth
+		&& !search::isMateScore(alpha) && staticValue + _searchParameters.futilityMargin * depth <= alpha;
+
+	Score maxValue = -search::SCORE_INFINITE;
+	Move optimalMove;
+	int moveIndex = 0;
+	MoveIndexMap moveIndexMap = getOrderedMoveIndexMap(chessState, player, playerMoves, hashEntry.has_value() ? hashEntry->move : std::nullopt);
+	for (const auto& entry : moveIndexMap)
 	{
-		if (searchDepth >= _depthLimit || (searchDepth >= _quiescentSearchDepth && isQuiescent(chessState, playerMoves)))
+		const Move& move = playerMoves[entry.second];
+		const bool isQuiet = !move::isCapture(chessState, player, move) && !move::isPromotion(chessState, player, move);
+		ChessState gameCopy(chessState);
+
+		gameCopy.update(player, move, PieceType::QUEEN);
+
+		// Moves that give check are never pruned or reduced since they may lead to a forced sequence
+		const bool isQuietNonCheck = isQuiet && gameCopy.getNextTurn() != Color::NEUTRAL && !move::inCheck(enemyPlayer, gameCopy);
+		if (isFutile && isQuietNonCheck && moveIndex > 0)
 		{
-			return evaluateGameState(chessState, player);
+			continue;
+		}
+
+		// Late move reductions: with good move ordering, late quiet moves are searched to a reduced depth
+		const int reduction = _searchParameters.lateMoveReductions && isQuietNonCheck && !isInCheck
+			&& depth >= _searchParameters.lateMoveMinDepth && moveIndex >= _searchParameters.lateMoveMinIndex
+			? std::min(_reductionTable.getReduction(depth, moveIndex), depth - 2)
+			: 0;
+
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.pushGameState(gameCopy);
+		}
+
+		Score value;
+		if (moveIndex == 0 || (!_searchParameters.principalVariationSearch && reduction == 0))
+		{
+			value = -getNegaMaxValue(enemyPlayer, gameCopy, depth - 1, ply + 1, -beta, -alpha, statistics);
 		}
 		else
 		{
-			Move optimalMove;
-			MoveIndexMap moveIndexMap = getOrderedMoveIndexMap(chessState, player, playerMoves);
-			for (const auto& entry : moveIndexMap)
+			// Principal variation search: moves after the first only need to be proven no better than alpha, which a
+			// null window does cheaply; reduced moves and moves that beat alpha are searched again more thoroughly
+			value = -getNegaMaxValue(enemyPlayer, gameCopy, depth - 1 - reduction, ply + 1, -alpha - 1, -alpha, statistics);
+			if (value > alpha && reduction > 0)
+			{
+				value = -getNegaMaxValue(enemyPlayer, gameCopy, depth - 1, ply + 1, -alpha - 1, -alpha, statistics);
+			}
+			if (value > alpha && value < beta)
 			{
-				const Move& move = playerMoves[entry.second];
-				ChessState gameCopy(chessState);
+				value = -getNegaMaxValue(enemyPlayer, gameCopy, depth - 1, ply + 1, -beta, -alpha, statistics);
+			}
+		}
+		moveIndex++;
 
-				gameCopy.update(player, move, PieceType::QUEEN);
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.popGameState();
+		}
 
-				const double value = -getNegaMaxValue(enemyPlayer, gameCopy, searchDepth + 1, -beta, -alpha);
+		if (value > maxValue)
+		{
+			maxValue = value;
+			optimalMove = move;
+			if (isPrincipalVariation && value > alpha)
+			{
+				_principalVariationTable->update(ply, move);
+			}
+		}
 
-				if (value > maxValue)
-				{
-					maxValue = value;
-					optimalMove = move;
-				}
+		alpha = std::max(value, alpha);
+		if (alpha >= beta)
+		{
+			statistics.betaCutoffCount++;
+			statistics.firstMoveBetaCutoffCount += moveIndex == 1;
+			break;
+		}
+	}
+
+	if (!move::isCapture(chessState, player, optimalMove))
+	{
+		search::HistoryTable& historyTable = _player == player ? _allyHistoryTable : _enemyHistoryTable;
+		historyTable.addScore(optimalMove, depth * depth);
+	}
+
+	// A stopped search returns placeholder scores, which must not be reused
+	if (!_stopSearch.load(std::memory_order_relaxed))
+	{
+		const search::Bound bound = maxValue >= beta ? search::Bound::LOWER : maxValue > originalAlpha ? search::Bound::EXACT : search::Bound::UPPER;
+		const std::optional<Move> hashMove = maxValue > originalAlpha ? std::optional<Move>(optimalMove) : std::nullopt;
+		_transpositionTable.store(zobristKey, ply, hashMove, maxValue, depth, bound);
+	}
+
+	return maxValue;
+}
+
+template <typename EvaluationPolicy, typename SearchPolicy>
+Score SearchAgent<EvaluationPolicy, SearchPolicy>::getQuiescenceValue(const Color player, const ChessState& chessState, const int ply, Score alpha, const Score beta, search::SearchStatistics& statistics)
+{
+	static const Score DELTA_MARGIN = 200;
+
+	if (chessState.getNextTurn() == Color::NEUTRAL)
+	{
+		return getGameOverValue(player, chessState, ply);
+	}
+
+	if (visitNode(statistics, ply))
+	{
+		return search::SCORE_DRAW;
+	}
+	statistics.quiescenceNodeCount++;
+
+	if (ply >= search::MAX_PLY)
+	{
+		return evaluateGameState(chessState, player, statistics);
+	}
+
+	// A player in check has no option to stand pat, so every evasion is searched
+	const bool isInCheck = move::inCheck(player, chessState);
+	Score maxValue = -search::SCORE_INFINITE;
+	Score standPat = -search::SCORE_INFINITE;
+	std::vector<Move> playerMoves;
 
-				alpha = std::max(value, alpha);
-				if (alpha >= beta)
+	if (isInCheck)
+	{
+		playerMoves = move::getValidMoves(chessState, player);
+		if (playerMoves.empty())
+		{
+			return search::matedIn(ply);
+		}
+	}
+	else
+	{
+		standPat = evaluateGameState(chessState, player, statistics);
+		if (standPat >= beta)
+		{
+			return standPat;
+		}
+
+		maxValue = standPat;
+		alpha = std::max(standPat, alpha);
+		playerMoves = move::getValidCaptures(chessState, player);
+	}
+
+	const Color enemyPlayer = ~player;
+	const BitboardSet& board = chessState.getBoard();
+	MoveIndexMap moveIndexMap = getOrderedMoveIndexMap(chessState, player, playerMoves);
+	for (const auto& entry : moveIndexMap)
+	{
+		const Move& move = playerMoves[entry.second];
+
+		if (!isInCheck)
+		{
+			// Delta pruning: skip captures that cannot raise the score to alpha even with a positional margin
+			if (!move::isPromotion(chessState, player, move))
+			{
+				const PieceType capturedPieceType = board.getPieceType(move.destination, enemyPlayer);
+				const PieceType capturedValueType = capturedPieceType == PieceType::NONE ? PieceType::PAWN : capturedPieceType;
+				const Score capturedValue = std::max(evaluation::PIECE_VALUES[evaluation::MIDDLEGAME][capturedValueType], evaluation::PIECE_VALUES[evaluation::ENDGAME][capturedValueType]);
+				if (standPat + capturedValue + DELTA_MARGIN <= alpha)
 				{
-					break;
+					continue;
 				}
 			}
 
-			if (!chessState.getBoard().posIsOccupied(optimalMove.destination))
+			// Captures that lose material once recaptured cannot improve on standing pat
+			if (search::getStaticExchangeValue(chessState, player, move) < 0)
 			{
-				const int depthRemaining = _depthLimit - searchDepth;
-				auto& historyTable = _player == player ? _allyHistoryTable : _enemyHistoryTable;
-				auto it = historyTable.find(optimalMove);
-
-				if (it == historyTable.end())
-				{
-					it = historyTable.insert({ optimalMove, 0 }).first;
-				}
-				it->second += depthRemaining * depthRemaining;
+				continue;
 			}
 		}
+
+		ChessState gameCopy(chessState);
+		gameCopy.update(player, move, PieceType::QUEEN, false);
+
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.pushGameState(gameCopy);
+		}
+		const Score value = -getQuiescenceValue(enemyPlayer, gameCopy, ply + 1, -beta, -alpha, statistics);
+		if constexpr (EvaluationPolicy::USES_ACCUMULATOR)
+		{
+			_evaluator.popGameState();
+		}
+
+		maxValue = std::max(value, maxValue);
+		alpha = std::max(value, alpha);
+		if (alpha >= beta)
+		{
+			break;
+		}
 	}
 
 	return maxValue;
 }
+
+std::unique_ptr<Agent> createAgent(const evaluation::EvaluatorType evaluatorType, ChessState& chessState, const Color player, const int searchDepth,
+	const search::SearchParameters& searchParameters)
+{
+	switch (evaluatorType)
+	{
+		case evaluation::EvaluatorType::MATERIAL:
+			return std::make_unique<SearchAgent<evaluation::MaterialEvaluator>>(chessState, player, searchDepth, searchParameters);
+		case evaluation::EvaluatorType::PIECE_SQUARE:
+			return std::make_unique<SearchAgent<evaluation::PieceSquareEvaluator>>(chessState, player, searchDepth, searchParameters);
+		case evaluation::EvaluatorType::ATTACK:
+			return std::make_unique<SearchAgent<evaluation::AttackEvaluator>>(chessState, player, searchDepth, searchParameters);
+		case evaluation::EvaluatorType::NETWORK:
+			return std::make_unique<SearchAgent<evaluation::NetworkEvaluator>>(chessState, player, searchDepth, searchParameters);
+	}
+
+	throw std::exception("Unknown evaluator type");
+}
+
+template class SearchAgent<evaluation::MaterialEvaluator>;
+template class SearchAgent<evaluation::PieceSquareEvaluator>;
+template class SearchAgent<evaluation::AttackEvaluator>;
+template class SearchAgent<evaluation::NetworkEvaluator>;
\ No newline at end of file
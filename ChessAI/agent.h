@@ -3,79 +3,252 @@
 #include "move/move.h"
 #include "chess.h"
 #include "constants.h"
-#include <unordered_map>
+#include "search/score.h"
+#include "search/searchParameters.h"
+#include "search/reductionTable.h"
+#include "search/timeManager.h"
+#include "search/transpositionTable.h"
+#include "search/historyTable.h"
+#include "search/searchStatistics.h"
+#include "search/principalVariationTable.h"
+#include "search/analysisLine.h"
+#include "search/searchLimits.h"
+#include "search/searchPolicy.h"
+#include "evaluation/evaluationCache.h"
+#include "evaluation/evaluators.h"
 #include <map>
+#include <atomic>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include <thread>
 
-typedef std::multimap<double, int, std::greater<double>> MoveIndexMap;
+typedef std::multimap<int, int, std::greater<int>> MoveIndexMap;
 
 /**
- * Class used to determine optimal moves in a game of Chess.
+ * Interface of the agents used to determine optimal moves in a game of Chess.
+ *
+ * Agents are created for a game with createAgent(), which selects the evaluation policy their search is compiled
+ * against.
  */
 class Agent
 {
 public:
-	Agent() = delete;
-	Agent(const Agent& source) = delete;
-
 	/**
-	 * Creates a new Agent.
-	 *
-	 * \param chessState game state
-	 * \param player the player the agent will be playing as
-	 * \param quiescentSearchDepth the search depth for "quiet" states
-	 * \param depthLimit the absolute limit for seach depth
+	 * Destructs the agent, stopping any background search.
 	 */
-	Agent(ChessState& chessState, const Color player, const int quiescentSearchDepth, const int depthLimit);
+	virtual ~Agent() = default;
 
 	/**
 	 * Retrieves the player.
 	 *
 	 * \return the color the agent is playing for
 	 */
-	Color getPlayer() const;
+	virtual Color getPlayer() const = 0;
 
 	/**
 	 * Determine the best move for the current game state.
 	 *
 	 * \return optimal move
 	 */
-	move::Move getMove();
+	virtual move::Move getMove() = 0;
 
 	/**
-	 * Determine the best move for the current game state.
+	 * Determine the best move for the current game state, searching deeper until the time allocated to the move runs out.
 	 *
-	 * \param timeRemaining the time remaining for the player
+	 * \param timeRemaining the time remaining on the player's clock in nanoseconds
 	 * \return optimal move
 	 */
-	move::Move getMove(const double timeRemaining);
+	virtual move::Move getMove(const double timeRemaining) = 0;
+
+	/**
+	 * Determine the best moves for the current game state along with their scores and expected lines of play.
+	 *
+	 * Every line comes from a single search, where each line is the best of the moves not covered by the lines
+	 * before it.
+	 *
+	 * \param lineCount the number of moves to analyze
+	 * \return up to lineCount lines ordered from best to worst
+	 */
+	virtual std::vector<search::AnalysisLine> getAnalysis(const int lineCount) = 0;
+
+	/**
+	 * Sets the limits applied to every following search, stopping any background search.
+	 *
+	 * \param searchLimits the maximum nodes, depth and time per move
+	 */
+	virtual void setSearchLimits(const search::SearchLimits& searchLimits) = 0;
+
+	/**
+	 * Starts searching the game state expected after the enemy's reply in the background while the enemy is thinking.
+	 *
+	 * The expected reply is the best enemy move found by the previous search. If the enemy plays it, the next call to
+	 * getMove(timeRemaining) continues the background search instead of starting over; otherwise the background search
+	 * is cancelled and the positions it stored in the transposition table are kept.
+	 */
+	virtual void startPondering() = 0;
+
+	/**
+	 * Stops the background search started by startPondering(), if any.
+	 */
+	virtual void stopPondering() = 0;
+
+	/**
+	 * Retrieves the number of nodes visited by searches since the agent was created.
+	 *
+	 * \return the number of nodes searched
+	 */
+	virtual uint64_t getNodeCount() const = 0;
+
+	/**
+	 * Retrieves the statistics of the most recently completed search.
+	 *
+	 * Must not be called while the agent is pondering.
+	 *
+	 * \return counters aggregated across every thread that took part in the search
+	 */
+	virtual const search::SearchStatistics& getSearchStatistics() const = 0;
+};
+
+/**
+ * Agent whose search is compiled against an evaluation policy and a search policy, so the static evaluation is
+ * called directly at every leaf instead of through a virtual call.
+ *
+ * Instantiated in agent.cpp for every evaluation policy in evaluation/evaluators.h.
+ *
+ * \tparam EvaluationPolicy scores game states; see evaluation::AttackEvaluator
+ * \tparam SearchPolicy the search constants; see search::DefaultSearchPolicy
+ */
+template <typename EvaluationPolicy = evaluation::AttackEvaluator, typename SearchPolicy = search::DefaultSearchPolicy>
+class SearchAgent final : public Agent
+{
+public:
+	SearchAgent() = delete;
+	SearchAgent(const SearchAgent& source) = delete;
+
+	/**
+	 * Creates a new SearchAgent.
+	 *
+	 * \param chessState game state
+	 * \param player the player the agent will be playing as
+	 * \param searchDepth the depth searched at full width before only captures are searched
+	 * \param searchParameters the parameters controlling pruning and reductions
+	 */
+	SearchAgent(ChessState& chessState, const Color player, const int searchDepth, const search::SearchParameters& searchParameters = search::SearchParameters());
+
+	~SearchAgent() override;
+
+	Color getPlayer() const override;
+
+	move::Move getMove() override;
+
+	move::Move getMove(const double timeRemaining) override;
+
+	std::vector<search::AnalysisLine> getAnalysis(const int lineCount) override;
+
+	void setSearchLimits(const search::SearchLimits& searchLimits) override;
+
+	void startPondering() override;
+
+	void stopPondering() override;
+
+	uint64_t getNodeCount() const override;
+
+	const search::SearchStatistics& getSearchStatistics() const override;
 
 private:
+	/**
+	 * Searches the root moves to increasing depths, using each iteration's result to order and window the next.
+	 *
+	 * Iterations are cut short by the time manager, if one is set; a stopped iteration's result is discarded.
+	 *
+	 * \param rootState the game state being searched
+	 * \param maxDepth the depth of the final iteration
+	 * \return the best move found by the deepest completed iteration
+	 */
+	move::Move getIterativeDeepeningMove(const ChessState& rootState, const int maxDepth);
+
+	/**
+	 * Searches the root moves to increasing depths, finding the best lines of play.
+	 *
+	 * Iterations are cut short by the time manager, if one is set; a stopped iteration's result is discarded.
+	 *
+	 * \param rootState the game state being searched
+	 * \param maxDepth the depth of the final iteration
+	 * \param lineCount the number of lines to find
+	 * \return up to lineCount lines found by the deepest completed iteration, ordered from best to worst
+	 */
+	std::vector<search::AnalysisLine> getIterativeDeepeningLines(const ChessState& rootState, const int maxDepth, const int lineCount);
+
+	/**
+	 * Calculates the score of the root game state, searching the expected best move first with the full window and
+	 * proving the remaining moves worse with null windows in parallel.
+	 *
+	 * \param rootState the game state being searched
+	 * \param rootMoves the player's valid moves; reordered so the best searched move is at firstMoveIndex
+	 * \param firstMoveIndex the index of the first move searched; moves before it belong to other lines
+	 * \param depth the depth to search at full width
+	 * \param alpha the greatest value that can be guaranteed by the player; used for pruning
+	 * \param beta the greatest value that can be guaranteed by the enemy; used for pruning
+	 * \param principalVariation set to the expected line of play after the best root move
+	 * \param statistics the calling thread's search statistics; the statistics of every task are added to it
+	 * \return the score of the best root move; a bound when it falls outside of (alpha, beta)
+	 */
+	search::Score getRootValue(const ChessState& rootState, std::vector<move::Move>& rootMoves, const size_t firstMoveIndex, const int depth, search::Score alpha, const search::Score beta,
+		std::vector<move::Move>& principalVariation, search::SearchStatistics& statistics);
+
+	/**
+	 * Checks a line of play move by move and continues it with the best moves stored in the transposition table.
+	 *
+	 * \param rootState the game state the line starts from
+	 * \param line the line found by the search
+	 * \return the line up to its first illegal move, extended by exact transposition table entries
+	 */
+	std::vector<move::Move> getVerifiedPrincipalVariation(const ChessState& rootState, const std::vector<move::Move>& line) const;
+
 	/**
 	 * Calculates a score for the given game state based on how desirable it is for the given player.
 	 *
+	 * Scores come from the evaluation policy and are cached by the Zobrist key of the game state if the policy's
+	 * evaluations are worth caching.
+	 *
 	 * \param chessState the game state being scored
-	 * \param player the player the score is being calculated for
-	 * \return score of the game state
+	 * \param player the player the score is being calculated for; must be the player whose turn it is
+	 * \param statistics the search statistics of the calling thread; counts cache probes
+	 * \return score of the game state in centipawns
 	 */
-	double evaluateGameState(const ChessState& chessState, const Color player) const;
+	search::Score evaluateGameState(const ChessState& chessState, const Color player, search::SearchStatistics& statistics);
 
 	/**
-	 * Determines when to stop evaluating a game state for the best move.
+	 * Counts a visited node and periodically stops the search once the hard time limit has been reached.
 	 *
-	 * \param timeElapsed the time spent determining the current move
-	 * \param timeRemaining the total remaining time the player has to finish the game
-	 * \return true to continue evaluation, false otherwise
+	 * \param statistics the search statistics of the calling thread
+	 * \param ply the distance of the node from the root
+	 * \return true if the search has been stopped and the node should be abandoned, false otherwise
 	 */
-	bool timeHeuristic(const double timeElapsed, const double timeRemaining) const;
+	bool visitNode(search::SearchStatistics& statistics, const int ply);
 
 	/**
-	 * Determines if a game state is "quiet" or unlikely to result in meaningful impacts to the player.
+	 * Adds the nodes a thread visited since its last poll to the node count shared by the search's threads.
 	 *
-	 * \param game game state
-	 * \param validMoves all valid moves for the player in the given game state
-	 * \return true if game state is "quiet", false otherwise
+	 * \param statistics the search statistics of a thread that has finished searching
 	 */
-	bool isQuiescent(const ChessState& chessState, const std::vector<move::Move>& validMoves) const;
+	void reportNodeCount(const search::SearchStatistics& statistics);
+
+	/**
+	 * Determines if the search has visited the maximum number of nodes allowed by the search limits.
+	 *
+	 * \return true if the node limit has been reached, false otherwise
+	 */
+	bool isNodeLimitReached() const;
+
+	/**
+	 * Applies the depth limit to the depth of a search.
+	 *
+	 * \param depth the depth the search would otherwise run to
+	 * \return the depth of the final iteration
+	 */
+	int getMaxDepth(const int depth) const;
 
 	/**
 	 * Scores a move based on how desireable it is for the given player.
@@ -85,7 +258,7 @@ private:
 	 * \param move the move being scored
 	 * \return score of the move
 	 */
-	double getMoveValue(const ChessState& chessState, const Color player, const move::Move& move) const;
+	int getMoveValue(const ChessState& chessState, const Color player, const move::Move& move) const;
 
 	/**
 	 * Scores each given move and places it in a map with its index to be sorted.
@@ -93,25 +266,83 @@ private:
 	 * \param chessState game state
 	 * \param player the player whose moves are being scored and sorted
 	 * \param moves the moves being scored and sorted
+	 * \param hashMove the best move stored in the transposition table for the game state, if any; ordered first
 	 * \return ordered map containing score and index for each move
 	 */
-	MoveIndexMap getOrderedMoveIndexMap(const ChessState& chessState, const Color player, const std::vector<move::Move>& moves) const;
+	MoveIndexMap getOrderedMoveIndexMap(const ChessState& chessState, const Color player, const std::vector<move::Move>& moves, const std::optional<move::Move>& hashMove = std::nullopt) const;
+
+	/**
+	 * Scores a game state that has concluded.
+	 *
+	 * \param player the current turn's player
+	 * \param chessState game state
+	 * \param ply the distance from the root
+	 * \return mate score if a player has won, draw score otherwise
+	 */
+	search::Score getGameOverValue(const Color player, const ChessState& chessState, const int ply) const;
 
 	/**
 	 * Calculates the score of a game state by recursively exploring possible moves.
 	 *
 	 * \param player the current turn's player
+	 * \param chessState game state; temporarily modified by null moves and restored before returning
+	 * \param depth the remaining depth to search at full width
+	 * \param ply the distance from the root
+	 * \param alpha the greatest value that can be guaranteed by the player; used for pruning
+	 * \param beta the greatest value that can be guaranteed by the enemy; used for pruning
+	 * \param statistics the search statistics of the calling thread
+	 * \param allowNullMove whether the player may pass the turn to prune this node; false directly after a null move
+	 * \return the score for the given game state; mate scores are relative to the root so faster mates score higher
+	 */
+	search::Score getNegaMaxValue(const Color player, ChessState& chessState, const int depth, const int ply, search::Score alpha, search::Score beta, search::SearchStatistics& statistics, const bool allowNullMove = true);
+
+	/**
+	 * Calculates the score of a game state by only exploring captures and promotions until the position is quiet.
+	 *
+	 * The static evaluation is used as a lower bound ("stand pat") since the player is never forced to capture,
+	 * unless the player is in check, in which case every evasion is explored.
+	 *
+	 * \param player the current turn's player
 	 * \param chessState game state
-	 * \param searchDepth te current search depth
+	 * \param ply the distance from the root
 	 * \param alpha the greatest value that can be guaranteed by the player; used for pruning
 	 * \param beta the greatest value that can be guaranteed by the enemy; used for pruning
+	 * \param statistics the search statistics of the calling thread
 	 * \return the score for the given game state
 	 */
-	double getNegaMaxValue(const Color player, const ChessState& chessState, const int searchDepth, double alpha, double beta);
+	search::Score getQuiescenceValue(const Color player, const ChessState& chessState, const int ply, search::Score alpha, const search::Score beta, search::SearchStatistics& statistics);
 
 	const Color _player;
 	const ChessState& _chessState;
-	int _quiescentSearchDepth;
-	int _depthLimit;
-	std::unordered_map<move::Move, double, move::Move::MoveHasher> _allyHistoryTable, _enemyHistoryTable;
-};
\ No newline at end of file
+	int _searchDepth;
+	const search::SearchParameters _searchParameters;
+	const search::ReductionTable _reductionTable;
+	std::atomic<uint64_t> _nodeCount;
+	std::atomic<uint64_t> _searchNodeCount; // Nodes visited by the current search; updated every STOP_POLL_INTERVAL nodes per thread
+	search::SearchLimits _searchLimits;
+	std::atomic<bool> _stopSearch;
+	search::TranspositionTable _transpositionTable;
+	EvaluationPolicy _evaluator;
+	evaluation::EvaluationCache _evaluationCache;
+	std::unique_ptr<search::PrincipalVariationTable> _principalVariationTable; // Written only by the thread searching with open windows
+	std::atomic<search::TimeManager*> _timeManager; // Set while a timed search is running; read by every search thread
+	std::thread _ponderThread;
+	std::unique_ptr<ChessState> _ponderState; // The game state expected after the enemy's reply
+	move::Move _ponderMove;
+	std::chrono::steady_clock::time_point _ponderStartTime;
+	search::SearchStatistics _searchStatistics; // Statistics of the most recently completed search
+	search::HistoryTable _allyHistoryTable, _enemyHistoryTable;
+};
+
+/**
+ * Creates an agent whose search is compiled against the selected evaluation policy.
+ *
+ * \param evaluatorType the evaluation policy; NETWORK requires a loaded evaluation network
+ * \param chessState game state
+ * \param player the player the agent will be playing as
+ * \param searchDepth the depth searched at full width before only captures are searched
+ * \param searchParameters the parameters controlling pruning and reductions
+ * \return the new agent
+ */
+std::unique_ptr<Agent> createAgent(const evaluation::EvaluatorType evaluatorType, ChessState& chessState, const Color player, const int searchDepth,
+	const search::SearchParameters& searchParameters = search::SearchParameters());
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 #include "util/utility.h"
 #include "move/moveUtil.h"
+#include "util/zobrist.h"
+#include "move/moveLookupTable.h"
+#include "util/bitboard/bitboardUtil.h"
+
+#include <cstdlib>
 
 #define UP Position::UP
 #define DOWN Position::DOWN
@@ -11,6 +16,8 @@
 using namespace util;
 using namespace util::bitboard;
 
+const Position NULL_MOVE_POSITION(-1, -1); // source and destination recorded for null moves
+
 MoveHistoryNode::MoveHistoryNode(const Position& source, const Position& destination, const Color color, const PieceType pieceType) :
 	source(source),
 	destination(destination),
@@ -45,14 +52,43 @@ std::ostream& operator<<(std::ostream& out, const MoveHistoryNode& move)
 
 ChessState::ChessState()
 {
+	move::populateLookupTables();
 	initialize();
 }
 
 ChessState::ChessState(const std::string& fenString)
 {
+	move::populateLookupTables();
 	setState(fenString);
 }
 
+ChessState::ChessState(const FenPosition& fenPosition)
+{
+	move::populateLookupTables();
+	setState(fenPosition);
+}
+
+ChessState::ChessState(const BitboardSet& board, const Color nextTurn, const bool wKingSideCastle, const bool wQueenSideCastle,
+	const bool bKingSideCastle, const bool bQueenSideCastle, const std::optional<int>& enPassantFile, const int halfTurnCount, const int fullTurnCount) :
+	_board(board),
+	_winner(std::nullopt),
+	_nextTurn(nextTurn),
+	_halfTurnCount(halfTurnCount),
+	_fullTurnCount(fullTurnCount),
+	_wTimeRemaining(TOTAL_PLAYER_TURN_TIME),
+	_bTimeRemaining(TOTAL_PLAYER_TURN_TIME),
+	_wKingSideCastle(wKingSideCastle),
+	_wQueenSideCastle(wQueenSideCastle),
+	_bKingSideCastle(bKingSideCastle),
+	_bQueenSideCastle(bQueenSideCastle)
+{
+	move::populateLookupTables();
+
+	setEnPassantFile(enPassantFile);
+
+	_board.updateAttackBoards();
+}
+
 ChessState::ChessState(const ChessState& source) :
 	_board(source._board),
 	_moveHistory(source._moveHistory),
@@ -60,6 +96,8 @@ ChessState::ChessState(const ChessState& source) :
 	_nextTurn(source._nextTurn),
 	_halfTurnCount(source._halfTurnCount),
 	_fullTurnCount(source._fullTurnCount),
+	_wTimeRemaining(source._wTimeRemaining),
+	_bTimeRemaining(source._bTimeRemaining),
 	_wKingSideCastle(source._wKingSideCastle),
 	_wQueenSideCastle(source._wQueenSideCastle),
 	_bKingSideCastle(source._bKingSideCastle),
@@ -82,95 +120,31 @@ std::optional<Color> ChessState::getWinner() const
 
 std::string ChessState::getFenString() const
 {
-	std::string fenString = "";
-
-	int numZeros = 0;
-	for (int y = 0; y < RANK_COUNT; y++)
-	{
-		for (int x = 0; x < FILE_COUNT; x++)
-		{
-			bool occupied = true;
-			char output;
-
-			if (_board.posIsOccupied(x, y, Color::WHITE))
-			{
-				output = PIECE_SYMBOLS[Color::WHITE][_board.getPieceType(x, y)];
-			}
-			else if (_board.posIsOccupied(x, y, Color::BLACK))
-			{
-				output = PIECE_SYMBOLS[Color::BLACK][_board.getPieceType(x, y)];
-			}
-			else
-			{
-				occupied = false;
-			}
-
-			if (occupied)
-			{
-				if (numZeros != 0)
-				{
-					fenString += std::to_string(numZeros);
-					numZeros = 0;
-				}
-
-				fenString += output;
-			}
-			else
-			{
-				numZeros += 1;
-
-				if (x == FILE_COUNT - 1 && numZeros != 0)
-				{
-					fenString += std::to_string(numZeros);
-					numZeros = 0;
-				}
-			}
-		}
+	char buffer[MAX_FEN_LENGTH];
+	return std::string(buffer, writeFen(getFenPosition(), buffer));
+}
 
-		if (y != RANK_COUNT - 1)
-		{
-			fenString += '/';
-		}
-	}
-	fenString += " ";
-
-	fenString += (_nextTurn == Color::WHITE ? 'w' : 'b');
-	fenString += ' ';
-
-	std::string castlingStr = "";
-	if (_wKingSideCastle)
-		castlingStr += 'K';
-	if (_wQueenSideCastle)
-		castlingStr += 'Q';
-	if (_bKingSideCastle)
-		castlingStr += 'k';
-	if (_bQueenSideCastle)
-		castlingStr += 'q';
-	fenString += (castlingStr.empty() ? "-" : castlingStr) + " ";
-
-	std::string enPassantStr = "";
-	if (!_moveHistory.empty())
+FenPosition ChessState::getFenPosition() const
+{
+	FenPosition fenPosition;
+	for (int color = Color::WHITE; color < COLOR_COUNT; color++)
 	{
-		if (_moveHistory.back().pieceType == PieceType::PAWN)
+		for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
 		{
-			int deltaY = _moveHistory.back().source.y - _moveHistory.back().destination.y;
-
-			if (deltaY * deltaY > 1)
-			{
-				// Add file to en passant string
-				enPassantStr += (char)(_moveHistory.back().destination.x + 97);
-
-				// Add rank to en passant string
-				enPassantStr += std::to_string(RANK_COUNT - _moveHistory.back().destination.y - (int)(deltaY / 2));
-			}
+			fenPosition.pieces[color][pieceType] = _board.getBitboard((Color)color, (PieceType)pieceType);
 		}
 	}
-	fenString += (enPassantStr.empty() ? "-" : enPassantStr) + " ";
 
-	fenString += std::to_string(_halfTurnCount) + " ";
-	fenString += std::to_string(_fullTurnCount);
+	fenPosition.nextTurn = _nextTurn;
+	fenPosition.kingSideCastle[Color::WHITE] = _wKingSideCastle;
+	fenPosition.queenSideCastle[Color::WHITE] = _wQueenSideCastle;
+	fenPosition.kingSideCastle[Color::BLACK] = _bKingSideCastle;
+	fenPosition.queenSideCastle[Color::BLACK] = _bQueenSideCastle;
 
-	return fenString;
+	fenPosition.enPassantFile = getEnPassantFile();
+	fenPosition.halfTurnCount = _halfTurnCount;
+	fenPosition.fullTurnCount = _fullTurnCount;
+	return fenPosition;
 }
 
 const BitboardSet& ChessState::getBoard() const
@@ -183,6 +157,34 @@ const std::deque<MoveHistoryNode>& ChessState::getMoveHistory() const
 	return _moveHistory;
 }
 
+uint64_t ChessState::getZobristKey() const
+{
+	const zobrist::ZobristKeys& keys = zobrist::KEYS;
+	uint64_t result = _board.getZobristKey();
+
+	if (_nextTurn == Color::BLACK)
+	{
+		result ^= keys.blackToMove;
+	}
+
+	const bool castlingRights[zobrist::CASTLING_RIGHT_COUNT] = { _wKingSideCastle, _wQueenSideCastle, _bKingSideCastle, _bQueenSideCastle };
+	for (int i = 0; i < zobrist::CASTLING_RIGHT_COUNT; i++)
+	{
+		if (castlingRights[i])
+		{
+			result ^= keys.castlingRights[i];
+		}
+	}
+
+	const std::optional<int> enPassantFile = getEnPassantFile();
+	if (enPassantFile.has_value())
+	{
+		result ^= keys.enPassantFiles[enPassantFile.value()];
+	}
+
+	return result;
+}
+
 int ChessState::getHalfTurnCount() const
 {
 	return _halfTurnCount;
@@ -193,6 +195,23 @@ int ChessState::getFullTurnCount() const
 	return _fullTurnCount;
 }
 
+double ChessState::getTimeRemaining(const Color player) const
+{
+	return player == Color::WHITE ? _wTimeRemaining : _bTimeRemaining;
+}
+
+void ChessState::setTimeRemaining(const Color player, const double timeRemaining)
+{
+	if (player == Color::WHITE)
+	{
+		_wTimeRemaining = timeRemaining;
+	}
+	else
+	{
+		_bTimeRemaining = timeRemaining;
+	}
+}
+
 bool ChessState::canKingSideCastle(const Color player) const
 {
 	return player == Color::WHITE ? _wKingSideCastle : _bKingSideCastle;
@@ -203,6 +222,16 @@ bool ChessState::canQueenSideCastle(const Color player) const
 	return player == Color::WHITE ? _wQueenSideCastle : _bQueenSideCastle;
 }
 
+std::optional<int> ChessState::getEnPassantFile() const
+{
+	// A pawn can only be captured en passant directly after advancing two squares
+	if (!_moveHistory.empty() && _moveHistory.back().pieceType == PieceType::PAWN && std::abs(_moveHistory.back().destination.y - _moveHistory.back().source.y) == 2)
+	{
+		return _moveHistory.back().destination.x;
+	}
+	return std::nullopt;
+}
+
 void ChessState::update(const Color player, const move::Move& move, const PieceType promotion, const bool checkWinner)
 {
 	update(player, move.source, move.destination, promotion, checkWinner);
@@ -375,6 +404,7 @@ void ChessState::update(const Color player, const Position& source, const Positi
 
 	_board.clearPos(source, player, pieceType);
 	_board.addPiece(destination, player, pieceType);
+	_board.updateAttackBoards();
 
 	if (_nextTurn == Color::BLACK)
 	{
@@ -415,6 +445,39 @@ void ChessState::update(const Color player, const Position& source, const Positi
 	}
 }
 
+std::optional<MoveHistoryNode> ChessState::makeNullMove()
+{
+	if (_nextTurn == Color::NEUTRAL)
+	{
+		throw std::exception("Invalid move: Game has concluded.");
+	}
+
+	std::optional<MoveHistoryNode> evictedMove;
+
+	// A null move in the history also removes the enemy's chance to capture en passant
+	_moveHistory.emplace_back(NULL_MOVE_POSITION, NULL_MOVE_POSITION, _nextTurn, PieceType::NONE);
+	if (_moveHistory.size() > MAX_MOVE_HISTORY_SIZE)
+	{
+		evictedMove = _moveHistory.front();
+		_moveHistory.pop_front();
+	}
+
+	_nextTurn = ~_nextTurn;
+
+	return evictedMove;
+}
+
+void ChessState::unmakeNullMove(const std::optional<MoveHistoryNode>& evictedMove)
+{
+	_moveHistory.pop_back();
+	if (evictedMove.has_value())
+	{
+		_moveHistory.push_front(evictedMove.value());
+	}
+
+	_nextTurn = ~_nextTurn;
+}
+
 void ChessState::clear()
 {
 	_board.clear();
@@ -431,6 +494,9 @@ void ChessState::clear()
 
 	_halfTurnCount = 0;
 	_fullTurnCount = 0;
+
+	_wTimeRemaining = TOTAL_PLAYER_TURN_TIME;
+	_bTimeRemaining = TOTAL_PLAYER_TURN_TIME;
 }
 
 void ChessState::reset()
@@ -442,6 +508,7 @@ void ChessState::reset()
 void ChessState::initialize()
 {
 	_board.populateBoard();
+	_board.updateAttackBoards();
 
 	_winner = std::nullopt;
 	_nextTurn = Color::WHITE; // White starts by default
@@ -449,6 +516,9 @@ void ChessState::initialize()
 	_halfTurnCount = 0;
 	_fullTurnCount = 1;
 
+	_wTimeRemaining = TOTAL_PLAYER_TURN_TIME;
+	_bTimeRemaining = TOTAL_PLAYER_TURN_TIME;
+
 	_wKingSideCastle = true;
 	_wQueenSideCastle = true;
 	_bKingSideCastle = true;
@@ -456,152 +526,70 @@ void ChessState::initialize()
 }
 
 void ChessState::setState(const std::string& fenString)
+{
+	FenPosition fenPosition;
+	const std::optional<FenError> error = parseFen(fenString, fenPosition);
+	if (error)
+	{
+		throw std::exception(("Invalid FEN string at character " + std::to_string(error->offset) + ": " + error->message).c_str());
+	}
+
+	setState(fenPosition);
+}
+
+void ChessState::setState(const FenPosition& fenPosition)
 {
 	_board.clear();
 	_moveHistory.clear();
 	_winner = std::nullopt;
 
-	_wKingSideCastle = false;
-	_wQueenSideCastle = false;
-	_bKingSideCastle = false;
-	_bQueenSideCastle = false;
-
-	std::vector<std::string> substrings = stringSplit(fenString, ' ');
-	std::vector<std::string> boardStrings = stringSplit(substrings[0], '/');
+	_wTimeRemaining = TOTAL_PLAYER_TURN_TIME;
+	_bTimeRemaining = TOTAL_PLAYER_TURN_TIME;
 
-	for (int y = 0; y < RANK_COUNT; y++)
+	for (int color = Color::WHITE; color < COLOR_COUNT; color++)
 	{
-		int stringIndex = 0;
-		for (int x = 0; x < FILE_COUNT; x++)
+		for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
 		{
-			if (boardStrings[y][stringIndex] >= 'A' && boardStrings[y][stringIndex] <= 'Z')
-			{
-				Color color = Color::WHITE;
-				PieceType pieceType = PieceType::NONE;
-
-				switch (boardStrings[y][stringIndex])
-				{
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::PAWN]:
-						pieceType = PieceType::PAWN;
-						break;
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::KNIGHT]:
-						pieceType = PieceType::KNIGHT;
-						break;
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::BISHOP]:
-						pieceType = PieceType::BISHOP;
-						break;
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::ROOK]:
-						pieceType = PieceType::ROOK;
-						break;
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::QUEEN]:
-						pieceType = PieceType::QUEEN;
-						break;
-					case PIECE_SYMBOLS[Color::WHITE][PieceType::KING]:
-						pieceType = PieceType::KING;
-						break;
-					default:
-						break;
-				}
-
-				_board.addPiece(x, y, color, pieceType);
-			}
-			else if (boardStrings[y][stringIndex] >= 'a' && boardStrings[y][stringIndex] <= 'z')
+			Bitboard pieceBoard = fenPosition.pieces[color][pieceType];
+			while (pieceBoard)
 			{
-				Color color = Color::BLACK;
-				PieceType pieceType = PieceType::NONE;
-
-				switch (boardStrings[y][stringIndex])
-				{
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::PAWN]:
-						pieceType = PieceType::PAWN;
-						break;
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::KNIGHT]:
-						pieceType = PieceType::KNIGHT;
-						break;
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::BISHOP]:
-						pieceType = PieceType::BISHOP;
-						break;
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::ROOK]:
-						pieceType = PieceType::ROOK;
-						break;
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::QUEEN]:
-						pieceType = PieceType::QUEEN;
-						break;
-					case PIECE_SYMBOLS[Color::BLACK][PieceType::KING]:
-						pieceType = PieceType::KING;
-						break;
-					default:
-						break;
-				}
-
-				_board.addPiece(x, y, color, pieceType);
-			}
-			else if (boardStrings[y][stringIndex] >= '0' && boardStrings[y][stringIndex] <= '9')
-			{
-				int numEmpties = (int)boardStrings[y][stringIndex] - 48;
-
-				while (boardStrings[y][stringIndex + 1] >= '0' && boardStrings[y][stringIndex + 1] <= '9')
-				{
-					numEmpties *= 10;
-					numEmpties += (int)boardStrings[y][stringIndex] - 48;
-					stringIndex += 1;
-				}
-				x += numEmpties - 1;
+				const int positionIndex = popLsb(pieceBoard);
+				_board.addPiece(positionIndex % FILE_COUNT, positionIndex / FILE_COUNT, (Color)color, (PieceType)pieceType);
 			}
-			stringIndex += 1;
 		}
 	}
 
-	_nextTurn = (substrings[1] == "w" ? Color::WHITE : Color::BLACK);
+	_nextTurn = fenPosition.nextTurn;
 
-	if (substrings[2] != "-")
-	{
-		for (int i = 0; i < (int)substrings[2].size(); i++)
-		{
-			switch (substrings[2][i])
-			{
-				case PIECE_SYMBOLS[Color::WHITE][PieceType::KING]:
-					_wKingSideCastle = true;
-					break;
-				case PIECE_SYMBOLS[Color::WHITE][PieceType::QUEEN]:
-					_wQueenSideCastle = true;
-					break;
-				case PIECE_SYMBOLS[Color::BLACK][PieceType::KING]:
-					_bKingSideCastle = true;
-					break;
-				case PIECE_SYMBOLS[Color::BLACK][PieceType::QUEEN]:
-					_bQueenSideCastle = true;
-					break;
-				default:
-					break;
-			}
-		}
-	}
+	_wKingSideCastle = fenPosition.kingSideCastle[Color::WHITE];
+	_wQueenSideCastle = fenPosition.queenSideCastle[Color::WHITE];
+	_bKingSideCastle = fenPosition.kingSideCastle[Color::BLACK];
+	_bQueenSideCastle = fenPosition.queenSideCastle[Color::BLACK];
 
-	if (substrings[3] != "-")
-	{
-		int x = (int)substrings[3][0] - 97,
-			y = RANK_COUNT - ((int)substrings[3][1] - 48);
+	setEnPassantFile(fenPosition.enPassantFile);
 
-		if (_board.posIsOccupied(x, y - 1, Color::WHITE, PieceType::PAWN))
-		{
-			Position source(x, y + 1),
-				currPos(x, y - 1);
+	_halfTurnCount = fenPosition.halfTurnCount;
+	_fullTurnCount = fenPosition.fullTurnCount;
 
-			_moveHistory.push_back(MoveHistoryNode(source, currPos, Color::WHITE, PieceType::PAWN));
-		}
-		else if (_board.posIsOccupied(x, y + 1, Color::BLACK, PieceType::PAWN))
-		{
-			// Add pawn move to move history
-			Position source(x, y - 1),
-				currPos(x, y + 1);
+	_board.updateAttackBoards();
+}
 
-			_moveHistory.push_back(MoveHistoryNode(source, currPos, Color::BLACK, PieceType::PAWN));
-		}
+void ChessState::setEnPassantFile(const std::optional<int>& enPassantFile)
+{
+	if (!enPassantFile.has_value())
+	{
+		return;
 	}
 
-	_halfTurnCount = std::stoi(substrings[4]);
-	_fullTurnCount = std::stoi(substrings[5]);
+	// The pawn that can be captured is recorded as the enemy's double advance, provided the pawn is there to capture
+	const Color enemy = ~_nextTurn;
+	const int x = enPassantFile.value(),
+		sourceY = PAWN_START_ROW[enemy],
+		destinationY = enemy == Color::WHITE ? sourceY - 2 : sourceY + 2;
+	if (_board.posIsOccupied(x, destinationY, enemy, PieceType::PAWN))
+	{
+		_moveHistory.push_back(MoveHistoryNode(Position(x, sourceY), Position(x, destinationY), enemy, PieceType::PAWN));
+	}
 }
 
 void ChessState::print() const
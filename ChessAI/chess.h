@@ -6,6 +6,7 @@
 #include <optional>
 
 #include "constants.h"
+#include "util/fen.h"
 #include "util/position.h"
 #include "util/bitboard/bitboardSet.h"
 #include "move/move.h"
@@ -62,6 +63,29 @@ public:
 	 */
 	ChessState(const std::string& fenString);
 
+	/**
+	 * Create a new Chess state from the fields of a parsed FEN string.
+	 *
+	 * \param fenPosition the parsed FEN string; see util::parseFen()
+	 */
+	ChessState(const util::FenPosition& fenPosition);
+
+	/**
+	 * Create a new Chess state from a board and the game state a FEN string records alongside it.
+	 *
+	 * \param board the pieces on the board
+	 * \param nextTurn the player whose turn it is
+	 * \param wKingSideCastle whether white can still king-side castle
+	 * \param wQueenSideCastle whether white can still queen-side castle
+	 * \param bKingSideCastle whether black can still king-side castle
+	 * \param bQueenSideCastle whether black can still queen-side castle
+	 * \param enPassantFile the file of the pawn that can be captured en passant, if any
+	 * \param halfTurnCount the number of half turns since the last capture or pawn advance
+	 * \param fullTurnCount the number of full turns
+	 */
+	ChessState(const util::bitboard::BitboardSet& board, const Color nextTurn, const bool wKingSideCastle, const bool wQueenSideCastle,
+		const bool bKingSideCastle, const bool bQueenSideCastle, const std::optional<int>& enPassantFile, const int halfTurnCount, const int fullTurnCount);
+
 	/**
 	 * Create a copy of a Chess state.
 	 *
@@ -97,6 +121,14 @@ public:
 	 */
 	std::string getFenString() const;
 
+	/**
+	 * Get the fields of the FEN string representation of the current game state, which can be written without
+	 * allocating by util::writeFen().
+	 *
+	 * \return the FEN fields of the current game state
+	 */
+	util::FenPosition getFenPosition() const;
+
 	/**
 	 * Get the BitboardSet representation of the current board state.
 	 *
@@ -111,6 +143,15 @@ public:
 	 */
 	const std::deque<MoveHistoryNode>& getMoveHistory() const;
 
+	/**
+	 * Get the Zobrist hash of the current game state.
+	 *
+	 * Covers piece placement, the next turn, castling rights, and the file of a pawn that can be captured en passant.
+	 *
+	 * \return 64-bit hash of the current game state
+	 */
+	uint64_t getZobristKey() const;
+
 	/**
 	 * Get the number of half turns.
 	 *
@@ -125,6 +166,22 @@ public:
 	 */
 	int getFullTurnCount() const;
 
+	/**
+	 * Get the time remaining on a player's clock.
+	 *
+	 * \param player the player whose clock is being read
+	 * \return the player's remaining time in nanoseconds
+	 */
+	double getTimeRemaining(const Color player) const;
+
+	/**
+	 * Set the time remaining on a player's clock.
+	 *
+	 * \param player the player whose clock is being set
+	 * \param timeRemaining the player's remaining time in nanoseconds
+	 */
+	void setTimeRemaining(const Color player, const double timeRemaining);
+
 	/**
 	 * Determine if the specified player can still perform a king-side castle.
 	 *
@@ -141,6 +198,13 @@ public:
 	 */
 	bool canQueenSideCastle(const Color player) const;
 
+	/**
+	 * Determine the file of the pawn that can be captured en passant.
+	 *
+	 * \return the file of the pawn, std::nullopt if no pawn can be captured en passant
+	 */
+	std::optional<int> getEnPassantFile() const;
+
 	/**
 	 * Moves a piece and updates the game state.
 	 *
@@ -160,6 +224,22 @@ public:
 	 */
 	void update(const Color player, const util::Position& source, const util::Position& destination, const PieceType promotion = PieceType::QUEEN, const bool checkWinner = true);
 
+	/**
+	 * Passes the turn to the enemy without moving a piece.
+	 *
+	 * Used by the search to detect positions where even a free move would not save the enemy.
+	 *
+	 * \return the move evicted from the move history to make room for the null move, if any
+	 */
+	std::optional<MoveHistoryNode> makeNullMove();
+
+	/**
+	 * Reverts a null move made by makeNullMove().
+	 *
+	 * \param evictedMove the move returned by the matching call to makeNullMove()
+	 */
+	void unmakeNullMove(const std::optional<MoveHistoryNode>& evictedMove);
+
 	/**
 	 * Clear the current game state.
 	 */
@@ -196,13 +276,30 @@ private:
 	 */
 	void setState(const std::string& fenString);
 
+	/**
+	 * Set the current game state based on the fields of a parsed FEN string.
+	 *
+	 * \param fenPosition the parsed FEN string
+	 */
+	void setState(const util::FenPosition& fenPosition);
+
+	/**
+	 * Record the enemy's double advance that allows a pawn to be captured en passant.
+	 *
+	 * Must be called once the board and next turn are set.
+	 *
+	 * \param enPassantFile the file of the pawn that can be captured; ignored if no enemy pawn has just advanced two
+	 *                      squares on it
+	 */
+	void setEnPassantFile(const std::optional<int>& enPassantFile);
+
 	util::bitboard::BitboardSet _board;
 	std::deque<MoveHistoryNode> _moveHistory;
 	std::optional<Color> _winner;
 	Color _nextTurn;
 	int _halfTurnCount, // Number of half turns since last capture or pawn advance
 		_fullTurnCount; // Number of full moves (starts at 1; increment after Black's move)
-	// TODO double m_wTimeRemaining, m_bTimeRemaining;
+	double _wTimeRemaining, _bTimeRemaining; // Time remaining on each player's clock in nanoseconds
 	bool _wKingSideCastle,
 		_wQueenSideCastle,
 		_bKingSideCastle,
@@ -4,6 +4,7 @@
 #include "move/move.h"
 #include "move/moveUtil.h"
 #include "move/moveLookupTable.h"
+#include "util/utility.h"
 
 #include "websocket/message/startGameRequest.h"
 #include "websocket/message/startGameResponse.h"
@@ -18,12 +19,14 @@
 
 #include <boost/asio/ip/tcp.hpp>
 
+#include <iostream>
+
 using namespace websocket::message;
 using tcp = boost::asio::ip::tcp;
 using move::Move;
 
 const unsigned int NUMBER_OF_GAME_TYPES = 3;
-const int QUIESCENT_SEARCH_DEPTH = 3, DEPTH_LIMIT = 5;
+const int SEARCH_DEPTH = 4;
 
 constexpr const char* GAME_TYPE_STRINGS[NUMBER_OF_GAME_TYPES] = {
 	"HUMAN_VS_HUMAN",
@@ -65,6 +68,8 @@ void ChessServer::run()
 			throw std::exception(errorMessage.c_str());
 		}
 		const GameType gameType = dynamic_cast<StartGameRequest*>(message.get())->gameType;
+		_searchLimits = dynamic_cast<StartGameRequest*>(message.get())->searchLimits;
+		_evaluatorType = dynamic_cast<StartGameRequest*>(message.get())->evaluatorType.value_or(evaluation::getDefaultEvaluatorType());
 
 		StartGameResponse response = _chessController.startGame(static_cast<StartGameRequest&>(*message));
 		_webSocketManager.write(response);
@@ -84,31 +89,40 @@ void ChessServer::run()
 void ChessServer::humanVsAi()
 {
 	bool gameInProgress = true;
-	Agent agent(_chessState, Color::BLACK, QUIESCENT_SEARCH_DEPTH, DEPTH_LIMIT);
+	const std::unique_ptr<Agent> agent = createAgent(_evaluatorType, _chessState, Color::BLACK, SEARCH_DEPTH);
+	agent->setSearchLimits(_searchLimits);
 
 	while (gameInProgress)
 	{
 		gameInProgress = handleHumanTurn();
 
 		if (_chessState.getNextTurn() != NEUTRAL)
-			gameInProgress = handleAiTurn(agent);
+			gameInProgress = handleAiTurn(*agent);
+
+		// Search the expected reply while waiting on the human
+		if (gameInProgress && _chessState.getNextTurn() != NEUTRAL)
+			agent->startPondering();
 	}
 }
 
 void ChessServer::aiVsAi()
 {
 	bool gameInProgress = true;
-	Agent agentWhite(_chessState, Color::WHITE, QUIESCENT_SEARCH_DEPTH, DEPTH_LIMIT);
-	Agent agentBlack(_chessState, Color::BLACK, QUIESCENT_SEARCH_DEPTH, DEPTH_LIMIT);
+	const std::unique_ptr<Agent> agentWhite = createAgent(_evaluatorType, _chessState, Color::WHITE, SEARCH_DEPTH);
+	const std::unique_ptr<Agent> agentBlack = createAgent(_evaluatorType, _chessState, Color::BLACK, SEARCH_DEPTH);
+	agentWhite->setSearchLimits(_searchLimits);
+	agentBlack->setSearchLimits(_searchLimits);
 
 	while (gameInProgress)
 	{
-		gameInProgress = handleAiTurn(_chessState.getNextTurn() == WHITE ? agentWhite : agentBlack);
+		gameInProgress = handleAiTurn(_chessState.getNextTurn() == WHITE ? *agentWhite : *agentBlack);
 	}
 }
 
 bool ChessServer::handleHumanTurn()
 {
+	const Color player = _chessState.getNextTurn();
+	const std::chrono::steady_clock::time_point turnStartTime = std::chrono::steady_clock::now();
 	bool run = true;
 	while (run)
 	{
@@ -122,20 +136,29 @@ bool ChessServer::handleHumanTurn()
 			return false;
 		run = messageType != MessageType::MAKE_MOVE_REQUEST || !static_cast<MakeMoveResponse&>(*response).success;
 	}
+	updateClock(player, turnStartTime);
 
 	return _chessState.getNextTurn() != NEUTRAL;
 }
 
 bool ChessServer::handleAiTurn(Agent& agent)
 {
-	Move move = agent.getMove();
+	const Color player = agent.getPlayer();
+	const std::chrono::steady_clock::time_point turnStartTime = std::chrono::steady_clock::now();
+	Move move = agent.getMove(_chessState.getTimeRemaining(player));
+
+	_chessState.update(player, move);
+	updateClock(player, turnStartTime);
 
-	_chessState.update(agent.getPlayer(), move);
+	const search::SearchStatistics& searchStatistics = agent.getSearchStatistics();
+	std::cout << util::toString(player) << " " << util::toFileAndRank(move.source) << util::toFileAndRank(move.destination)
+		<< ": " << searchStatistics << std::endl;
 
 	UpdateClientRequest updateClientRequest;
 	updateClientRequest.board = std::make_unique<const util::bitboard::BitboardSet>(_chessState.getBoard());
 	updateClientRequest.nextTurn = _chessState.getNextTurn();
 	updateClientRequest.winner = _chessState.getWinner();
+	updateClientRequest.searchStatistics = searchStatistics;
 
 	_webSocketManager.write(updateClientRequest);
 	const std::unique_ptr<Message> message = _webSocketManager.read();
@@ -150,6 +173,12 @@ bool ChessServer::handleAiTurn(Agent& agent)
 	return _chessState.getNextTurn() != NEUTRAL;
 }
 
+void ChessServer::updateClock(const Color player, const std::chrono::steady_clock::time_point& turnStartTime)
+{
+	const double turnTime = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - turnStartTime).count();
+	_chessState.setTimeRemaining(player, std::max(_chessState.getTimeRemaining(player) - turnTime, 0.0));
+}
+
 std::unique_ptr<Message> ChessServer::handleRequest(const Message& request)
 {
 	switch (request.getMessageType())
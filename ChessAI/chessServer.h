@@ -4,7 +4,10 @@
 #include "websocket/webSocketManager.h"
 #include "websocket/message/message.h"
 #include "chess.h"
+#include "search/searchLimits.h"
+#include "evaluation/evaluators.h"
 #include <memory>
+#include <chrono>
 
 namespace boost
 {
@@ -90,6 +93,14 @@ private:
 	 */
 	bool handleAiTurn(Agent& agent);
 
+	/**
+	 * Deducts the time a player spent on their turn from their clock.
+	 *
+	 * \param player the player whose turn has ended
+	 * \param turnStartTime the time at which the player's turn started
+	 */
+	void updateClock(const Color player, const std::chrono::steady_clock::time_point& turnStartTime);
+
 	/**
 	 * Handles client requests.
 	 *
@@ -101,4 +112,6 @@ private:
 	websocket::WebSocketManager _webSocketManager;
 	ChessState _chessState;
 	ChessController _chessController;
+	search::SearchLimits _searchLimits; // Limits requested by the client for the current game's AI players
+	evaluation::EvaluatorType _evaluatorType; // Evaluator of the current game's AI players
 };
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../constants.h"
+
+#include <cstdint>
+
+namespace evaluation
+{
+	const int ACCUMULATOR_SIZE = 128; // number of neurons in the network's first layer, per perspective
+
+	/**
+	 * The first layer of the evaluation network from each color's perspective.
+	 *
+	 * Updated from the accumulator of the previous position as moves are made, so evaluating a position only runs the
+	 * layers after it.
+	 */
+	struct alignas(32) Accumulator
+	{
+		int16_t values[COLOR_COUNT][ACCUMULATOR_SIZE];
+		bool isValid[COLOR_COUNT]; // false until the perspective is calculated, or if its king is not on the board
+	};
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "accumulatorStack.h"
+
+#include "network.h"
+#include "../search/score.h"
+#include "../util/bitboard/bitboardUtil.h"
+
+#include <algorithm>
+#include <bit>
+
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+
+namespace evaluation
+{
+	AccumulatorStack::AccumulatorStack() :
+		_entries(search::MAX_PLY + 1),
+		_entryCount(0),
+		_network(nullptr)
+	{
+	}
+
+	void AccumulatorStack::reset(const Network& network, const BitboardSet& board)
+	{
+		_network = &network;
+		_entryCount = 0;
+		push(board);
+	}
+
+	void AccumulatorStack::push(const BitboardSet& board)
+	{
+		// Lines only outgrow the stack through search extensions, so it grows rather than being sized for them
+		if (_entryCount == _entries.size())
+		{
+			_entries.resize(_entries.size() * 2);
+		}
+
+		Entry& entry = _entries[_entryCount++];
+		entry.accumulator.isValid[Color::WHITE] = false;
+		entry.accumulator.isValid[Color::BLACK] = false;
+		entry.board = &board;
+	}
+
+	void AccumulatorStack::pop()
+	{
+		_entryCount--;
+	}
+
+	const Accumulator* AccumulatorStack::getAccumulator(const Network& network, const BitboardSet& board)
+	{
+		if (_entryCount == 0 || _network != &network || _entries[_entryCount - 1].board != &board)
+		{
+			return nullptr;
+		}
+
+		const size_t lastIndex = _entryCount - 1;
+		for (int perspective = Color::WHITE; perspective < COLOR_COUNT; perspective++)
+		{
+			if (_entries[lastIndex].accumulator.isValid[perspective])
+			{
+				continue;
+			}
+
+			// The entries above the closest calculated one are calculated on the way up, so their other children reuse
+			// them; the first board of the line is calculated from scratch if nothing beneath has been
+			size_t entryIndex = lastIndex;
+			while (entryIndex > 0 && !_entries[entryIndex - 1].accumulator.isValid[perspective])
+			{
+				entryIndex--;
+			}
+
+			if (entryIndex == 0)
+			{
+				network.refreshAccumulator(_entries[0].accumulator, *_entries[0].board, (Color)perspective);
+				entryIndex++;
+			}
+
+			for (; entryIndex <= lastIndex && _entries[entryIndex - 1].accumulator.isValid[perspective]; entryIndex++)
+			{
+				update(entryIndex, (Color)perspective);
+			}
+
+			if (!_entries[lastIndex].accumulator.isValid[perspective])
+			{
+				return nullptr;
+			}
+		}
+
+		return &_entries[lastIndex].accumulator;
+	}
+
+	void AccumulatorStack::update(const size_t entryIndex, const Color perspective)
+	{
+		Entry& entry = _entries[entryIndex];
+		const Entry& previousEntry = _entries[entryIndex - 1];
+		const BitboardSet& board = *entry.board;
+		const BitboardSet& previousBoard = *previousEntry.board;
+
+		// Every input of a perspective depends on the position of its king, so moving the king recalculates them all
+		const Bitboard kingBoard = board.getBitboard(perspective, PieceType::KING);
+		if (kingBoard != previousBoard.getBitboard(perspective, PieceType::KING))
+		{
+			_network->refreshAccumulator(entry.accumulator, board, perspective);
+			return;
+		}
+
+		const int kingPositionIndex = std::countr_zero(kingBoard);
+		std::copy(previousEntry.accumulator.values[perspective], previousEntry.accumulator.values[perspective] + ACCUMULATOR_SIZE,
+			entry.accumulator.values[perspective]);
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PieceType::KING; pieceType++)
+			{
+				const Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				const Bitboard previousPieceBoard = previousBoard.getBitboard((Color)color, (PieceType)pieceType);
+
+				Bitboard removedBoard = previousPieceBoard & ~pieceBoard;
+				while (removedBoard)
+				{
+					_network->removeFeature(entry.accumulator, perspective, getFeatureIndex(perspective, kingPositionIndex, (Color)color, (PieceType)pieceType, popLsb(removedBoard)));
+				}
+
+				Bitboard addedBoard = pieceBoard & ~previousPieceBoard;
+				while (addedBoard)
+				{
+					_network->addFeature(entry.accumulator, perspective, getFeatureIndex(perspective, kingPositionIndex, (Color)color, (PieceType)pieceType, popLsb(addedBoard)));
+				}
+			}
+		}
+		entry.accumulator.isValid[perspective] = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "accumulator.h"
+#include "../util/bitboard/bitboardSet.h"
+
+#include <vector>
+
+namespace evaluation
+{
+	class Network;
+
+	/**
+	 * The accumulators of the boards along the line being searched by a thread, one entry per move made.
+	 *
+	 * Entries are pushed without being calculated. An entry is only calculated when its board is evaluated, from the
+	 * closest calculated entry beneath it and the pieces that moved between their boards, so lines cut off before an
+	 * evaluation never pay for their accumulators.
+	 */
+	class AccumulatorStack
+	{
+	public:
+		AccumulatorStack();
+
+		/**
+		 * Discards every entry and starts a new line.
+		 *
+		 * \param network the network the accumulators are calculated for; must outlive the line
+		 * \param board the board the line starts from; its pieces must not change until the line is reset
+		 */
+		void reset(const Network& network, const util::bitboard::BitboardSet& board);
+
+		/**
+		 * Adds the board reached by a move to the end of the line.
+		 *
+		 * \param board the board after the move; its pieces must not change until it is popped
+		 */
+		void push(const util::bitboard::BitboardSet& board);
+
+		/**
+		 * Removes the last board from the line.
+		 */
+		void pop();
+
+		/**
+		 * Retrieves the accumulator of the last board in the line, calculating it if it has not been yet.
+		 *
+		 * \param network the network scoring the board
+		 * \param board the board being scored
+		 * \return the accumulator, or nullptr if the board is not the last in the line, the line is for another network,
+		 *         or a king is missing
+		 */
+		const Accumulator* getAccumulator(const Network& network, const util::bitboard::BitboardSet& board);
+
+	private:
+		struct Entry
+		{
+			Accumulator accumulator; // isValid is false until the perspective is calculated
+			const util::bitboard::BitboardSet* board;
+		};
+
+		/**
+		 * Calculates a perspective of an entry from the entry beneath it.
+		 *
+		 * \param entryIndex the index of the entry being calculated; the entry beneath it must have the perspective
+		 *                   calculated
+		 * \param perspective the color whose perspective is calculated
+		 */
+		void update(const size_t entryIndex, const Color perspective);
+
+		std::vector<Entry> _entries; // only the first _entryCount are in the line; the rest are kept for reuse
+		size_t _entryCount;
+		const Network* _network; // the network the line was reset for; not owned
+	};
+}
\ No newline at end of file
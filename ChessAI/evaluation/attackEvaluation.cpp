@@ -0,0 +1,141 @@
+#include "attackEvaluation.h"
+
+#include "pawnStructure.h"
+#include "../move/moveLookupTable.h"
+#include "../util/bitboard/bitboardUtil.h"
+
+#include <algorithm>
+#include <bit>
+
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+using util::bitboard::getPawnAttacks;
+
+namespace evaluation
+{
+	// Score per safe position attacked beyond the expected number (MOBILITY_BASELINE) for each piece type
+	const Score MOBILITY_WEIGHTS[GAME_PHASE_COUNT][PIECE_TYPE_COUNT] = {
+		{ 0, 4, 5, 2, 1, 0 },
+		{ 0, 4, 5, 4, 2, 0 }
+	};
+	const int MOBILITY_BASELINE[PIECE_TYPE_COUNT] = { 0, 4, 6, 7, 13, 0 };
+
+	// Weight of each attacked position around the enemy king, by the type of the attacking piece
+	const int KING_ZONE_ATTACK_WEIGHTS[PIECE_TYPE_COUNT] = { 0, 20, 20, 40, 80, 0 };
+	// Percentage of the king zone attack weight applied by the number of attacking pieces; a lone attacker is harmless
+	const int KING_ZONE_ATTACKER_SCALE[] = { 0, 0, 50, 75, 88, 94, 97, 99 };
+	const int KING_ZONE_MAX_ATTACKERS = sizeof(KING_ZONE_ATTACKER_SCALE) / sizeof(int) - 1;
+
+	const Score HANGING_PIECE_PENALTY[GAME_PHASE_COUNT] = { 30, 40 }; // attacked and undefended piece besides a pawn
+	const Score PAWN_THREAT_PENALTY[GAME_PHASE_COUNT] = { 50, 40 }; // piece besides a pawn attacked by an enemy pawn
+	const Score MINOR_THREAT_PENALTY[GAME_PHASE_COUNT] = { 30, 20 }; // rook or queen attacked by an enemy knight or bishop
+
+	/**
+	 * Get the positions attacked by a piece.
+	 *
+	 * \param pieceType the type of the piece; must not be a pawn
+	 * \param positionIndex the index of the position of the piece
+	 * \param occupancyBoard every piece on the board; blocks sliding pieces
+	 * \return the attacked positions, including those occupied by pieces of either color
+	 */
+	Bitboard getPieceAttacks(const PieceType pieceType, const int positionIndex, const Bitboard occupancyBoard)
+	{
+		switch (pieceType)
+		{
+		case PieceType::KNIGHT:
+			return move::getKnightMoveBoard(positionIndex);
+		case PieceType::BISHOP:
+			return move::getBishopMoveBoard(positionIndex, occupancyBoard);
+		case PieceType::ROOK:
+			return move::getRookMoveBoard(positionIndex, occupancyBoard);
+		case PieceType::QUEEN:
+			return move::getBishopMoveBoard(positionIndex, occupancyBoard) | move::getRookMoveBoard(positionIndex, occupancyBoard);
+		case PieceType::KING:
+			return move::getKingMoveBoard(positionIndex);
+		default:
+			return 0;
+		}
+	}
+
+	AttackEvaluation calculateAttackEvaluation(const BitboardSet& board)
+	{
+		AttackEvaluation result = { 0, 0, { 0, 0 } };
+		const Bitboard occupancyBoard = board.getOccupancyBoard();
+
+		Bitboard pawnAttacks[COLOR_COUNT], minorAttacks[COLOR_COUNT] = { 0, 0 }, kingZones[COLOR_COUNT];
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			pawnAttacks[color] = getPawnAttacks(board.getBitboard((Color)color, PieceType::PAWN), (Color)color);
+			result.attackedPositions[color] = pawnAttacks[color];
+
+			const Bitboard kingBoard = board.getBitboard((Color)color, PieceType::KING);
+			kingZones[color] = kingBoard ? kingBoard | move::getKingMoveBoard(std::countr_zero(kingBoard)) : 0;
+		}
+
+		Score middlegameScores[COLOR_COUNT] = { 0, 0 }, endgameScores[COLOR_COUNT] = { 0, 0 };
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			const Color enemyPlayer = color == Color::WHITE ? Color::BLACK : Color::WHITE;
+			const Bitboard safePositions = ~board.getOccupancyBoard((Color)color) & ~pawnAttacks[enemyPlayer];
+			int kingZoneAttackers = 0, kingZoneAttackWeight = 0;
+
+			for (int pieceType = PieceType::KNIGHT; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				while (pieceBoard)
+				{
+					const Bitboard attacks = getPieceAttacks((PieceType)pieceType, popLsb(pieceBoard), occupancyBoard);
+					result.attackedPositions[color] |= attacks;
+					if (pieceType == PieceType::KNIGHT || pieceType == PieceType::BISHOP)
+					{
+						minorAttacks[color] |= attacks;
+					}
+
+					const int mobility = std::popcount(attacks & safePositions) - MOBILITY_BASELINE[pieceType];
+					middlegameScores[color] += MOBILITY_WEIGHTS[GamePhase::MIDDLEGAME][pieceType] * mobility;
+					endgameScores[color] += MOBILITY_WEIGHTS[GamePhase::ENDGAME][pieceType] * mobility;
+
+					const Bitboard kingZoneAttacks = attacks & kingZones[enemyPlayer];
+					if (kingZoneAttacks)
+					{
+						kingZoneAttackers++;
+						kingZoneAttackWeight += KING_ZONE_ATTACK_WEIGHTS[pieceType] * std::popcount(kingZoneAttacks);
+					}
+				}
+			}
+
+			// King attacks are decided with the queen on the board, so the term only applies to the middlegame
+			middlegameScores[color] += kingZoneAttackWeight * KING_ZONE_ATTACKER_SCALE[std::min(kingZoneAttackers, KING_ZONE_MAX_ATTACKERS)] / 100;
+		}
+
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			const Color enemyPlayer = color == Color::WHITE ? Color::BLACK : Color::WHITE;
+			const Bitboard pieces = board.getOccupancyBoard((Color)color)
+				& ~board.getBitboard((Color)color, PieceType::PAWN) & ~board.getBitboard((Color)color, PieceType::KING);
+			const Bitboard majorPieces = board.getBitboard((Color)color, PieceType::ROOK) | board.getBitboard((Color)color, PieceType::QUEEN);
+
+			const int hangingPieces = std::popcount(pieces & result.attackedPositions[enemyPlayer] & ~result.attackedPositions[color]);
+			const int pawnThreats = std::popcount(pieces & pawnAttacks[enemyPlayer]);
+			const int minorThreats = std::popcount(majorPieces & minorAttacks[enemyPlayer]);
+
+			for (int phase = GamePhase::MIDDLEGAME; phase < GAME_PHASE_COUNT; phase++)
+			{
+				Score& score = phase == GamePhase::MIDDLEGAME ? middlegameScores[color] : endgameScores[color];
+				score -= HANGING_PIECE_PENALTY[phase] * hangingPieces
+					+ PAWN_THREAT_PENALTY[phase] * pawnThreats
+					+ MINOR_THREAT_PENALTY[phase] * minorThreats;
+			}
+		}
+
+		result.middlegameScore = middlegameScores[Color::WHITE] - middlegameScores[Color::BLACK];
+		result.endgameScore = endgameScores[Color::WHITE] - endgameScores[Color::BLACK];
+		return result;
+	}
+
+	Score getAttackValue(const AttackEvaluation& attackEvaluation, const int phase, const Color player)
+	{
+		const Score value = getTaperedScore(attackEvaluation.middlegameScore, attackEvaluation.endgameScore, phase);
+		return player == Color::WHITE ? value : -value;
+	}
+}
\ No newline at end of file
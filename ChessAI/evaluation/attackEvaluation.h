@@ -0,0 +1,37 @@
+#pragma once
+
+#include "pieceSquareTables.h"
+#include "../util/bitboard/bitboardSet.h"
+
+namespace evaluation
+{
+	/**
+	 * Evaluation terms derived from the positions each piece attacks.
+	 */
+	struct AttackEvaluation
+	{
+		Score middlegameScore; // white's score minus black's score
+		Score endgameScore; // white's score minus black's score
+		Bitboard attackedPositions[COLOR_COUNT]; // every position attacked by at least one of the color's pieces
+	};
+
+	/**
+	 * Scores mobility, attacks on the enemy king's surroundings, undefended pieces and threats for both colors.
+	 *
+	 * Every term comes from a single sweep that looks up the attacks of each piece once.
+	 *
+	 * \param board the board containing the pieces; the move lookup tables must be populated
+	 * \return the attack evaluation of the board
+	 */
+	AttackEvaluation calculateAttackEvaluation(const util::bitboard::BitboardSet& board);
+
+	/**
+	 * Tapers the scores of an attack evaluation from a player's perspective.
+	 *
+	 * \param attackEvaluation the attack evaluation being scored
+	 * \param phase the phase of the game; see BitboardSet::getPhase()
+	 * \param player the player the score is being calculated for
+	 * \return the player's attack score minus the enemy's in centipawns
+	 */
+	Score getAttackValue(const AttackEvaluation& attackEvaluation, const int phase, const Color player);
+}
\ No newline at end of file
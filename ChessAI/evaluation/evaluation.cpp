@@ -0,0 +1,59 @@
+#include "evaluation.h"
+
+#include "../util/bitboard/bitboardUtil.h"
+
+#include <bit>
+
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+
+namespace evaluation
+{
+	Score getMaterialValue(const BitboardSet& board, const Color player)
+	{
+		const Color enemyPlayer = player == Color::WHITE ? Color::BLACK : Color::WHITE;
+		Score middlegameScore = 0, endgameScore = 0;
+
+		for (int pieceType = PieceType::PAWN; pieceType < PieceType::KING; pieceType++)
+		{
+			const int countDifference = std::popcount(board.getBitboard(player, (PieceType)pieceType)) - std::popcount(board.getBitboard(enemyPlayer, (PieceType)pieceType));
+			middlegameScore += countDifference * PIECE_VALUES[GamePhase::MIDDLEGAME][pieceType];
+			endgameScore += countDifference * PIECE_VALUES[GamePhase::ENDGAME][pieceType];
+		}
+
+		return getTaperedScore(middlegameScore, endgameScore, board.getPhase());
+	}
+
+	Score getPieceSquareValue(const BitboardSet& board, const Color player)
+	{
+		const Color enemyPlayer = player == Color::WHITE ? Color::BLACK : Color::WHITE;
+		const Score middlegameScore = board.getPieceSquareScore(GamePhase::MIDDLEGAME, player) - board.getPieceSquareScore(GamePhase::MIDDLEGAME, enemyPlayer);
+		const Score endgameScore = board.getPieceSquareScore(GamePhase::ENDGAME, player) - board.getPieceSquareScore(GamePhase::ENDGAME, enemyPlayer);
+
+		return getTaperedScore(middlegameScore, endgameScore, board.getPhase());
+	}
+
+	Score calculatePieceSquareValue(const BitboardSet& board, const Color player)
+	{
+		Score middlegameScore = 0, endgameScore = 0;
+		int phase = 0;
+
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			const int sign = color == player ? 1 : -1;
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				while (pieceBoard)
+				{
+					const int positionIndex = popLsb(pieceBoard);
+					middlegameScore += sign * PIECE_SQUARE_VALUES.values[GamePhase::MIDDLEGAME][color][pieceType][positionIndex];
+					endgameScore += sign * PIECE_SQUARE_VALUES.values[GamePhase::ENDGAME][color][pieceType][positionIndex];
+					phase += PHASE_WEIGHTS[pieceType];
+				}
+			}
+		}
+
+		return getTaperedScore(middlegameScore, endgameScore, phase);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "pieceSquareTables.h"
+#include "../util/bitboard/bitboardSet.h"
+
+namespace evaluation
+{
+	/**
+	 * Scores the material of a board from a player's perspective, ignoring where the pieces stand.
+	 *
+	 * \param board the board being scored
+	 * \param player the player the score is being calculated for
+	 * \return the tapered value of the player's pieces minus the enemy's pieces in centipawns
+	 */
+	Score getMaterialValue(const util::bitboard::BitboardSet& board, const Color player);
+
+	/**
+	 * Scores the material and piece placement of a board from a player's perspective.
+	 *
+	 * Reads the scores the board maintains as pieces are added and removed, so the cost does not depend on the
+	 * number of pieces.
+	 *
+	 * \param board the board being scored
+	 * \param player the player the score is being calculated for
+	 * \return the tapered score of the player's pieces minus the enemy's pieces in centipawns
+	 */
+	Score getPieceSquareValue(const util::bitboard::BitboardSet& board, const Color player);
+
+	/**
+	 * Scores the material and piece placement of a board from a player's perspective by visiting every piece.
+	 *
+	 * Produces the same score as getPieceSquareValue(); used to verify and benchmark the incremental scores.
+	 *
+	 * \param board the board being scored
+	 * \param player the player the score is being calculated for
+	 * \return the tapered score of the player's pieces minus the enemy's pieces in centipawns
+	 */
+	Score calculatePieceSquareValue(const util::bitboard::BitboardSet& board, const Color player);
+}
\ No newline at end of file
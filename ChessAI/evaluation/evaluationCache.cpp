@@ -0,0 +1,43 @@
+#include "evaluationCache.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace evaluation
+{
+	const uint64_t VALUE_MASK = 0xFFFF;
+	const uint64_t EMPTY_SLOT = 0;
+
+	EvaluationCache::EvaluationCache(const size_t sizeInMegabytes) :
+		_slotCount(std::bit_floor(std::max<size_t>(sizeInMegabytes * 1024 * 1024 / sizeof(std::atomic<uint64_t>), 1))),
+		_slots(std::make_unique<std::atomic<uint64_t>[]>(_slotCount))
+	{
+		clear();
+	}
+
+	std::optional<Score> EvaluationCache::probe(const uint64_t key) const
+	{
+		const uint64_t data = _slots[key & (_slotCount - 1)].load(std::memory_order_relaxed);
+		if (data == EMPTY_SLOT || (data & ~VALUE_MASK) != (key & ~VALUE_MASK))
+		{
+			return std::nullopt;
+		}
+
+		return (int16_t)(data & VALUE_MASK);
+	}
+
+	void EvaluationCache::store(const uint64_t key, const Score value)
+	{
+		// Clamped so that an out-of-range score saturates instead of wrapping around to the opposite sign
+		const int16_t packedValue = (int16_t)std::clamp<Score>(value, INT16_MIN, INT16_MAX);
+		_slots[key & (_slotCount - 1)].store((key & ~VALUE_MASK) | (uint16_t)packedValue, std::memory_order_relaxed);
+	}
+
+	void EvaluationCache::clear()
+	{
+		for (size_t i = 0; i < _slotCount; i++)
+		{
+			_slots[i].store(EMPTY_SLOT, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
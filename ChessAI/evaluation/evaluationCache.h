@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../search/score.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace evaluation
+{
+	using search::Score;
+
+	/**
+	 * Direct-mapped cache of static evaluations keyed by the Zobrist key of a game state, shared by every thread
+	 * searching for an agent.
+	 *
+	 * Each slot packs the upper bits of the key and the score into a single atomic word, so a slot is always read
+	 * whole and never needs a lock or checksum.
+	 */
+	class EvaluationCache
+	{
+	public:
+		EvaluationCache() = delete;
+		EvaluationCache(const EvaluationCache& source) = delete;
+
+		/**
+		 * Creates a new EvaluationCache.
+		 *
+		 * \param sizeInMegabytes the memory used by the cache; rounded down to a power of two number of entries
+		 */
+		EvaluationCache(const size_t sizeInMegabytes);
+
+		/**
+		 * Retrieves the stored evaluation of a game state.
+		 *
+		 * \param key the Zobrist key of the game state
+		 * \return the stored score for the player whose turn it is, std::nullopt if the game state has no stored score
+		 */
+		std::optional<Score> probe(const uint64_t key) const;
+
+		/**
+		 * Stores the evaluation of a game state, replacing the entry in its slot.
+		 *
+		 * \param key the Zobrist key of the game state
+		 * \param value the score for the player whose turn it is; clamped to the range of a 16-bit integer
+		 */
+		void store(const uint64_t key, const Score value);
+
+		/**
+		 * Removes every entry.
+		 */
+		void clear();
+
+	private:
+		size_t _slotCount;
+		std::unique_ptr<std::atomic<uint64_t>[]> _slots; // upper 48 bits of the key and the 16-bit score
+	};
+}
\ No newline at end of file
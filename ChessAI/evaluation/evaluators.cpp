@@ -0,0 +1,121 @@
+#include "evaluators.h"
+
+#include "evaluation.h"
+#include "network.h"
+#include "pawnStructure.h"
+#include "attackEvaluation.h"
+#include "../chess.h"
+
+#include <exception>
+
+using util::bitboard::BitboardSet;
+
+namespace evaluation
+{
+	const unsigned int NUMBER_OF_EVALUATOR_TYPES = 4;
+
+	constexpr const char* EVALUATOR_TYPE_STRINGS[NUMBER_OF_EVALUATOR_TYPES] = {
+		"MATERIAL",
+		"PIECE_SQUARE",
+		"ATTACK",
+		"NETWORK"
+	};
+
+	EvaluatorType getEvaluatorTypeFromString(const std::string& evaluatorTypeString)
+	{
+		for (unsigned int i = 0; i < NUMBER_OF_EVALUATOR_TYPES; i++)
+		{
+			if (EVALUATOR_TYPE_STRINGS[i] == evaluatorTypeString)
+				return static_cast<EvaluatorType>(i);
+		}
+
+		const std::string exceptionMessage = "No matching value of EvaluatorType for string \"" + evaluatorTypeString + "\"";
+		throw std::exception(exceptionMessage.c_str());
+	}
+
+	std::string toString(const EvaluatorType evaluatorType)
+	{
+		return EVALUATOR_TYPE_STRINGS[evaluatorType];
+	}
+
+	EvaluatorType getDefaultEvaluatorType()
+	{
+		return getNetwork() != nullptr ? EvaluatorType::NETWORK : EvaluatorType::ATTACK;
+	}
+
+	MaterialEvaluator::MaterialEvaluator(const search::SearchParameters&) {}
+
+	Score MaterialEvaluator::evaluate(const ChessState& chessState, const Color player, search::SearchStatistics&)
+	{
+		return getMaterialValue(chessState.getBoard(), player);
+	}
+
+	PieceSquareEvaluator::PieceSquareEvaluator(const search::SearchParameters&) {}
+
+	Score PieceSquareEvaluator::evaluate(const ChessState& chessState, const Color player, search::SearchStatistics&)
+	{
+		return getPieceSquareValue(chessState.getBoard(), player);
+	}
+
+	AttackEvaluator::AttackEvaluator(const search::SearchParameters& searchParameters) :
+		_pawnHashTable(searchParameters.pawnHashTableSize) {}
+
+	Score AttackEvaluator::evaluate(const ChessState& chessState, const Color player, search::SearchStatistics& statistics)
+	{
+		const BitboardSet& board = chessState.getBoard();
+		const uint64_t pawnKey = board.getPawnZobristKey();
+		std::optional<PawnStructure> pawnStructure = _pawnHashTable.probe(pawnKey);
+		statistics.pawnHashProbeCount++;
+		if (pawnStructure.has_value())
+		{
+			statistics.pawnHashHitCount++;
+		}
+		else
+		{
+			pawnStructure = calculatePawnStructure(board);
+			_pawnHashTable.store(pawnKey, pawnStructure.value());
+		}
+
+		const AttackEvaluation attackEvaluation = calculateAttackEvaluation(board);
+		return getPieceSquareValue(board, player)
+			+ getPawnStructureValue(pawnStructure.value(), board.getPhase(), player)
+			+ getAttackValue(attackEvaluation, board.getPhase(), player);
+	}
+
+	thread_local AccumulatorStack NetworkEvaluator::_accumulatorStack;
+
+	NetworkEvaluator::NetworkEvaluator(const search::SearchParameters&) :
+		_network(getSharedNetwork())
+	{
+		if (_network == nullptr)
+		{
+			throw std::exception("No evaluation network has been loaded");
+		}
+	}
+
+	Score NetworkEvaluator::evaluate(const ChessState& chessState, const Color player, search::SearchStatistics&)
+	{
+		const Accumulator* accumulator = _accumulatorStack.getAccumulator(*_network, chessState.getBoard());
+		if (accumulator == nullptr)
+		{
+			return getNetworkValue(*_network, chessState.getBoard(), player);
+		}
+
+		return _network->getValue(*accumulator, player);
+	}
+
+	void NetworkEvaluator::setRootState(const ChessState& rootState)
+	{
+		_accumulatorStack.reset(*_network, rootState.getBoard());
+	}
+
+	void NetworkEvaluator::pushGameState(const ChessState& chessState)
+	{
+		_accumulatorStack.push(chessState.getBoard());
+	}
+
+	void NetworkEvaluator::popGameState()
+	{
+		_accumulatorStack.pop();
+	}
+}
\ No newline at end of file
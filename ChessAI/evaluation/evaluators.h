@@ -0,0 +1,185 @@
+#pragma once
+
+#include "pieceSquareTables.h"
+#include "pawnHashTable.h"
+#include "network.h"
+#include "accumulatorStack.h"
+#include "../enum.h"
+#include "../search/searchParameters.h"
+#include "../search/searchStatistics.h"
+
+#include <memory>
+#include <string>
+
+class ChessState;
+
+namespace evaluation
+{
+	/**
+	 * Identifies the evaluation policies an agent can be created with.
+	 */
+	enum EvaluatorType
+	{
+		MATERIAL = 0,
+		PIECE_SQUARE = 1,
+		ATTACK = 2,
+		NETWORK = 3
+	};
+
+	/**
+	 * Converts a string to a value of EvaluatorType.
+	 *
+	 * \param evaluatorTypeString The string to be converted
+	 * \return The corresponding EvaluatorType value
+	 */
+	EvaluatorType getEvaluatorTypeFromString(const std::string& evaluatorTypeString);
+
+	/**
+	 * Converts an EvaluatorType value to a string.
+	 *
+	 * \param evaluatorType The EvaluatorType value to be converted
+	 * \return The corresponding string
+	 */
+	std::string toString(const EvaluatorType evaluatorType);
+
+	/**
+	 * Selects the evaluator used when a game does not request one.
+	 *
+	 * \return NETWORK if an evaluation network has been loaded, ATTACK otherwise
+	 */
+	EvaluatorType getDefaultEvaluatorType();
+
+	/*
+	 * Evaluation policies an agent's search is compiled against.
+	 *
+	 * Each policy is constructed from the agent's search parameters and scores a game state for the player whose turn
+	 * it is through evaluate(). CACHE_EVALUATIONS states whether scores are worth storing in the agent's evaluation
+	 * cache; evaluations cheaper than a cache probe are not. USES_ACCUMULATOR states whether the search should report
+	 * the line of game states it is searching through the policy's setRootState(), pushGameState() and popGameState().
+	 */
+
+	/**
+	 * Scores game states by material alone.
+	 */
+	class MaterialEvaluator
+	{
+	public:
+		static constexpr bool CACHE_EVALUATIONS = false;
+		static constexpr bool USES_ACCUMULATOR = false;
+
+		MaterialEvaluator(const search::SearchParameters& searchParameters);
+
+		/**
+		 * Calculates the material balance of a game state.
+		 *
+		 * \param chessState the game state being scored
+		 * \param player the player whose turn it is
+		 * \param statistics the search statistics of the calling thread
+		 * \return score of the game state in centipawns
+		 */
+		Score evaluate(const ChessState& chessState, const Color player, search::SearchStatistics& statistics);
+	};
+
+	/**
+	 * Scores game states by material and piece placement, read from the scores the board maintains incrementally.
+	 */
+	class PieceSquareEvaluator
+	{
+	public:
+		static constexpr bool CACHE_EVALUATIONS = false;
+		static constexpr bool USES_ACCUMULATOR = false;
+
+		PieceSquareEvaluator(const search::SearchParameters& searchParameters);
+
+		/**
+		 * Calculates the piece-square score of a game state.
+		 *
+		 * \param chessState the game state being scored
+		 * \param player the player whose turn it is
+		 * \param statistics the search statistics of the calling thread
+		 * \return score of the game state in centipawns
+		 */
+		Score evaluate(const ChessState& chessState, const Color player, search::SearchStatistics& statistics);
+	};
+
+	/**
+	 * Scores game states by piece placement, pawn structure, mobility, king safety and threats.
+	 */
+	class AttackEvaluator
+	{
+	public:
+		static constexpr bool CACHE_EVALUATIONS = true;
+		static constexpr bool USES_ACCUMULATOR = false;
+
+		AttackEvaluator(const search::SearchParameters& searchParameters);
+
+		/**
+		 * Calculates the score of a game state, reusing pawn structures stored in the pawn hash table.
+		 *
+		 * \param chessState the game state being scored
+		 * \param player the player whose turn it is
+		 * \param statistics the search statistics of the calling thread; counts pawn hash table probes
+		 * \return score of the game state in centipawns
+		 */
+		Score evaluate(const ChessState& chessState, const Color player, search::SearchStatistics& statistics);
+
+	private:
+		PawnHashTable _pawnHashTable;
+	};
+
+	/**
+	 * Scores game states with the loaded evaluation network.
+	 */
+	class NetworkEvaluator
+	{
+	public:
+		static constexpr bool CACHE_EVALUATIONS = true;
+		static constexpr bool USES_ACCUMULATOR = true;
+
+		/**
+		 * Creates a new NetworkEvaluator.
+		 *
+		 * Throws if no evaluation network has been loaded.
+		 *
+		 * \param searchParameters the agent's search parameters
+		 */
+		NetworkEvaluator(const search::SearchParameters& searchParameters);
+
+		/**
+		 * Calculates the network's score of a game state.
+		 *
+		 * The last game state in the calling thread's line is scored from its accumulator, which is updated from the
+		 * game states before it; any other game state has its accumulator calculated from scratch.
+		 *
+		 * \param chessState the game state being scored
+		 * \param player the player whose turn it is
+		 * \param statistics the search statistics of the calling thread
+		 * \return score of the game state in centipawns
+		 */
+		Score evaluate(const ChessState& chessState, const Color player, search::SearchStatistics& statistics);
+
+		/**
+		 * Starts a new line of game states on the calling thread.
+		 *
+		 * \param rootState the game state the search starts from; its pieces must not change until the line is restarted
+		 */
+		void setRootState(const ChessState& rootState);
+
+		/**
+		 * Adds the game state reached by a move to the end of the calling thread's line.
+		 *
+		 * \param chessState the game state after the move; its pieces must not change until it is popped
+		 */
+		void pushGameState(const ChessState& chessState);
+
+		/**
+		 * Removes the last game state from the calling thread's line.
+		 */
+		void popGameState();
+
+	private:
+		static thread_local AccumulatorStack _accumulatorStack; // each searching thread follows its own line
+
+		std::shared_ptr<const Network> _network; // kept alive while the agent searches, even if another network is set
+	};
+}
\ No newline at end of file
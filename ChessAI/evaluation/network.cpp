@@ -0,0 +1,286 @@
+#include "network.h"
+
+#include "evaluation.h"
+#include "../util/bitboard/bitboardUtil.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NETWORK_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NETWORK_SSE2
+#endif
+
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+
+namespace evaluation
+{
+	const uint32_t NETWORK_FILE_MAGIC = 0x504b4c48; // "HLKP"
+	const int RANDOM_WEIGHT_RANGE = 32;
+
+	std::shared_ptr<const Network> activeNetwork;
+
+	/**
+	 * Get the sum of the clipped first layer outputs of a perspective multiplied by their output weights.
+	 *
+	 * \param values the perspective's accumulator values
+	 * \param weights the output weights of the perspective's half of the first layer
+	 * \return the weighted sum
+	 */
+	int32_t getWeightedSumScalar(const int16_t* values, const int16_t* weights)
+	{
+		int32_t result = 0;
+		for (int i = 0; i < ACCUMULATOR_SIZE; i++)
+		{
+			const int32_t value = values[i] < 0 ? 0 : (values[i] > NETWORK_ACTIVATION_MAX ? NETWORK_ACTIVATION_MAX : values[i]);
+			result += value * weights[i];
+		}
+		return result;
+	}
+
+	/**
+	 * Get the sum of the clipped first layer outputs of a perspective multiplied by their output weights, using SIMD
+	 * instructions when the build targets them.
+	 *
+	 * \param values the perspective's accumulator values
+	 * \param weights the output weights of the perspective's half of the first layer
+	 * \return the weighted sum
+	 */
+	int32_t getWeightedSum(const int16_t* values, const int16_t* weights)
+	{
+#if defined(NETWORK_AVX2)
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i activationMax = _mm256_set1_epi16(NETWORK_ACTIVATION_MAX);
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < ACCUMULATOR_SIZE; i += 16)
+		{
+			__m256i value = _mm256_load_si256((const __m256i*)(values + i));
+			value = _mm256_min_epi16(_mm256_max_epi16(value, zero), activationMax);
+			const __m256i weight = _mm256_load_si256((const __m256i*)(weights + i));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(value, weight));
+		}
+		__m128i halfSum = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		halfSum = _mm_add_epi32(halfSum, _mm_shuffle_epi32(halfSum, _MM_SHUFFLE(1, 0, 3, 2)));
+		halfSum = _mm_add_epi32(halfSum, _mm_shuffle_epi32(halfSum, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(halfSum);
+#elif defined(NETWORK_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i activationMax = _mm_set1_epi16(NETWORK_ACTIVATION_MAX);
+		__m128i sum = _mm_setzero_si128();
+		for (int i = 0; i < ACCUMULATOR_SIZE; i += 8)
+		{
+			__m128i value = _mm_load_si128((const __m128i*)(values + i));
+			value = _mm_min_epi16(_mm_max_epi16(value, zero), activationMax);
+			const __m128i weight = _mm_load_si128((const __m128i*)(weights + i));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(value, weight));
+		}
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(sum);
+#else
+		return getWeightedSumScalar(values, weights);
+#endif
+	}
+
+	/**
+	 * Converts the output neuron's sum to centipawns, clamped below the mate scores so that an extreme evaluation is
+	 * never mistaken for a forced mate.
+	 *
+	 * \param sum the output neuron's weighted sum, including its bias
+	 * \return the score in centipawns
+	 */
+	Score getScaledOutput(const int64_t sum)
+	{
+		const int64_t value = sum * NETWORK_OUTPUT_SCALE / (NETWORK_ACTIVATION_MAX * NETWORK_OUTPUT_WEIGHT_SCALE);
+		return (Score)std::clamp<int64_t>(value, -(search::SCORE_MATE_IN_MAX_PLY - 1), search::SCORE_MATE_IN_MAX_PLY - 1);
+	}
+
+	int getFeatureIndex(const Color perspective, const int kingPositionIndex, const Color color, const PieceType pieceType, const int positionIndex)
+	{
+		const int orientation = perspective == Color::WHITE ? 0 : SQUARE_COUNT - FILE_COUNT;
+		const int pieceIndex = pieceType * COLOR_COUNT + (color == perspective ? 0 : 1);
+		return ((kingPositionIndex ^ orientation) * HALFKP_PIECE_COUNT + pieceIndex) * SQUARE_COUNT + (positionIndex ^ orientation);
+	}
+
+	Network::Network() :
+		_featureWeights((size_t)HALFKP_FEATURE_COUNT * ACCUMULATOR_SIZE, 0),
+		_featureBiases(),
+		_outputWeights(),
+		_outputBias(0)
+	{
+	}
+
+	void Network::load(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::exception("Unable to open network file");
+		}
+
+		uint32_t header[3];
+		file.read((char*)header, sizeof(header));
+		if (!file || header[0] != NETWORK_FILE_MAGIC || header[1] != HALFKP_FEATURE_COUNT || header[2] != ACCUMULATOR_SIZE)
+		{
+			throw std::exception("Network file does not match the network's architecture");
+		}
+
+		file.read((char*)_featureWeights.data(), _featureWeights.size() * sizeof(int16_t));
+		file.read((char*)_featureBiases, sizeof(_featureBiases));
+		file.read((char*)_outputWeights, sizeof(_outputWeights));
+		file.read((char*)&_outputBias, sizeof(_outputBias));
+		if (!file)
+		{
+			throw std::exception("Network file is truncated");
+		}
+	}
+
+	void Network::save(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+		{
+			throw std::exception("Unable to create network file");
+		}
+
+		const uint32_t header[3] = { NETWORK_FILE_MAGIC, HALFKP_FEATURE_COUNT, ACCUMULATOR_SIZE };
+		file.write((const char*)header, sizeof(header));
+		file.write((const char*)_featureWeights.data(), _featureWeights.size() * sizeof(int16_t));
+		file.write((const char*)_featureBiases, sizeof(_featureBiases));
+		file.write((const char*)_outputWeights, sizeof(_outputWeights));
+		file.write((const char*)&_outputBias, sizeof(_outputBias));
+		if (!file)
+		{
+			throw std::exception("Unable to write network file");
+		}
+	}
+
+	void Network::randomize(const uint32_t seed)
+	{
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<int> distribution(-RANDOM_WEIGHT_RANGE, RANDOM_WEIGHT_RANGE);
+
+		for (int16_t& weight : _featureWeights)
+		{
+			weight = (int16_t)distribution(generator);
+		}
+		for (int i = 0; i < ACCUMULATOR_SIZE; i++)
+		{
+			_featureBiases[i] = (int16_t)distribution(generator);
+		}
+		for (int i = 0; i < COLOR_COUNT * ACCUMULATOR_SIZE; i++)
+		{
+			_outputWeights[i] = (int16_t)distribution(generator);
+		}
+		_outputBias = distribution(generator);
+	}
+
+	void Network::refreshAccumulator(Accumulator& accumulator, const BitboardSet& board, const Color perspective) const
+	{
+		const Bitboard kingBoard = board.getBitboard(perspective, PieceType::KING);
+		if (std::popcount(kingBoard) != 1)
+		{
+			accumulator.isValid[perspective] = false;
+			return;
+		}
+		const int kingPositionIndex = std::countr_zero(kingBoard);
+
+		std::copy(_featureBiases, _featureBiases + ACCUMULATOR_SIZE, accumulator.values[perspective]);
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PieceType::KING; pieceType++)
+			{
+				Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				while (pieceBoard)
+				{
+					addFeature(accumulator, perspective, getFeatureIndex(perspective, kingPositionIndex, (Color)color, (PieceType)pieceType, popLsb(pieceBoard)));
+				}
+			}
+		}
+		accumulator.isValid[perspective] = true;
+	}
+
+	void Network::addFeature(Accumulator& accumulator, const Color perspective, const int featureIndex) const
+	{
+		const int16_t* weights = _featureWeights.data() + (size_t)featureIndex * ACCUMULATOR_SIZE;
+		int16_t* values = accumulator.values[perspective];
+		for (int i = 0; i < ACCUMULATOR_SIZE; i++)
+		{
+			values[i] += weights[i];
+		}
+	}
+
+	void Network::removeFeature(Accumulator& accumulator, const Color perspective, const int featureIndex) const
+	{
+		const int16_t* weights = _featureWeights.data() + (size_t)featureIndex * ACCUMULATOR_SIZE;
+		int16_t* values = accumulator.values[perspective];
+		for (int i = 0; i < ACCUMULATOR_SIZE; i++)
+		{
+			values[i] -= weights[i];
+		}
+	}
+
+	Score Network::getValue(const Accumulator& accumulator, const Color player) const
+	{
+		const Color enemyPlayer = player == Color::WHITE ? Color::BLACK : Color::WHITE;
+		const int64_t sum = (int64_t)getWeightedSum(accumulator.values[player], _outputWeights)
+			+ getWeightedSum(accumulator.values[enemyPlayer], _outputWeights + ACCUMULATOR_SIZE)
+			+ _outputBias;
+		return getScaledOutput(sum);
+	}
+
+	Score Network::getValueScalar(const Accumulator& accumulator, const Color player) const
+	{
+		const Color enemyPlayer = player == Color::WHITE ? Color::BLACK : Color::WHITE;
+		const int64_t sum = (int64_t)getWeightedSumScalar(accumulator.values[player], _outputWeights)
+			+ getWeightedSumScalar(accumulator.values[enemyPlayer], _outputWeights + ACCUMULATOR_SIZE)
+			+ _outputBias;
+		return getScaledOutput(sum);
+	}
+
+	void setNetwork(std::unique_ptr<Network> network)
+	{
+		activeNetwork = std::move(network);
+	}
+
+	void loadNetwork(const std::string& path)
+	{
+		std::unique_ptr<Network> network = std::make_unique<Network>();
+		network->load(path);
+		setNetwork(std::move(network));
+	}
+
+	const Network* getNetwork()
+	{
+		return activeNetwork.get();
+	}
+
+	std::shared_ptr<const Network> getSharedNetwork()
+	{
+		return activeNetwork;
+	}
+
+	Score getNetworkValue(const Network& network, const BitboardSet& board, const Color player)
+	{
+		Accumulator refreshedAccumulator;
+		network.refreshAccumulator(refreshedAccumulator, board, Color::WHITE);
+		network.refreshAccumulator(refreshedAccumulator, board, Color::BLACK);
+		if (!refreshedAccumulator.isValid[Color::WHITE] || !refreshedAccumulator.isValid[Color::BLACK])
+		{
+			return getPieceSquareValue(board, player);
+		}
+
+		return network.getValue(refreshedAccumulator, player);
+	}
+
+	Score getNetworkValue(const BitboardSet& board, const Color player)
+	{
+		return getNetworkValue(*activeNetwork, board, player);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "accumulator.h"
+#include "pieceSquareTables.h"
+#include "../util/bitboard/bitboardSet.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace evaluation
+{
+	const int HALFKP_PIECE_COUNT = COLOR_COUNT * (PIECE_TYPE_COUNT - 1); // every piece except the kings
+	const int HALFKP_FEATURE_COUNT = SQUARE_COUNT * HALFKP_PIECE_COUNT * SQUARE_COUNT;
+	const int NETWORK_ACTIVATION_MAX = 255; // first layer outputs are clipped to [0, NETWORK_ACTIVATION_MAX]
+	const int NETWORK_OUTPUT_WEIGHT_SCALE = 64; // output weights are quantized by this factor
+	const int NETWORK_OUTPUT_SCALE = 400; // converts the network's output to centipawns
+
+	/**
+	 * Get the index of the input that represents a piece from a perspective.
+	 *
+	 * Inputs pair the perspective's king position with every other piece (HalfKP). Positions are mirrored vertically
+	 * for black, so both perspectives share the same weights.
+	 *
+	 * \param perspective the color whose king the piece is paired with
+	 * \param kingPositionIndex the index of the position of the perspective's king
+	 * \param color the color of the piece
+	 * \param pieceType the type of the piece; must not be a king
+	 * \param positionIndex the index of the position of the piece
+	 * \return the index of the input
+	 */
+	int getFeatureIndex(const Color perspective, const int kingPositionIndex, const Color color, const PieceType pieceType, const int positionIndex);
+
+	/**
+	 * A quantized neural network scoring positions from HalfKP inputs.
+	 *
+	 * The first layer is stored in an Accumulator for each perspective and updated a piece at a time. The clipped
+	 * accumulators of the player and the enemy are concatenated and reduced to a score by a single output neuron.
+	 */
+	class Network
+	{
+	public:
+		/**
+		 * Creates a network with every weight set to zero.
+		 */
+		Network();
+
+		/**
+		 * Reads the network's weights from a file written by save().
+		 *
+		 * \param path the path of the file
+		 */
+		void load(const std::string& path);
+
+		/**
+		 * Writes the network's weights to a file.
+		 *
+		 * The file holds a header with the input and accumulator sizes, followed by the first layer's weights and
+		 * biases and the output neuron's weights and bias, all as little-endian integers.
+		 *
+		 * \param path the path of the file
+		 */
+		void save(const std::string& path) const;
+
+		/**
+		 * Sets every weight to a small random value.
+		 *
+		 * \param seed the seed of the random number generator
+		 */
+		void randomize(const uint32_t seed);
+
+		/**
+		 * Recalculates a perspective of an accumulator from every piece on a board.
+		 *
+		 * \param accumulator the accumulator being recalculated
+		 * \param board the board containing the pieces
+		 * \param perspective the perspective being recalculated; left invalid if the board does not have its king
+		 */
+		void refreshAccumulator(Accumulator& accumulator, const util::bitboard::BitboardSet& board, const Color perspective) const;
+
+		/**
+		 * Adds an input's weights to a perspective of an accumulator.
+		 *
+		 * \param accumulator the accumulator being updated
+		 * \param perspective the perspective being updated
+		 * \param featureIndex the index of the input being activated
+		 */
+		void addFeature(Accumulator& accumulator, const Color perspective, const int featureIndex) const;
+
+		/**
+		 * Subtracts an input's weights from a perspective of an accumulator.
+		 *
+		 * \param accumulator the accumulator being updated
+		 * \param perspective the perspective being updated
+		 * \param featureIndex the index of the input being deactivated
+		 */
+		void removeFeature(Accumulator& accumulator, const Color perspective, const int featureIndex) const;
+
+		/**
+		 * Calculates the network's score using the widest instruction set the build targets.
+		 *
+		 * \param accumulator an accumulator whose perspectives are both valid
+		 * \param player the player the score is being calculated for
+		 * \return the score in centipawns
+		 */
+		Score getValue(const Accumulator& accumulator, const Color player) const;
+
+		/**
+		 * Calculates the network's score without SIMD instructions.
+		 *
+		 * \param accumulator an accumulator whose perspectives are both valid
+		 * \param player the player the score is being calculated for
+		 * \return the score in centipawns; the same as getValue()
+		 */
+		Score getValueScalar(const Accumulator& accumulator, const Color player) const;
+
+	private:
+		std::vector<int16_t> _featureWeights; // HALFKP_FEATURE_COUNT rows of ACCUMULATOR_SIZE weights
+		alignas(32) int16_t _featureBiases[ACCUMULATOR_SIZE];
+		alignas(32) int16_t _outputWeights[COLOR_COUNT * ACCUMULATOR_SIZE]; // the player's half followed by the enemy's
+		int32_t _outputBias;
+	};
+
+	/**
+	 * Replaces the network used to evaluate positions.
+	 *
+	 * Agents created earlier keep searching with the network they were created with.
+	 *
+	 * \param network the network to use; nullptr to evaluate with the piece-square tables instead
+	 */
+	void setNetwork(std::unique_ptr<Network> network);
+
+	/**
+	 * Reads a network from a file and uses it to evaluate positions.
+	 *
+	 * \param path the path of a file written by Network::save()
+	 */
+	void loadNetwork(const std::string& path);
+
+	/**
+	 * Retrieves the network used to evaluate positions.
+	 *
+	 * \return the network set by setNetwork(), or nullptr if none is set
+	 */
+	const Network* getNetwork();
+
+	/**
+	 * Retrieves the network used to evaluate positions, sharing its ownership so it outlives a later setNetwork().
+	 *
+	 * \return the network set by setNetwork(), or nullptr if none is set
+	 */
+	std::shared_ptr<const Network> getSharedNetwork();
+
+	/**
+	 * Scores a board from a player's perspective with a network.
+	 *
+	 * Calculates the board's accumulator from scratch; searches score their boards through a NetworkEvaluator, which
+	 * updates accumulators from the previous board instead. Boards without both kings are scored with the piece-square
+	 * tables.
+	 *
+	 * \param network the network scoring the board
+	 * \param board the board being scored
+	 * \param player the player the score is being calculated for
+	 * \return the score in centipawns
+	 */
+	Score getNetworkValue(const Network& network, const util::bitboard::BitboardSet& board, const Color player);
+
+	/**
+	 * Scores a board from a player's perspective with the network used to evaluate positions.
+	 *
+	 * \param board the board being scored; a network must be set
+	 * \param player the player the score is being calculated for
+	 * \return the score in centipawns
+	 */
+	Score getNetworkValue(const util::bitboard::BitboardSet& board, const Color player);
+}
\ No newline at end of file
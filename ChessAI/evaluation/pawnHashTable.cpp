@@ -0,0 +1,62 @@
+#include "pawnHashTable.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace evaluation
+{
+	const int ENDGAME_SCORE_SHIFT = 32;
+
+	PawnHashTable::PawnHashTable(const size_t sizeInMegabytes) :
+		_slotCount(std::bit_floor(std::max<size_t>(sizeInMegabytes * 1024 * 1024 / sizeof(Slot), 1))),
+		_slots(std::make_unique<Slot[]>(_slotCount))
+	{
+		clear();
+	}
+
+	std::optional<PawnStructure> PawnHashTable::probe(const uint64_t key) const
+	{
+		const Slot& slot = _slots[key & (_slotCount - 1)];
+		const uint64_t scores = slot.scores.load(std::memory_order_relaxed);
+		const uint64_t whitePassedPawns = slot.passedPawns[Color::WHITE].load(std::memory_order_relaxed);
+		const uint64_t blackPassedPawns = slot.passedPawns[Color::BLACK].load(std::memory_order_relaxed);
+		const uint64_t checksum = slot.checksum.load(std::memory_order_relaxed);
+
+		// An empty slot matches the key of a board without pawns, whose structure is also empty
+		if ((checksum ^ scores ^ whitePassedPawns ^ blackPassedPawns) != key)
+		{
+			return std::nullopt;
+		}
+
+		PawnStructure result;
+		result.middlegameScore = (int32_t)(uint32_t)scores;
+		result.endgameScore = (int32_t)(uint32_t)(scores >> ENDGAME_SCORE_SHIFT);
+		result.passedPawns[Color::WHITE] = whitePassedPawns;
+		result.passedPawns[Color::BLACK] = blackPassedPawns;
+
+		return result;
+	}
+
+	void PawnHashTable::store(const uint64_t key, const PawnStructure& pawnStructure)
+	{
+		Slot& slot = _slots[key & (_slotCount - 1)];
+		const uint64_t scores = (uint64_t)(uint32_t)pawnStructure.middlegameScore
+			| ((uint64_t)(uint32_t)pawnStructure.endgameScore << ENDGAME_SCORE_SHIFT);
+
+		slot.checksum.store(key ^ scores ^ pawnStructure.passedPawns[Color::WHITE] ^ pawnStructure.passedPawns[Color::BLACK], std::memory_order_relaxed);
+		slot.scores.store(scores, std::memory_order_relaxed);
+		slot.passedPawns[Color::WHITE].store(pawnStructure.passedPawns[Color::WHITE], std::memory_order_relaxed);
+		slot.passedPawns[Color::BLACK].store(pawnStructure.passedPawns[Color::BLACK], std::memory_order_relaxed);
+	}
+
+	void PawnHashTable::clear()
+	{
+		for (size_t i = 0; i < _slotCount; i++)
+		{
+			_slots[i].checksum.store(0, std::memory_order_relaxed);
+			_slots[i].scores.store(0, std::memory_order_relaxed);
+			_slots[i].passedPawns[Color::WHITE].store(0, std::memory_order_relaxed);
+			_slots[i].passedPawns[Color::BLACK].store(0, std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
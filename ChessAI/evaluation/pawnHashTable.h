@@ -0,0 +1,64 @@
+#pragma once
+
+#include "pawnStructure.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace evaluation
+{
+	/**
+	 * Fixed-size hash table of pawn structures keyed by the Zobrist key of the pawns, shared by every thread searching
+	 * for an agent.
+	 *
+	 * Pawns move rarely compared to other pieces, so most evaluations find their pawn structure here. Like the
+	 * transposition table, slots are written without locks and verified with a checksum of the key and the data.
+	 */
+	class PawnHashTable
+	{
+	public:
+		PawnHashTable() = delete;
+		PawnHashTable(const PawnHashTable& source) = delete;
+
+		/**
+		 * Creates a new PawnHashTable.
+		 *
+		 * \param sizeInMegabytes the memory used by the table; rounded down to a power of two number of entries
+		 */
+		PawnHashTable(const size_t sizeInMegabytes);
+
+		/**
+		 * Retrieves the stored pawn structure for an arrangement of pawns.
+		 *
+		 * \param key the pawn Zobrist key of the board; see BitboardSet::getPawnZobristKey()
+		 * \return the stored pawn structure, std::nullopt if the pawns have no stored structure
+		 */
+		std::optional<PawnStructure> probe(const uint64_t key) const;
+
+		/**
+		 * Stores the pawn structure for an arrangement of pawns, replacing the entry in its slot.
+		 *
+		 * \param key the pawn Zobrist key of the board
+		 * \param pawnStructure the pawn structure being stored
+		 */
+		void store(const uint64_t key, const PawnStructure& pawnStructure);
+
+		/**
+		 * Removes every entry.
+		 */
+		void clear();
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> checksum; // key XOR every data word
+			std::atomic<uint64_t> scores; // middlegame score (32 bits) and endgame score (32 bits)
+			std::atomic<uint64_t> passedPawns[COLOR_COUNT];
+		};
+
+		size_t _slotCount;
+		std::unique_ptr<Slot[]> _slots;
+	};
+}
\ No newline at end of file
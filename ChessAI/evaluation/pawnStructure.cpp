@@ -0,0 +1,135 @@
+#include "pawnStructure.h"
+
+#include "../util/bitboard/bitboardUtil.h"
+
+#include <bit>
+
+using util::bitboard::BitboardSet;
+using util::bitboard::Shift;
+using util::bitboard::shiftBitboard;
+using util::bitboard::getPawnAttacks;
+using util::bitboard::popLsb;
+using util::bitboard::up;
+using util::bitboard::down;
+using util::bitboard::left;
+using util::bitboard::right;
+
+namespace evaluation
+{
+	const Score DOUBLED_PAWN_PENALTY[GAME_PHASE_COUNT] = { 10, 20 };
+	const Score ISOLATED_PAWN_PENALTY[GAME_PHASE_COUNT] = { 15, 10 };
+	const Score BACKWARD_PAWN_PENALTY[GAME_PHASE_COUNT] = { 8, 10 };
+
+	// Indexed by the number of ranks a passed pawn is from its own side's back rank
+	const Score PASSED_PAWN_BONUS[GAME_PHASE_COUNT][RANK_COUNT] = {
+		{ 0, 5, 10, 15, 25, 40, 60, 0 },
+		{ 0, 10, 20, 35, 55, 80, 110, 0 }
+	};
+
+	/**
+	 * Get the Shift that moves a pawn one rank forward.
+	 *
+	 * \param color the color of the pawn
+	 * \return the forward Shift of the color's pawns
+	 */
+	Shift getForwardShift(const Color color)
+	{
+		return color == Color::WHITE ? up(1) : down(1);
+	}
+
+	/**
+	 * Get the positions on or in front of each pawn on its file.
+	 *
+	 * \param pawnBoard the pawns being filled from
+	 * \param color the color whose forward direction the pawns are filled in
+	 * \return the filled bitboard
+	 */
+	Bitboard getFrontFill(Bitboard pawnBoard, const Color color)
+	{
+		const Shift forward = getForwardShift(color);
+		pawnBoard |= shiftBitboard(pawnBoard, forward);
+		pawnBoard |= shiftBitboard(pawnBoard, forward * 2);
+		pawnBoard |= shiftBitboard(pawnBoard, forward * 4);
+		return pawnBoard;
+	}
+
+	/**
+	 * Get the positions in front of each pawn on its file, excluding the pawns themselves.
+	 *
+	 * \param pawnBoard the pawns whose front spans are being found
+	 * \param color the color whose forward direction the spans extend in
+	 * \return the front spans of the pawns
+	 */
+	Bitboard getFrontSpan(const Bitboard pawnBoard, const Color color)
+	{
+		return getFrontFill(shiftBitboard(pawnBoard, getForwardShift(color)), color);
+	}
+
+	/**
+	 * Get the files adjacent to the positions on a bitboard.
+	 *
+	 * \param board the bitboard being spread
+	 * \return the positions one file to either side of the positions on the bitboard
+	 */
+	Bitboard getAdjacentPositions(const Bitboard board)
+	{
+		return shiftBitboard(board, left(1)) | shiftBitboard(board, right(1));
+	}
+
+	PawnStructure calculatePawnStructure(const BitboardSet& board)
+	{
+		PawnStructure result = { 0, 0, { 0, 0 } };
+
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			const Color player = (Color)color;
+			const Color enemyPlayer = player == Color::WHITE ? Color::BLACK : Color::WHITE;
+			const Bitboard pawnBoard = board.getBitboard(player, PieceType::PAWN);
+			const Bitboard enemyPawnBoard = board.getBitboard(enemyPlayer, PieceType::PAWN);
+
+			// A pawn with an ally pawn in front of it on the same file
+			const Bitboard doubledPawns = pawnBoard & getFrontSpan(pawnBoard, enemyPlayer);
+
+			const Bitboard fileFill = getFrontFill(pawnBoard, Color::WHITE) | getFrontFill(pawnBoard, Color::BLACK);
+			const Bitboard isolatedPawns = pawnBoard & ~getAdjacentPositions(fileFill);
+
+			const Bitboard enemyFrontSpans = getFrontSpan(enemyPawnBoard, enemyPlayer);
+			const Bitboard passedPawns = pawnBoard & ~(enemyFrontSpans | getAdjacentPositions(enemyFrontSpans));
+
+			// A pawn whose next position is attacked by an enemy pawn and can never be defended by an ally pawn
+			const Bitboard stopPositions = shiftBitboard(pawnBoard, getForwardShift(player));
+			const Bitboard allyAttackSpans = getFrontFill(getPawnAttacks(pawnBoard, player), player);
+			const Bitboard unsupportedStopPositions = stopPositions & getPawnAttacks(enemyPawnBoard, enemyPlayer) & ~allyAttackSpans;
+			const Bitboard backwardPawns = shiftBitboard(unsupportedStopPositions, getForwardShift(enemyPlayer));
+
+			Score middlegameScore = -DOUBLED_PAWN_PENALTY[GamePhase::MIDDLEGAME] * std::popcount(doubledPawns)
+				- ISOLATED_PAWN_PENALTY[GamePhase::MIDDLEGAME] * std::popcount(isolatedPawns)
+				- BACKWARD_PAWN_PENALTY[GamePhase::MIDDLEGAME] * std::popcount(backwardPawns);
+			Score endgameScore = -DOUBLED_PAWN_PENALTY[GamePhase::ENDGAME] * std::popcount(doubledPawns)
+				- ISOLATED_PAWN_PENALTY[GamePhase::ENDGAME] * std::popcount(isolatedPawns)
+				- BACKWARD_PAWN_PENALTY[GamePhase::ENDGAME] * std::popcount(backwardPawns);
+
+			Bitboard remainingPassedPawns = passedPawns;
+			while (remainingPassedPawns)
+			{
+				const int y = popLsb(remainingPassedPawns) / FILE_COUNT;
+				const int relativeRank = player == Color::WHITE ? RANK_COUNT - 1 - y : y;
+				middlegameScore += PASSED_PAWN_BONUS[GamePhase::MIDDLEGAME][relativeRank];
+				endgameScore += PASSED_PAWN_BONUS[GamePhase::ENDGAME][relativeRank];
+			}
+
+			const int sign = player == Color::WHITE ? 1 : -1;
+			result.middlegameScore += sign * middlegameScore;
+			result.endgameScore += sign * endgameScore;
+			result.passedPawns[player] = passedPawns;
+		}
+
+		return result;
+	}
+
+	Score getPawnStructureValue(const PawnStructure& pawnStructure, const int phase, const Color player)
+	{
+		const Score value = getTaperedScore(pawnStructure.middlegameScore, pawnStructure.endgameScore, phase);
+		return player == Color::WHITE ? value : -value;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pieceSquareTables.h"
+#include "../util/bitboard/bitboardSet.h"
+
+namespace evaluation
+{
+	/**
+	 * Evaluation terms that only depend on the positions of the pawns.
+	 */
+	struct PawnStructure
+	{
+		Score middlegameScore; // white's score minus black's score
+		Score endgameScore; // white's score minus black's score
+		Bitboard passedPawns[COLOR_COUNT]; // pawns without enemy pawns ahead of them on their own or adjacent files
+	};
+
+	/**
+	 * Scores the passed, isolated, doubled and backward pawns of both colors.
+	 *
+	 * \param board the board containing the pawns
+	 * \return the pawn structure of the board
+	 */
+	PawnStructure calculatePawnStructure(const util::bitboard::BitboardSet& board);
+
+	/**
+	 * Tapers the scores of a pawn structure from a player's perspective.
+	 *
+	 * \param pawnStructure the pawn structure being scored
+	 * \param phase the phase of the game; see BitboardSet::getPhase()
+	 * \param player the player the score is being calculated for
+	 * \return the player's pawn structure score minus the enemy's in centipawns
+	 */
+	Score getPawnStructureValue(const PawnStructure& pawnStructure, const int phase, const Color player);
+}
\ No newline at end of file
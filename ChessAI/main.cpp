@@ -1,12 +1,63 @@
 #include "chessServer.h"
+#include "tools/bench.h"
+#include "tools/tuner.h"
+#include "tools/spsa.h"
+#include "tools/tournament.h"
+#include "tools/dataGenerator.h"
+#include "tools/pgnReplay.h"
+#include "evaluation/network.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
 
 namespace asio = boost::asio;
 using tcp = asio::ip::tcp;
 
-int main(int arc, char* argv[])
+int main(int argc, char* argv[])
 {
 	try
 	{
+		std::vector<std::string> args(argv + 1, argv + argc);
+
+		// The network is loaded before any command runs, since agents keep the network loaded when they are created
+		const auto networkArg = std::find(args.begin(), args.end(), "--network");
+		if (networkArg != args.end())
+		{
+			if (networkArg + 1 == args.end())
+			{
+				std::cerr << "--network requires the path of a network file" << std::endl;
+				return 1;
+			}
+			evaluation::loadNetwork(*(networkArg + 1));
+			args.erase(networkArg, networkArg + 2);
+		}
+
+		if (!args.empty() && args[0] == "bench")
+		{
+			return tools::runBenchmark(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+		if (!args.empty() && args[0] == "tune")
+		{
+			return tools::runTuner(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+		if (!args.empty() && args[0] == "spsa")
+		{
+			return tools::runSpsa(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+		if (!args.empty() && args[0] == "match")
+		{
+			return tools::runTournament(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+		if (!args.empty() && args[0] == "datagen")
+		{
+			return tools::runDataGenerator(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+		if (!args.empty() && args[0] == "pgn")
+		{
+			return tools::runPgnReplay(std::vector<std::string>(args.begin() + 1, args.end()));
+		}
+
 		while (true)
 		{
 			const tcp::endpoint endpoint(tcp::v4(), 8080);
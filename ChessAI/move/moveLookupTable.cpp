@@ -5,6 +5,7 @@
 #include <math.h>
 #include <random>
 #include <stack>
+#include <mutex>
 
 #include "../util/bitboard/bitboardUtil.h"
 #include "../util/threadPool.h"
@@ -34,6 +35,8 @@ namespace move
 
 	Bitboard kingMoveLookupTable[SQUARE_COUNT];
 
+	std::once_flag lookupTablesPopulated;
+
 	Bitboard getKnightMoveBoard(const int positionIndex)
 	{
 		return knightMoveLookupTable[positionIndex];
@@ -230,9 +233,10 @@ namespace move
 			down(1) + right(1)
 		};
 
+		std::vector<std::future<void>> futures;
 		for (int positionIndex = 0; positionIndex < SQUARE_COUNT; positionIndex++)
 		{
-			threadPool.submit([positionIndex]() {
+			futures.push_back(threadPool.submit([positionIndex]() {
 				const Bitboard blockerMask = generateBlockerMask(positionIndex, bishopShifts);
 				const std::vector<Bitboard> blockerBoards = generateBlockerBoards(positionIndex, blockerMask);
 				std::vector<Bitboard> moves;
@@ -255,7 +259,12 @@ namespace move
 					const int blockerHash = (blockerBoard * blockerHashCoefficient) >> (64 - blockerCount);
 					bishopMoveLookupTable[positionIndex] = moves;
 				}
-			});
+			}));
+		}
+
+		for (const std::future<void>& future : futures)
+		{
+			future.wait();
 		}
 	}
 
@@ -268,9 +277,10 @@ namespace move
 			right(1)
 		};
 
+		std::vector<std::future<void>> futures;
 		for (int positionIndex = 0; positionIndex < SQUARE_COUNT; positionIndex++)
 		{
-			threadPool.submit([positionIndex]() {
+			futures.push_back(threadPool.submit([positionIndex]() {
 				const Bitboard blockerMask = generateBlockerMask(positionIndex, rookShifts);
 				const std::vector<Bitboard> blockerBoards = generateBlockerBoards(positionIndex, blockerMask);
 				std::vector<Bitboard> moves;
@@ -293,7 +303,12 @@ namespace move
 					const int blockerHash = (blockerBoard * blockerHashCoefficient) >> (64 - blockerCount);
 					rookMoveLookupTable[positionIndex] = moves;
 				}
-			});
+			}));
+		}
+
+		for (const std::future<void>& future : futures)
+		{
+			future.wait();
 		}
 	}
 
@@ -324,15 +339,20 @@ namespace move
 
 	void populateLookupTables()
 	{
-		std::vector<std::future<void>> futures;
-		futures.push_back(threadPool.submit(populateKnightMoveLookupTable));
-		futures.push_back(threadPool.submit(populateBishopMoveLookupTable));
-		futures.push_back(threadPool.submit(populateRookMoveLookupTable));
-		futures.push_back(threadPool.submit(populateKingMoveLookupTable));
-
-		for (const std::future<void>& future : futures)
+		std::call_once(lookupTablesPopulated, []()
 		{
-			future.wait();
-		}
+			std::vector<std::future<void>> futures;
+			futures.push_back(threadPool.submit(populateKnightMoveLookupTable));
+			futures.push_back(threadPool.submit(populateKingMoveLookupTable));
+
+			// Sliding pieces already split their work per square, so waiting on it from a pool thread could starve the pool
+			populateBishopMoveLookupTable();
+			populateRookMoveLookupTable();
+
+			for (const std::future<void>& future : futures)
+			{
+				future.wait();
+			}
+		});
 	}
 }
@@ -45,6 +45,8 @@ namespace move
 
 	/**
 	 * Populate the move lookup tables to be used during move generation.
+	 *
+	 * Only the first call populates the tables; later calls return once they are populated.
 	 */
 	void populateLookupTables();
 }
@@ -8,6 +8,8 @@
 #include "move.h"
 #include "moveGeneration.h"
 
+#include <algorithm>
+
 #define UP Position::UP
 #define DOWN Position::DOWN
 #define LEFT Position::LEFT
@@ -21,175 +23,6 @@ using util::bitboard::BitboardSet;
 
 namespace move
 {
-	bool isInBounds(const Position& position)
-	{
-		return position.x >= 0 && position.x < FILE_COUNT && position.y >= 0 && position.y < RANK_COUNT;
-	}
-
-	bool canBeCapturedByPawn(const ChessState& chessState, const Color player, const Position& position)
-	{
-		if ((Color::WHITE == player && position.y == 0) || (Color::BLACK == player && position.y == RANK_COUNT - 1))
-		{
-			return false;
-		}
-
-		const Color enemyPlayer = ~player;
-		const Position backward = player == Color::WHITE ? UP : DOWN;
-		const BitboardSet& board = chessState.getBoard();
-
-		Position attackerPos = position + backward + LEFT;
-		if (attackerPos.x >= 0 && board.posIsOccupied(attackerPos, enemyPlayer, PieceType::PAWN))
-		{
-			return true;
-		}
-
-		attackerPos = position + backward + RIGHT;
-		return attackerPos.x < RANK_COUNT && board.posIsOccupied(attackerPos, enemyPlayer, PieceType::PAWN);
-	}
-
-	bool canBeCapturedByKnight(const ChessState& chessState, const Color player, const Position& position)
-	{
-		static std::vector<Position> knightDirections = {
-			UP + RIGHT * 2,
-			UP + LEFT * 2,
-			DOWN + RIGHT * 2,
-			DOWN + LEFT * 2,
-			UP * 2 + RIGHT,
-			UP * 2 + LEFT,
-			DOWN * 2 + RIGHT,
-			DOWN * 2 + LEFT
-		};
-		const Color enemyPlayer = ~player;
-		const BitboardSet& board = chessState.getBoard();
-
-		for (const Position& direction : knightDirections)
-		{
-			const Position attackerPos = position + direction;
-			if (isInBounds(attackerPos) && board.posIsOccupied(attackerPos, enemyPlayer, PieceType::KNIGHT))
-			{
-				return true;
-			}
-		}
-
-		return false;
-	}
-
-	bool canBeCapturedBySlider(const ChessState& chessState, const Color player, const Position& position)
-	{
-		const Color enemyPlayer = ~player;
-		const BitboardSet& board = chessState.getBoard();
-
-		static std::vector<Position> diagonalDirections = {
-			UP + LEFT,
-			UP + RIGHT,
-			DOWN + LEFT,
-			DOWN + RIGHT
-		};
-
-		for (const Position& direction : diagonalDirections)
-		{
-			Position attackerPos = position + direction;
-			while (isInBounds(attackerPos))
-			{
-				if (board.posIsOccupied(attackerPos))
-				{
-					if (board.posIsOccupied(attackerPos, enemyPlayer, PieceType::BISHOP)
-						|| board.posIsOccupied(attackerPos, enemyPlayer, PieceType::QUEEN))
-					{
-						return true;
-					}
-					else
-					{
-						break;
-					}
-				}
-				attackerPos += direction;
-			}
-		}
-
-		static std::vector<Position> straightDirections = {
-			UP,
-			DOWN,
-			LEFT,
-			RIGHT
-		};
-
-		for (const Position& direction : straightDirections)
-		{
-			Position attackerPos = position + direction;
-			while (isInBounds(attackerPos))
-			{
-				if (board.posIsOccupied(attackerPos))
-				{
-					if (board.posIsOccupied(attackerPos, enemyPlayer, PieceType::ROOK)
-						|| board.posIsOccupied(attackerPos, enemyPlayer, PieceType::QUEEN))
-					{
-						return true;
-					}
-					else
-					{
-						break;
-					}
-				}
-				attackerPos += direction;
-			}
-		}
-
-		return false;
-	}
-
-	bool canBeCapturedByKing(const ChessState& chessState, const Color player, const Position& position)
-	{
-		static std::vector<Position> kingDirections = {
-			UP,
-			DOWN,
-			LEFT,
-			RIGHT,
-			UP + LEFT,
-			UP + RIGHT,
-			DOWN + LEFT,
-			DOWN + RIGHT
-		};
-		const Color enemyPlayer = ~player;
-		const BitboardSet& board = chessState.getBoard();
-
-		for (const Position& direction : kingDirections)
-		{
-			const Position attackerPos = position + direction;
-			if (isInBounds(attackerPos) && board.posIsOccupied(attackerPos, enemyPlayer, PieceType::KING))
-			{
-				return true;
-			}
-		}
-
-		return false;
-	}
-
-	bool canBeCaptured(const Color player, const ChessState& chessState, const Position& position)
-	{
-		if (canBeCapturedByPawn(chessState, player, position))
-		{
-			return true;
-		}
-
-		if (canBeCapturedByKnight(chessState, player, position))
-		{
-			return true;
-		}
-
-		if (canBeCapturedBySlider(chessState, player, position))
-		{
-			return true;
-		}
-
-		if (canBeCapturedByKing(chessState, player, position))
-		{
-			return true;
-		}
-
-		return false;
-	}
-
 	bool canCastle(const Color player, const ChessState& chessState, const bool kingSide)
 	{
 		bool canCastle;
@@ -223,8 +56,9 @@ namespace move
 			{
 				// Set safePath to false if any position the king would pass over could be attacked
 				//      (this include the position the king lands on)
-				bool safePath = !(canBeCaptured(player, chessState, position + direction)
-					|| canBeCaptured(player, chessState, position + direction * 2));
+				const Bitboard pathBoard = util::bitboard::positionToBitboard(kingPosition + direction)
+					| util::bitboard::positionToBitboard(kingPosition + direction * 2);
+				bool safePath = !(chessState.getBoard().getAttackBoard(~player) & pathBoard);
 
 				if (safePath)
 				{
@@ -236,7 +70,7 @@ namespace move
 		return false;
 	}
 
-	std::vector<Move> getValidMoves(const ChessState& chessState, const Color player)
+	std::vector<Move> generatePseudoLegalMoves(const ChessState& chessState, const Color player)
 	{
 		std::vector<Move> result = generatePawnMoves(chessState, player);
 
@@ -255,19 +89,13 @@ namespace move
 		std::vector<Move> kingMoves = generateKingMoves(chessState, player);
 		result.insert(result.end(), std::make_move_iterator(kingMoves.begin()), std::make_move_iterator(kingMoves.end()));
 
-		const Position kingStartPosition = KING_START_POS[player];
-		if (canCastle(player, chessState, true))
-		{
-			result.emplace_back(kingStartPosition, kingStartPosition + RIGHT * 2);
-		}
-
-		if (canCastle(player, chessState, false))
-		{
-			result.emplace_back(kingStartPosition, kingStartPosition + LEFT * 2);
-		}
+		return result;
+	}
 
-		std::vector<Move>::iterator move = result.begin();
-		while (move != result.end())
+	void removeMovesThatResultInCheck(const ChessState& chessState, const Color player, std::vector<Move>& moves)
+	{
+		std::vector<Move>::iterator move = moves.begin();
+		while (move != moves.end())
 		{
 			ChessState gameCopy(chessState);
 
@@ -276,17 +104,93 @@ namespace move
 			if (inCheck(player, gameCopy))
 			{
 				// Erase current move and set move equal to next move
-				move = result.erase(move);
+				move = moves.erase(move);
 			}
 			else
 			{
 				move++;
 			}
 		}
+	}
+
+	std::vector<Move> getValidMoves(const ChessState& chessState, const Color player)
+	{
+		std::vector<Move> result = generatePseudoLegalMoves(chessState, player);
+
+		const Position kingStartPosition = KING_START_POS[player];
+		if (canCastle(player, chessState, true))
+		{
+			result.emplace_back(kingStartPosition, kingStartPosition + RIGHT * 2);
+		}
+
+		if (canCastle(player, chessState, false))
+		{
+			result.emplace_back(kingStartPosition, kingStartPosition + LEFT * 2);
+		}
+
+		removeMovesThatResultInCheck(chessState, player, result);
 
 		return result;
 	}
 
+	std::vector<Move> getValidMoves(const ChessState& chessState, const Color player, const Position& destination)
+	{
+		std::vector<Move> result = generatePseudoLegalMoves(chessState, player);
+
+		// Filter out moves ending elsewhere before the more expensive legality check
+		const auto endsElsewhere = [&destination](const Move& move) {
+			return move.destination != destination;
+		};
+		result.erase(std::remove_if(result.begin(), result.end(), endsElsewhere), result.end());
+
+		const Position kingStartPosition = KING_START_POS[player];
+		if (destination == kingStartPosition + RIGHT * 2 && canCastle(player, chessState, true))
+		{
+			result.emplace_back(kingStartPosition, destination);
+		}
+		else if (destination == kingStartPosition + LEFT * 2 && canCastle(player, chessState, false))
+		{
+			result.emplace_back(kingStartPosition, destination);
+		}
+
+		removeMovesThatResultInCheck(chessState, player, result);
+
+		return result;
+	}
+
+	std::vector<Move> getValidCaptures(const ChessState& chessState, const Color player)
+	{
+		std::vector<Move> result = generatePseudoLegalMoves(chessState, player);
+
+		// Filter out quiet moves before the more expensive legality check
+		const auto isQuiet = [&chessState, player](const Move& move) {
+			return !isCapture(chessState, player, move) && !isPromotion(chessState, player, move);
+		};
+		result.erase(std::remove_if(result.begin(), result.end(), isQuiet), result.end());
+
+		removeMovesThatResultInCheck(chessState, player, result);
+
+		return result;
+	}
+
+	bool isCapture(const ChessState& chessState, const Color player, const Move& move)
+	{
+		const BitboardSet& board = chessState.getBoard();
+		if (board.posIsOccupied(move.destination, ~player))
+		{
+			return true;
+		}
+
+		// A pawn changing files without landing on an enemy piece is capturing en passant
+		return move.source.x != move.destination.x && board.posIsOccupied(move.source, player, PieceType::PAWN);
+	}
+
+	bool isPromotion(const ChessState& chessState, const Color player, const Move& move)
+	{
+		const int endOfBoard = player == Color::WHITE ? 0 : RANK_COUNT - 1;
+		return move.destination.y == endOfBoard && chessState.getBoard().posIsOccupied(move.source, player, PieceType::PAWN);
+	}
+
 	bool isValidMove(const Color player, const Position& source, const Position& destination, const ChessState& chessState)
 	{
 		if (source == destination)
@@ -499,13 +403,6 @@ namespace move
 
 	bool inCheck(const Color player, const ChessState& chessState)
 	{
-		const BitboardSet& board = chessState.getBoard();
-		Bitboard kingBoard = board.getBitboard(player, PieceType::KING);
-		const int kingPositionIndex = util::bitboard::popLsb(kingBoard);
-		const Position kingPosition = util::toPosition(kingPositionIndex);
-
-		// Return true if king's position can be attacked by opposing player
-		//      return false otherwise
-		return canBeCaptured(player, chessState, kingPosition);
+		return chessState.getBoard().getCheckers(player) != 0;
 	}
 }
\ No newline at end of file
@@ -16,6 +16,45 @@ namespace move
 	 */
 	std::vector<Move> getValidMoves(const ChessState& chessState, const Color player);
 
+	/**
+	 * Get all valid moves for the specified player that end on a position.
+	 *
+	 * \param chessState game state
+	 * \param player player whose moves are being generated
+	 * \param destination the position the moves end on
+	 * \return vector of valid moves ending on the destination
+	 */
+	std::vector<Move> getValidMoves(const ChessState& chessState, const Color player, const util::Position& destination);
+
+	/**
+	 * Get all valid captures and promotions for the specified player.
+	 *
+	 * \param chessState game state
+	 * \param player player whose moves are being generated
+	 * \return vector of valid captures and promotions
+	 */
+	std::vector<Move> getValidCaptures(const ChessState& chessState, const Color player);
+
+	/**
+	 * Determines if a move captures an enemy piece, including en passant.
+	 *
+	 * \param chessState game state before the move
+	 * \param player owner of the piece being moved
+	 * \param move the move being checked
+	 * \return true if the move is a capture, false otherwise
+	 */
+	bool isCapture(const ChessState& chessState, const Color player, const Move& move);
+
+	/**
+	 * Determines if a move promotes a pawn.
+	 *
+	 * \param chessState game state before the move
+	 * \param player owner of the piece being moved
+	 * \param move the move being checked
+	 * \return true if the move is a promotion, false otherwise
+	 */
+	bool isPromotion(const ChessState& chessState, const Color player, const Move& move);
+
 	/**
 	 * Determines if a move is valid.
 	 *
@@ -0,0 +1,221 @@
+#include "san.h"
+
+#include "moveUtil.h"
+#include "../util/utility.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using util::operator~;
+using util::Position;
+
+namespace move
+{
+	const char CAPTURE_SYMBOL = 'x';
+	const char PROMOTION_SYMBOL = '=';
+	const char CHECK_SYMBOL = '+';
+	const char CHECKMATE_SYMBOL = '#';
+	const std::string_view KING_SIDE_CASTLE = "O-O", QUEEN_SIDE_CASTLE = "O-O-O";
+	const std::string_view KING_SIDE_CASTLE_ZEROS = "0-0", QUEEN_SIDE_CASTLE_ZEROS = "0-0-0";
+	const std::string_view SAN_SUFFIX_SYMBOLS = "+#!?";
+
+	/**
+	 * Get the piece type written for a piece in standard algebraic notation.
+	 *
+	 * \param symbol the uppercase piece letter
+	 * \return the piece type, PieceType::NONE if the symbol is not a piece letter
+	 */
+	PieceType getPieceTypeFromSymbol(const char symbol)
+	{
+		for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+		{
+			if (PIECE_SYMBOLS[Color::WHITE][pieceType] == symbol)
+			{
+				return (PieceType)pieceType;
+			}
+		}
+		return PieceType::NONE;
+	}
+
+	std::optional<Move> parseSan(const ChessState& chessState, std::string_view san)
+	{
+		const Color player = chessState.getNextTurn();
+		const util::bitboard::BitboardSet& board = chessState.getBoard();
+
+		while (!san.empty() && SAN_SUFFIX_SYMBOLS.find(san.back()) != std::string_view::npos)
+		{
+			san.remove_suffix(1);
+		}
+
+		// Castling is a king move of two files, which the move generator only produces while castling is legal
+		const bool kingSideCastle = san == KING_SIDE_CASTLE || san == KING_SIDE_CASTLE_ZEROS;
+		if (kingSideCastle || san == QUEEN_SIDE_CASTLE || san == QUEEN_SIDE_CASTLE_ZEROS)
+		{
+			const Position source = KING_START_POS[player],
+				destination = source + (kingSideCastle ? Position::RIGHT : Position::LEFT) * 2;
+			const Move castle(source, destination);
+			const std::vector<Move> validMoves = getValidMoves(chessState, player, destination);
+			if (!board.posIsOccupied(source, player, PieceType::KING) || std::find(validMoves.begin(), validMoves.end(), castle) == validMoves.end())
+			{
+				return std::nullopt;
+			}
+			return castle;
+		}
+
+		PieceType pieceType = PieceType::PAWN;
+		if (!san.empty() && getPieceTypeFromSymbol(san.front()) != PieceType::NONE)
+		{
+			pieceType = getPieceTypeFromSymbol(san.front());
+			san.remove_prefix(1);
+		}
+
+		PieceType promotion = PieceType::NONE;
+		if (!san.empty() && pieceType == PieceType::PAWN && getPieceTypeFromSymbol(san.back()) != PieceType::NONE)
+		{
+			promotion = getPieceTypeFromSymbol(san.back());
+			san.remove_suffix(1);
+			if (!san.empty() && san.back() == PROMOTION_SYMBOL)
+			{
+				san.remove_suffix(1);
+			}
+			if (promotion == PieceType::PAWN || promotion == PieceType::KING)
+			{
+				return std::nullopt;
+			}
+		}
+
+		if (san.size() < 2 || san[san.size() - 2] < 'a' || san[san.size() - 2] >= 'a' + FILE_COUNT
+			|| san.back() < '1' || san.back() >= '1' + RANK_COUNT)
+		{
+			return std::nullopt;
+		}
+		const Position destination(san[san.size() - 2] - 'a', RANK_COUNT - (san.back() - '0'));
+		san.remove_suffix(2);
+
+		if (!san.empty() && san.back() == CAPTURE_SYMBOL)
+		{
+			san.remove_suffix(1);
+		}
+
+		// Whatever is left disambiguates the source by file, rank or both
+		std::optional<int> sourceX, sourceY;
+		if (!san.empty() && san.front() >= 'a' && san.front() < 'a' + FILE_COUNT)
+		{
+			sourceX = san.front() - 'a';
+			san.remove_prefix(1);
+		}
+		if (!san.empty() && san.front() >= '1' && san.front() < '1' + RANK_COUNT)
+		{
+			sourceY = RANK_COUNT - (san.front() - '0');
+			san.remove_prefix(1);
+		}
+		if (!san.empty())
+		{
+			return std::nullopt;
+		}
+
+		// Pawns only leave their file when capturing, which is always written with the source file
+		if (pieceType == PieceType::PAWN && !sourceX.has_value())
+		{
+			sourceX = destination.x;
+		}
+
+		std::optional<Move> result;
+		for (const Move& move : getValidMoves(chessState, player, destination))
+		{
+			if (board.posIsOccupied(move.source, player, pieceType)
+				&& (!sourceX.has_value() || move.source.x == sourceX.value())
+				&& (!sourceY.has_value() || move.source.y == sourceY.value()))
+			{
+				if (result.has_value())
+				{
+					return std::nullopt;
+				}
+				result = move;
+			}
+		}
+
+		if (result.has_value() && isPromotion(chessState, player, result.value()))
+		{
+			result.value().promotion = promotion == PieceType::NONE ? PieceType::QUEEN : promotion;
+		}
+		else if (promotion != PieceType::NONE)
+		{
+			return std::nullopt;
+		}
+
+		return result;
+	}
+
+	std::string toSan(const ChessState& chessState, const Move& move)
+	{
+		const Color player = chessState.getNextTurn();
+		const util::bitboard::BitboardSet& board = chessState.getBoard();
+		const PieceType pieceType = board.getPieceType(move.source);
+
+		std::string san;
+		if (pieceType == PieceType::KING && std::abs(move.destination.x - move.source.x) == 2)
+		{
+			san = move.destination.x > move.source.x ? KING_SIDE_CASTLE : QUEEN_SIDE_CASTLE;
+		}
+		else
+		{
+			const bool capture = isCapture(chessState, player, move);
+			if (pieceType == PieceType::PAWN)
+			{
+				if (capture)
+				{
+					san += (char)('a' + move.source.x);
+				}
+			}
+			else
+			{
+				san += PIECE_SYMBOLS[Color::WHITE][pieceType];
+
+				// Name the source file, rank or both if another piece of the same type can reach the destination
+				bool ambiguous = false, sharesFile = false, sharesRank = false;
+				for (const Move& otherMove : getValidMoves(chessState, player, move.destination))
+				{
+					if (otherMove.source != move.source && board.posIsOccupied(otherMove.source, player, pieceType))
+					{
+						ambiguous = true;
+						sharesFile = sharesFile || otherMove.source.x == move.source.x;
+						sharesRank = sharesRank || otherMove.source.y == move.source.y;
+					}
+				}
+
+				if (ambiguous && (!sharesFile || sharesRank))
+				{
+					san += (char)('a' + move.source.x);
+				}
+				if (ambiguous && sharesFile)
+				{
+					san += (char)('0' + RANK_COUNT - move.source.y);
+				}
+			}
+
+			if (capture)
+			{
+				san += CAPTURE_SYMBOL;
+			}
+			san += util::toFileAndRank(move.destination);
+		}
+
+		const PieceType promotion = move.promotion == PieceType::NONE ? PieceType::QUEEN : move.promotion;
+		if (isPromotion(chessState, player, move))
+		{
+			san += PROMOTION_SYMBOL;
+			san += PIECE_SYMBOLS[Color::WHITE][promotion];
+		}
+
+		ChessState nextState(chessState);
+		nextState.update(player, move, promotion, false);
+		if (inCheck(~player, nextState))
+		{
+			san += getValidMoves(nextState, ~player).empty() ? CHECKMATE_SYMBOL : CHECK_SYMBOL;
+		}
+
+		return san;
+	}
+}
\ No newline at end of file
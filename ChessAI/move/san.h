@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../chess.h"
+#include "move.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace move
+{
+	/**
+	 * Resolves a move written in standard algebraic notation against the legal moves of the player to move.
+	 *
+	 * Check, checkmate and annotation suffixes are ignored, castling may be written with letters or zeros, and a pawn
+	 * reaching the last rank without a promotion piece is promoted to a queen.
+	 *
+	 * https://www.chess.com/terms/chess-notation
+	 *
+	 * \param chessState game state before the move
+	 * \param san the move in standard algebraic notation, such as "Nbd7", "exd6", "e8=N" or "O-O-O"
+	 * \return the move, with its promotion set if it promotes a pawn; std::nullopt if the notation is malformed,
+	 *         ambiguous or does not describe a legal move
+	 */
+	std::optional<Move> parseSan(const ChessState& chessState, const std::string_view san);
+
+	/**
+	 * Writes a legal move in standard algebraic notation.
+	 *
+	 * \param chessState game state before the move
+	 * \param move a legal move for the player to move; promotes to a queen unless its promotion is set
+	 * \return the move in standard algebraic notation, including any check or checkmate suffix
+	 */
+	std::string toSan(const ChessState& chessState, const Move& move);
+}
\ No newline at end of file
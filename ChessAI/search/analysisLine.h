@@ -0,0 +1,20 @@
+#pragma once
+
+#include "score.h"
+#include "../move/move.h"
+
+#include <vector>
+
+namespace search
+{
+	/**
+	 * A root move with the result of searching it.
+	 */
+	struct AnalysisLine
+	{
+		move::Move move;
+		Score value = SCORE_DRAW; // exact score of the move from the perspective of the player to move
+		int depth = 0; // depth the move was searched to
+		std::vector<move::Move> principalVariation; // the expected line of play, starting with move
+	};
+}
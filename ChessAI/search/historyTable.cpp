@@ -0,0 +1,29 @@
+#include "historyTable.h"
+
+namespace search
+{
+	HistoryTable::HistoryTable()
+	{
+		for (std::atomic<int>& score : _scores)
+		{
+			score.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	int HistoryTable::getScore(const move::Move& move) const
+	{
+		return _scores[getIndex(move)].load(std::memory_order_relaxed);
+	}
+
+	void HistoryTable::addScore(const move::Move& move, const int bonus)
+	{
+		_scores[getIndex(move)].fetch_add(bonus, std::memory_order_relaxed);
+	}
+
+	size_t HistoryTable::getIndex(const move::Move& move)
+	{
+		const size_t sourceIndex = move.source.y * FILE_COUNT + move.source.x;
+		const size_t destinationIndex = move.destination.y * FILE_COUNT + move.destination.x;
+		return sourceIndex * RANK_COUNT * FILE_COUNT + destinationIndex;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../move/move.h"
+#include "../constants.h"
+
+#include <array>
+#include <atomic>
+
+namespace search
+{
+	/**
+	 * Scores quiet moves by how often they were the best move of a node, shared between search threads.
+	 *
+	 * Updates are relaxed, so concurrent updates to the same move may occasionally be lost, which only affects move ordering.
+	 */
+	class HistoryTable
+	{
+	public:
+		/**
+		 * Creates a new HistoryTable with every score set to 0.
+		 */
+		HistoryTable();
+
+		HistoryTable(const HistoryTable& source) = delete;
+
+		/**
+		 * Retrieves the score of a move.
+		 *
+		 * \param move the move being scored
+		 * \return the history score of the move
+		 */
+		int getScore(const move::Move& move) const;
+
+		/**
+		 * Increases the score of a move.
+		 *
+		 * \param move the move being rewarded
+		 * \param bonus the amount added to the move's score
+		 */
+		void addScore(const move::Move& move, const int bonus);
+
+	private:
+		/**
+		 * Calculates the index of a move's score.
+		 *
+		 * \param move the move
+		 * \return index of the move's score, based on its source and destination
+		 */
+		static size_t getIndex(const move::Move& move);
+
+		std::array<std::atomic<int>, RANK_COUNT * FILE_COUNT * RANK_COUNT * FILE_COUNT> _scores;
+	};
+}
@@ -0,0 +1,96 @@
+#include "parameterRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <type_traits>
+
+namespace search
+{
+	/**
+	 * Registers a field of SearchParameters.
+	 *
+	 * \param name the name of the field
+	 * \param member the field
+	 * \param minValue the least value the field may be set to
+	 * \param maxValue the greatest value the field may be set to
+	 * \param step the perturbation the SPSA tuner applies by its final iteration
+	 * \return the registered parameter
+	 */
+	template <typename T>
+	TunableParameter createTunableParameter(const std::string& name, T SearchParameters::* member, const double minValue, const double maxValue, const double step)
+	{
+		return TunableParameter{
+			name,
+			minValue,
+			maxValue,
+			step,
+			[member](const SearchParameters& searchParameters) {
+				return (double)(searchParameters.*member);
+			},
+			[member, minValue, maxValue](SearchParameters& searchParameters, const double value) {
+				const double clampedValue = std::clamp(value, minValue, maxValue);
+				if constexpr (std::is_integral_v<T>)
+				{
+					searchParameters.*member = (T)std::lround(clampedValue);
+				}
+				else
+				{
+					searchParameters.*member = (T)clampedValue;
+				}
+			}
+		};
+	}
+
+	const std::vector<TunableParameter>& getTunableParameters()
+	{
+		static const std::vector<TunableParameter> tunableParameters = {
+			createTunableParameter("aspirationMinDepth", &SearchParameters::aspirationMinDepth, 1, 8, 1),
+			createTunableParameter("aspirationWindow", &SearchParameters::aspirationWindow, 10, 200, 10),
+			createTunableParameter("nullMoveMinDepth", &SearchParameters::nullMoveMinDepth, 1, 5, 1),
+			createTunableParameter("nullMoveReduction", &SearchParameters::nullMoveReduction, 1, 4, 0.5),
+			createTunableParameter("nullMoveDeepReduction", &SearchParameters::nullMoveDeepReduction, 2, 5, 0.5),
+			createTunableParameter("nullMoveDeepDepth", &SearchParameters::nullMoveDeepDepth, 3, 12, 1),
+			createTunableParameter("nullMoveVerificationDepth", &SearchParameters::nullMoveVerificationDepth, 3, 16, 1.5),
+			createTunableParameter("lateMoveMinDepth", &SearchParameters::lateMoveMinDepth, 2, 6, 1),
+			createTunableParameter("lateMoveMinIndex", &SearchParameters::lateMoveMinIndex, 1, 8, 1),
+			createTunableParameter("lateMoveReductionBase", &SearchParameters::lateMoveReductionBase, 0.0, 2.0, 0.1),
+			createTunableParameter("lateMoveReductionDivisor", &SearchParameters::lateMoveReductionDivisor, 1.0, 4.0, 0.2),
+			createTunableParameter("futilityMaxDepth", &SearchParameters::futilityMaxDepth, 1, 4, 1),
+			createTunableParameter("futilityMargin", &SearchParameters::futilityMargin, 50, 400, 20),
+			createTunableParameter("reverseFutilityMaxDepth", &SearchParameters::reverseFutilityMaxDepth, 1, 6, 1),
+			createTunableParameter("reverseFutilityMargin", &SearchParameters::reverseFutilityMargin, 50, 300, 15)
+		};
+
+		return tunableParameters;
+	}
+
+	const TunableParameter& getTunableParameter(const std::string& name)
+	{
+		const std::vector<TunableParameter>& tunableParameters = getTunableParameters();
+		const auto parameter = std::find_if(tunableParameters.begin(), tunableParameters.end(), [&name](const TunableParameter& tunableParameter) {
+			return tunableParameter.name == name;
+		});
+
+		if (parameter == tunableParameters.end())
+		{
+			const std::string exceptionMessage = "No tunable search parameter named \"" + name + "\"";
+			throw std::exception(exceptionMessage.c_str());
+		}
+
+		return *parameter;
+	}
+
+	void setTunableParameter(SearchParameters& searchParameters, const std::string& assignment)
+	{
+		const size_t separatorIndex = assignment.find('=');
+		if (separatorIndex == std::string::npos)
+		{
+			const std::string exceptionMessage = "Expected a search parameter assignment of the form name=value: \"" + assignment + "\"";
+			throw std::exception(exceptionMessage.c_str());
+		}
+
+		const TunableParameter& parameter = getTunableParameter(assignment.substr(0, separatorIndex));
+		parameter.set(searchParameters, std::stod(assignment.substr(separatorIndex + 1)));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "searchParameters.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace search
+{
+	/**
+	 * A search parameter that can be read and written by name at runtime, along with the range it may be tuned within.
+	 */
+	struct TunableParameter
+	{
+		std::string name;
+		double minValue;
+		double maxValue;
+		double step; // perturbation the SPSA tuner applies by its final iteration
+		std::function<double(const SearchParameters&)> get;
+		std::function<void(SearchParameters&, const double)> set; // clamps to the range and rounds integer parameters
+	};
+
+	/**
+	 * Retrieves every tunable search parameter.
+	 *
+	 * \return the registered parameters
+	 */
+	const std::vector<TunableParameter>& getTunableParameters();
+
+	/**
+	 * Retrieves a tunable search parameter by name.
+	 *
+	 * \param name the name of the parameter, matching its field in SearchParameters
+	 * \return the registered parameter
+	 */
+	const TunableParameter& getTunableParameter(const std::string& name);
+
+	/**
+	 * Sets a search parameter from an assignment of the form "name=value".
+	 *
+	 * \param searchParameters the parameters being modified
+	 * \param assignment the name of the parameter and its new value
+	 */
+	void setTunableParameter(SearchParameters& searchParameters, const std::string& assignment);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "principalVariationTable.h"
+
+#include <algorithm>
+
+namespace search
+{
+	PrincipalVariationTable::PrincipalVariationTable() :
+		_lines(std::make_unique<std::array<move::Move, MAX_PLY + 1>[]>(MAX_PLY + 1))
+	{
+		for (int ply = 0; ply <= MAX_PLY; ply++)
+		{
+			_lineEnds[ply] = ply;
+		}
+	}
+
+	void PrincipalVariationTable::clear(const int ply)
+	{
+		_lineEnds[ply] = ply;
+	}
+
+	void PrincipalVariationTable::update(const int ply, const move::Move& move)
+	{
+		if (ply >= MAX_PLY)
+		{
+			return;
+		}
+
+		std::array<move::Move, MAX_PLY + 1>& line = _lines[ply];
+		const std::array<move::Move, MAX_PLY + 1>& childLine = _lines[ply + 1];
+		const int childLineEnd = std::max(_lineEnds[ply + 1], ply + 1);
+
+		line[ply] = move;
+		std::copy(childLine.begin() + ply + 1, childLine.begin() + childLineEnd, line.begin() + ply + 1);
+		_lineEnds[ply] = childLineEnd;
+	}
+
+	std::vector<move::Move> PrincipalVariationTable::getLine(const int ply) const
+	{
+		return std::vector<move::Move>(_lines[ply].begin() + ply, _lines[ply].begin() + _lineEnds[ply]);
+	}
+}
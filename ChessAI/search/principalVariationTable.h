@@ -0,0 +1,56 @@
+#pragma once
+
+#include "score.h"
+#include "../move/move.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace search
+{
+	/**
+	 * Triangular table of the best lines found by the search, indexed by distance from the root.
+	 *
+	 * The line at each ply is its best move followed by the line of the ply below, so the line at ply 0 is the
+	 * principal variation. Only nodes searched with an open window update the table, since null window searches
+	 * never produce exact scores.
+	 */
+	class PrincipalVariationTable
+	{
+	public:
+		/**
+		 * Creates a new PrincipalVariationTable with every line empty.
+		 */
+		PrincipalVariationTable();
+
+		PrincipalVariationTable(const PrincipalVariationTable& source) = delete;
+
+		/**
+		 * Empties the line of a ply; called when a node is entered.
+		 *
+		 * \param ply the distance of the node from the root
+		 */
+		void clear(const int ply);
+
+		/**
+		 * Sets the line of a ply to a move followed by the line of the ply below.
+		 *
+		 * \param ply the distance of the node from the root
+		 * \param move the new best move of the node
+		 */
+		void update(const int ply, const move::Move& move);
+
+		/**
+		 * Retrieves the line of a ply.
+		 *
+		 * \param ply the distance of the node from the root
+		 * \return the best line found from the node
+		 */
+		std::vector<move::Move> getLine(const int ply) const;
+
+	private:
+		std::unique_ptr<std::array<move::Move, MAX_PLY + 1>[]> _lines;
+		std::array<int, MAX_PLY + 1> _lineEnds; // index one past the last move of each ply's line
+	};
+}
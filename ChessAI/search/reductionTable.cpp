@@ -0,0 +1,27 @@
+#include "reductionTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace search
+{
+	ReductionTable::ReductionTable(const SearchParameters& searchParameters)
+	{
+		for (int depth = 0; depth < MAX_REDUCTION_DEPTH; depth++)
+		{
+			for (int moveIndex = 0; moveIndex < MAX_REDUCTION_MOVE_INDEX; moveIndex++)
+			{
+				// Reductions grow slowly with both depth and move index; the first move is never reduced
+				const double reduction = depth == 0 || moveIndex == 0
+					? 0.0
+					: searchParameters.lateMoveReductionBase + std::log(depth) * std::log(moveIndex) / searchParameters.lateMoveReductionDivisor;
+				_reductions[depth][moveIndex] = std::max(0, (int)reduction);
+			}
+		}
+	}
+
+	int ReductionTable::getReduction(const int depth, const int moveIndex) const
+	{
+		return _reductions[std::min(depth, MAX_REDUCTION_DEPTH - 1)][std::min(moveIndex, MAX_REDUCTION_MOVE_INDEX - 1)];
+	}
+}
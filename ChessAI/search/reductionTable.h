@@ -0,0 +1,39 @@
+#pragma once
+
+#include "searchParameters.h"
+
+#include <array>
+
+namespace search
+{
+	const int MAX_REDUCTION_DEPTH = 64; // remaining depths beyond this share the reductions of the last row
+	const int MAX_REDUCTION_MOVE_INDEX = 64; // move indices beyond this share the reductions of the last column
+
+	/**
+	 * Precomputed depth reductions for late moves, indexed by remaining depth and move index.
+	 */
+	class ReductionTable
+	{
+	public:
+		ReductionTable() = delete;
+
+		/**
+		 * Creates a new ReductionTable.
+		 *
+		 * \param searchParameters the parameters the reductions are calculated from
+		 */
+		ReductionTable(const SearchParameters& searchParameters);
+
+		/**
+		 * Retrieves the depth reduction for a move.
+		 *
+		 * \param depth the remaining depth of the node the move is searched from
+		 * \param moveIndex the index of the move in the node's move ordering
+		 * \return the number of plies the move's search is reduced by
+		 */
+		int getReduction(const int depth, const int moveIndex) const;
+
+	private:
+		std::array<std::array<int, MAX_REDUCTION_MOVE_INDEX>, MAX_REDUCTION_DEPTH> _reductions;
+	};
+}
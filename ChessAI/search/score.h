@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+namespace search
+{
+	/**
+	 * Search and evaluation score in centipawns.
+	 */
+	using Score = int32_t;
+
+	const int MAX_PLY = 128; // maximum distance from the root the search can reach
+
+	const Score SCORE_DRAW = 0;
+	const Score SCORE_MATE = 32000; // score of delivering checkmate at the root
+	const Score SCORE_INFINITE = 32001; // bound outside every reachable score
+	const Score SCORE_MATE_IN_MAX_PLY = SCORE_MATE - MAX_PLY; // scores beyond this bound are mate scores
+
+	// Every reachable score fits in 16 bits so it can be stored compactly
+	static_assert(SCORE_INFINITE <= INT16_MAX, "Scores must fit in a 16-bit integer");
+
+	/**
+	 * Get the score for delivering checkmate at the specified distance from the root.
+	 *
+	 * \param ply the number of half moves from the root
+	 * \return mate score; faster mates score higher
+	 */
+	constexpr Score mateIn(const int ply)
+	{
+		return SCORE_MATE - ply;
+	}
+
+	/**
+	 * Get the score for being checkmated at the specified distance from the root.
+	 *
+	 * \param ply the number of half moves from the root
+	 * \return mated score; slower mates score higher
+	 */
+	constexpr Score matedIn(const int ply)
+	{
+		return -SCORE_MATE + ply;
+	}
+
+	/**
+	 * Determines if a score represents a forced checkmate for either player.
+	 *
+	 * \param score the score being checked
+	 * \return true if score is a mate score, false otherwise
+	 */
+	constexpr bool isMateScore(const Score score)
+	{
+		return score >= SCORE_MATE_IN_MAX_PLY || score <= -SCORE_MATE_IN_MAX_PLY;
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace search
+{
+	/**
+	 * Caps on the work done by a single search, so the cost of a move is predictable regardless of the position.
+	 *
+	 * Each limit is only applied when set; a search stops at whichever limit it reaches first.
+	 */
+	struct SearchLimits
+	{
+		std::optional<uint64_t> maxNodes; // maximum number of nodes visited across every search thread
+		std::optional<int> maxDepth; // maximum depth of the final iteration
+		std::optional<double> moveTime; // fixed time spent on every move in nanoseconds; replaces allocating from the clock
+		bool singleThreaded = false; // searches every root move on the calling thread instead of the shared thread pool
+	};
+}
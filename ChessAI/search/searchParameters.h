@@ -0,0 +1,44 @@
+#pragma once
+
+#include "score.h"
+#include <cstddef>
+
+namespace search
+{
+	/**
+	 * Parameters controlling how selectively the search explores the game tree.
+	 */
+	struct SearchParameters
+	{
+		bool principalVariationSearch = true;
+
+		bool aspirationWindows = true;
+		int aspirationMinDepth = 3; // minimum depth at which the root is searched with a window around the previous score
+		Score aspirationWindow = 50; // initial distance of the window bounds from the previous score; doubled on failure
+
+		bool nullMovePruning = true;
+		int nullMoveMinDepth = 2; // minimum remaining depth at which the turn may be passed
+		int nullMoveReduction = 2; // depth reduction applied to the search after passing the turn
+		int nullMoveDeepReduction = 3; // depth reduction applied from nullMoveDeepDepth onwards
+		int nullMoveDeepDepth = 6;
+		int nullMoveVerificationDepth = 6; // minimum remaining depth at which null move cutoffs are verified
+
+		bool lateMoveReductions = true;
+		int lateMoveMinDepth = 3; // minimum remaining depth at which late moves are reduced
+		int lateMoveMinIndex = 3; // number of moves searched at full depth before reducing
+		double lateMoveReductionBase = 0.75;
+		double lateMoveReductionDivisor = 2.25;
+
+		bool futilityPruning = true;
+		int futilityMaxDepth = 2; // maximum remaining depth at which quiet moves may be skipped
+		Score futilityMargin = 150; // margin added to the static evaluation per remaining ply
+
+		bool reverseFutilityPruning = true;
+		int reverseFutilityMaxDepth = 3; // maximum remaining depth at which a node may be cut from its static evaluation
+		Score reverseFutilityMargin = 120; // margin subtracted from the static evaluation per remaining ply
+
+		size_t transpositionTableSize = 16; // size of the transposition table in megabytes
+		size_t pawnHashTableSize = 2; // size of the pawn hash table in megabytes
+		size_t evaluationCacheSize = 4; // size of the static evaluation cache in megabytes
+	};
+}
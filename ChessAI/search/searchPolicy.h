@@ -0,0 +1,21 @@
+#pragma once
+
+#include "score.h"
+#include "../constants.h"
+
+#include <cstdint>
+
+namespace search
+{
+	/**
+	 * Search constants an agent is compiled against, alongside its evaluation policy.
+	 *
+	 * Unlike SearchParameters, which may be changed for every agent at runtime, these are fixed per instantiation so
+	 * the search can fold them into the code.
+	 */
+	struct DefaultSearchPolicy
+	{
+		static constexpr Score CAPTURE_ORDER_VALUES[PIECE_TYPE_COUNT] = { 100, 200, 200, 300, 500, 0 }; // used to order captures
+		static constexpr uint64_t STOP_POLL_INTERVAL = 1024; // number of nodes visited between checks of the hard time limit
+	};
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "searchStatistics.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace search
+{
+	/**
+	 * Divides two counters, treating an empty denominator as a rate of 0.
+	 *
+	 * \param numerator the counter being measured
+	 * \param denominator the counter it is measured against
+	 * \return numerator / denominator, 0 if denominator is 0
+	 */
+	double getRate(const uint64_t numerator, const uint64_t denominator)
+	{
+		return denominator == 0 ? 0.0 : (double)numerator / (double)denominator;
+	}
+
+	SearchStatistics& SearchStatistics::operator+=(const SearchStatistics& rightOperand)
+	{
+		nodeCount += rightOperand.nodeCount;
+		quiescenceNodeCount += rightOperand.quiescenceNodeCount;
+		betaCutoffCount += rightOperand.betaCutoffCount;
+		firstMoveBetaCutoffCount += rightOperand.firstMoveBetaCutoffCount;
+		transpositionProbeCount += rightOperand.transpositionProbeCount;
+		transpositionHitCount += rightOperand.transpositionHitCount;
+		pawnHashProbeCount += rightOperand.pawnHashProbeCount;
+		pawnHashHitCount += rightOperand.pawnHashHitCount;
+		evaluationCacheProbeCount += rightOperand.evaluationCacheProbeCount;
+		evaluationCacheHitCount += rightOperand.evaluationCacheHitCount;
+		depth = std::max(depth, rightOperand.depth);
+		selectiveDepth = std::max(selectiveDepth, rightOperand.selectiveDepth);
+		elapsedTime = std::max(elapsedTime, rightOperand.elapsedTime);
+
+		return *this;
+	}
+
+	double SearchStatistics::getNodesPerSecond() const
+	{
+		return elapsedTime <= 0.0 ? 0.0 : nodeCount / (elapsedTime / 1000000000.0);
+	}
+
+	double SearchStatistics::getBetaCutoffRate() const
+	{
+		return getRate(betaCutoffCount, nodeCount - quiescenceNodeCount);
+	}
+
+	double SearchStatistics::getFirstMoveBetaCutoffRate() const
+	{
+		return getRate(firstMoveBetaCutoffCount, betaCutoffCount);
+	}
+
+	double SearchStatistics::getTranspositionHitRate() const
+	{
+		return getRate(transpositionHitCount, transpositionProbeCount);
+	}
+
+	double SearchStatistics::getPawnHashHitRate() const
+	{
+		return getRate(pawnHashHitCount, pawnHashProbeCount);
+	}
+
+	double SearchStatistics::getEvaluationCacheHitRate() const
+	{
+		return getRate(evaluationCacheHitCount, evaluationCacheProbeCount);
+	}
+
+	double SearchStatistics::getQuiescenceNodeRate() const
+	{
+		return getRate(quiescenceNodeCount, nodeCount);
+	}
+
+	std::ostream& operator<<(std::ostream& out, const SearchStatistics& statistics)
+	{
+		const std::ios_base::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+
+		out << std::fixed << std::setprecision(1)
+			<< "depth " << statistics.depth
+			<< " seldepth " << statistics.selectiveDepth
+			<< " nodes " << statistics.nodeCount
+			<< " nps " << (uint64_t)statistics.getNodesPerSecond()
+			<< " time " << statistics.elapsedTime / 1000000.0 << "ms"
+			<< " cutoffs " << statistics.getBetaCutoffRate() * 100.0 << "%"
+			<< " first-move-cutoffs " << statistics.getFirstMoveBetaCutoffRate() * 100.0 << "%"
+			<< " tt-hits " << statistics.getTranspositionHitRate() * 100.0 << "%"
+			<< " pawn-hash-hits " << statistics.getPawnHashHitRate() * 100.0 << "%"
+			<< " eval-cache-hits " << statistics.getEvaluationCacheHitRate() * 100.0 << "%"
+			<< " qnodes " << statistics.getQuiescenceNodeRate() * 100.0 << "%";
+
+		out.flags(flags);
+		out.precision(precision);
+		return out;
+	}
+}
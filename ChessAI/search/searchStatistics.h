@@ -0,0 +1,99 @@
+#pragma once
+
+#include "score.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace search
+{
+	const size_t CACHE_LINE_SIZE = 64;
+
+	/**
+	 * Counters describing the work done by a search.
+	 */
+	struct SearchStatistics
+	{
+		uint64_t nodeCount = 0; // game states visited, including quiescence nodes
+		uint64_t quiescenceNodeCount = 0;
+		uint64_t betaCutoffCount = 0; // full width nodes where a move failed high
+		uint64_t firstMoveBetaCutoffCount = 0; // full width nodes where the first move searched failed high
+		uint64_t transpositionProbeCount = 0;
+		uint64_t transpositionHitCount = 0;
+		uint64_t pawnHashProbeCount = 0;
+		uint64_t pawnHashHitCount = 0;
+		uint64_t evaluationCacheProbeCount = 0;
+		uint64_t evaluationCacheHitCount = 0;
+		int depth = 0; // depth of the deepest completed iteration
+		Score score = SCORE_DRAW; // score of the best move of the deepest completed iteration for the searching player; not added by operator+=
+		int selectiveDepth = 0; // greatest distance from the root reached
+		double elapsedTime = 0.0; // nanoseconds
+
+		/**
+		 * Adds the counters of another search to this one.
+		 *
+		 * \param rightOperand the statistics being added
+		 * \return reference to the calling object
+		 */
+		SearchStatistics& operator+=(const SearchStatistics& rightOperand);
+
+		/**
+		 * Get the number of nodes visited per second.
+		 *
+		 * \return nodes per second, 0 if no time has elapsed
+		 */
+		double getNodesPerSecond() const;
+
+		/**
+		 * Get the fraction of full width nodes that failed high.
+		 *
+		 * \return the beta cutoff rate in [0, 1]
+		 */
+		double getBetaCutoffRate() const;
+
+		/**
+		 * Get the fraction of beta cutoffs caused by the first move searched; a measure of move ordering quality.
+		 *
+		 * \return the first move beta cutoff rate in [0, 1]
+		 */
+		double getFirstMoveBetaCutoffRate() const;
+
+		/**
+		 * Get the fraction of transposition table probes that found an entry.
+		 *
+		 * \return the transposition table hit rate in [0, 1]
+		 */
+		double getTranspositionHitRate() const;
+
+		/**
+		 * Get the fraction of pawn hash table probes that found the pawn structure.
+		 *
+		 * \return the pawn hash table hit rate in [0, 1]
+		 */
+		double getPawnHashHitRate() const;
+
+		/**
+		 * Get the fraction of static evaluations found in the evaluation cache.
+		 *
+		 * \return the evaluation cache hit rate in [0, 1]
+		 */
+		double getEvaluationCacheHitRate() const;
+
+		/**
+		 * Get the fraction of nodes visited by the quiescence search.
+		 *
+		 * \return the quiescence node rate in [0, 1]
+		 */
+		double getQuiescenceNodeRate() const;
+	};
+	std::ostream& operator<<(std::ostream& out, const SearchStatistics& statistics);
+
+	/**
+	 * Search statistics written by a single search thread, padded to a cache line so threads never share one.
+	 */
+	struct alignas(CACHE_LINE_SIZE) ThreadSearchStatistics
+	{
+		SearchStatistics statistics;
+	};
+}
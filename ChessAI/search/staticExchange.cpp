@@ -0,0 +1,132 @@
+#include "staticExchange.h"
+
+#include "../move/moveLookupTable.h"
+#include "../util/bitboard/bitboardSet.h"
+#include "../util/bitboard/bitboardUtil.h"
+#include "../util/utility.h"
+
+#include <algorithm>
+#include <bit>
+
+using namespace util;
+using util::bitboard::BitboardSet;
+using util::bitboard::shiftBitboard;
+using util::bitboard::up;
+using util::bitboard::down;
+using util::bitboard::left;
+using util::bitboard::right;
+
+namespace search
+{
+	// Coarse material values used to rank exchanges; the king outweighs any exchange so it never recaptures into an attack
+	const Score EXCHANGE_VALUES[PIECE_TYPE_COUNT] = { 100, 200, 200, 300, 500, SCORE_MATE };
+	const int MAX_EXCHANGE_LENGTH = 32;
+
+	/**
+	 * Get the bitboard of every piece of either color attacking a position.
+	 *
+	 * \param board the board containing the pieces
+	 * \param positionIndex the index of the attacked position
+	 * \param occupancyBoard the pieces still on the board; sliding attacks are blocked by these
+	 * \return bitboard representation of the attackers
+	 */
+	Bitboard getAttackers(const BitboardSet& board, const int positionIndex, const Bitboard occupancyBoard)
+	{
+		const Bitboard positionBoard = 1ULL << positionIndex;
+		const Bitboard bishops = board.getBitboard(Color::WHITE, PieceType::BISHOP) | board.getBitboard(Color::BLACK, PieceType::BISHOP);
+		const Bitboard rooks = board.getBitboard(Color::WHITE, PieceType::ROOK) | board.getBitboard(Color::BLACK, PieceType::ROOK);
+		const Bitboard queens = board.getBitboard(Color::WHITE, PieceType::QUEEN) | board.getBitboard(Color::BLACK, PieceType::QUEEN);
+		const Bitboard knights = board.getBitboard(Color::WHITE, PieceType::KNIGHT) | board.getBitboard(Color::BLACK, PieceType::KNIGHT);
+		const Bitboard kings = board.getBitboard(Color::WHITE, PieceType::KING) | board.getBitboard(Color::BLACK, PieceType::KING);
+
+		// White pawns move up the board, so they attack from the rank below the position
+		const Bitboard whitePawnAttackers = (shiftBitboard(positionBoard, down(1) + left(1)) | shiftBitboard(positionBoard, down(1) + right(1)))
+			& board.getBitboard(Color::WHITE, PieceType::PAWN);
+		const Bitboard blackPawnAttackers = (shiftBitboard(positionBoard, up(1) + left(1)) | shiftBitboard(positionBoard, up(1) + right(1)))
+			& board.getBitboard(Color::BLACK, PieceType::PAWN);
+
+		const Bitboard result = whitePawnAttackers
+			| blackPawnAttackers
+			| (move::getKnightMoveBoard(positionIndex) & knights)
+			| (move::getKingMoveBoard(positionIndex) & kings)
+			| (move::getBishopMoveBoard(positionIndex, occupancyBoard) & (bishops | queens))
+			| (move::getRookMoveBoard(positionIndex, occupancyBoard) & (rooks | queens));
+
+		return result & occupancyBoard;
+	}
+
+	Score getStaticExchangeValue(const ChessState& chessState, const Color player, const move::Move& move)
+	{
+		const BitboardSet& board = chessState.getBoard();
+		const int sourceIndex = move.source.y * FILE_COUNT + move.source.x;
+		const int destinationIndex = move.destination.y * FILE_COUNT + move.destination.x;
+		PieceType attackerType = board.getPieceType(move.source, player);
+		PieceType capturedType = board.getPieceType(move.destination, ~player);
+		Bitboard occupancyBoard = board.getOccupancyBoard();
+
+		// A pawn moving diagonally onto an empty position captures en passant
+		if (capturedType == PieceType::NONE && attackerType == PieceType::PAWN && move.source.x != move.destination.x)
+		{
+			capturedType = PieceType::PAWN;
+			occupancyBoard ^= 1ULL << (move.source.y * FILE_COUNT + move.destination.x);
+		}
+
+		Score gains[MAX_EXCHANGE_LENGTH];
+		int exchangeLength = 0;
+		gains[0] = capturedType == PieceType::NONE ? 0 : EXCHANGE_VALUES[capturedType];
+
+		const bool isPromotion = attackerType == PieceType::PAWN && (move.destination.y == 0 || move.destination.y == RANK_COUNT - 1);
+		if (isPromotion)
+		{
+			gains[0] += EXCHANGE_VALUES[PieceType::QUEEN] - EXCHANGE_VALUES[PieceType::PAWN];
+			attackerType = PieceType::QUEEN;
+		}
+
+		const Bitboard diagonalSliders = board.getBitboard(Color::WHITE, PieceType::BISHOP) | board.getBitboard(Color::BLACK, PieceType::BISHOP)
+			| board.getBitboard(Color::WHITE, PieceType::QUEEN) | board.getBitboard(Color::BLACK, PieceType::QUEEN);
+		const Bitboard straightSliders = board.getBitboard(Color::WHITE, PieceType::ROOK) | board.getBitboard(Color::BLACK, PieceType::ROOK)
+			| board.getBitboard(Color::WHITE, PieceType::QUEEN) | board.getBitboard(Color::BLACK, PieceType::QUEEN);
+
+		Bitboard attackerBoard = 1ULL << sourceIndex;
+		Bitboard attackers = getAttackers(board, destinationIndex, occupancyBoard);
+		Color side = player;
+
+		do
+		{
+			exchangeLength++;
+			side = ~side;
+
+			// Score of the exchange if the side to move recaptures the piece that was just moved onto the destination
+			gains[exchangeLength] = EXCHANGE_VALUES[attackerType] - gains[exchangeLength - 1];
+			if (std::max(-gains[exchangeLength - 1], gains[exchangeLength]) < 0)
+			{
+				break;
+			}
+
+			// Removing the previous attacker may reveal sliding pieces behind it
+			occupancyBoard ^= attackerBoard;
+			attackers |= (move::getBishopMoveBoard(destinationIndex, occupancyBoard) & diagonalSliders)
+				| (move::getRookMoveBoard(destinationIndex, occupancyBoard) & straightSliders);
+			attackers &= occupancyBoard;
+
+			attackerBoard = 0;
+			for (int i = PieceType::PAWN; i <= PieceType::KING && !attackerBoard; i++)
+			{
+				const Bitboard pieceAttackers = attackers & board.getBitboard(side, (PieceType)i);
+				if (pieceAttackers)
+				{
+					attackerBoard = 1ULL << std::countr_zero(pieceAttackers);
+					attackerType = (PieceType)i;
+				}
+			}
+		} while (attackerBoard && exchangeLength < MAX_EXCHANGE_LENGTH - 1);
+
+		// Each side only continues the exchange while doing so is better than stopping
+		while (--exchangeLength)
+		{
+			gains[exchangeLength - 1] = -std::max(-gains[exchangeLength - 1], gains[exchangeLength]);
+		}
+
+		return gains[0];
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "score.h"
+#include "../chess.h"
+#include "../move/move.h"
+
+namespace search
+{
+	/**
+	 * Estimates the material a move wins once every profitable recapture on its destination has been made.
+	 *
+	 * Each player recaptures with their least valuable attacker and may stop whenever continuing would lose material.
+	 * Sliding pieces behind a capturing piece join the exchange as it is removed from the board.
+	 *
+	 * \param chessState game state
+	 * \param player the player making the move
+	 * \param move the move being evaluated
+	 * \return the expected material gain of the move in centipawns; negative if the move loses material
+	 */
+	Score getStaticExchangeValue(const ChessState& chessState, const Color player, const move::Move& move);
+}
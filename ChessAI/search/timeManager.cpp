@@ -0,0 +1,84 @@
+#include "timeManager.h"
+
+#include <algorithm>
+
+namespace search
+{
+	const int MIN_MOVES_TO_GO = 20; // the game is always assumed to last at least this many more moves
+	const int EXPECTED_GAME_LENGTH = 50; // number of full turns the remaining moves are estimated from
+	const double HARD_LIMIT_SCALE = 5.0; // hard limit as a multiple of the base time
+	const double MAX_HARD_LIMIT_FRACTION = 0.2; // hard limit never exceeds this fraction of the remaining time
+	const Score SCORE_DROP_MARGIN = 30; // score drop between iterations that warrants extra time
+
+	TimeManager::TimeManager(const double timeRemaining, const int fullTurnCount, const std::chrono::steady_clock::time_point& startTime) :
+		_startTime(startTime),
+		_bestValue(SCORE_DRAW),
+		_stableIterationCount(0),
+		_isFixed(false)
+	{
+		const int movesToGo = std::max(MIN_MOVES_TO_GO, EXPECTED_GAME_LENGTH - fullTurnCount);
+		_baseTime = std::max(timeRemaining, 0.0) / movesToGo;
+		_hardLimit = std::min(_baseTime * HARD_LIMIT_SCALE, std::max(timeRemaining, 0.0) * MAX_HARD_LIMIT_FRACTION);
+		_softLimit = std::min(_baseTime, _hardLimit);
+	}
+
+	TimeManager::TimeManager(const double moveTime, const std::chrono::steady_clock::time_point& startTime) :
+		_startTime(startTime),
+		_baseTime(std::max(moveTime, 0.0)),
+		_softLimit(_baseTime),
+		_hardLimit(_baseTime),
+		_bestValue(SCORE_DRAW),
+		_stableIterationCount(0),
+		_isFixed(true)
+	{
+	}
+
+	void TimeManager::completeIteration(const move::Move& bestMove, const Score value)
+	{
+		const bool bestMoveChanged = _bestMove.has_value() && _bestMove.value() != bestMove;
+		const bool scoreDropped = _bestMove.has_value() && value < _bestValue - SCORE_DROP_MARGIN;
+		_stableIterationCount = bestMoveChanged ? 0 : _stableIterationCount + 1;
+
+		// A best move that keeps changing needs more time to settle, while a stable one is unlikely to change
+		double scale = 1.0;
+		if (bestMoveChanged)
+		{
+			scale = 1.5;
+		}
+		else if (_stableIterationCount >= 4)
+		{
+			scale = 0.5;
+		}
+		else if (_stableIterationCount >= 2)
+		{
+			scale = 0.75;
+		}
+
+		if (scoreDropped)
+		{
+			scale *= 1.5;
+		}
+
+		if (!_isFixed)
+		{
+			_softLimit = std::min(_baseTime * scale, _hardLimit);
+		}
+		_bestMove = bestMove;
+		_bestValue = value;
+	}
+
+	bool TimeManager::isSoftLimitReached() const
+	{
+		return getElapsedTime() >= _softLimit;
+	}
+
+	bool TimeManager::isHardLimitReached() const
+	{
+		return getElapsedTime() >= _hardLimit;
+	}
+
+	double TimeManager::getElapsedTime() const
+	{
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _startTime).count();
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "score.h"
+#include "../move/move.h"
+
+#include <chrono>
+#include <optional>
+
+namespace search
+{
+	/**
+	 * Allocates a player's remaining time to a single move.
+	 *
+	 * Iterations are only started before the soft limit, which shrinks while the best move is stable and grows when
+	 * it changes or the score drops. The hard limit is the point at which a running search must be aborted.
+	 */
+	class TimeManager
+	{
+	public:
+		TimeManager() = delete;
+
+		/**
+		 * Creates a new TimeManager and starts timing the move.
+		 *
+		 * \param timeRemaining the time remaining on the player's clock in nanoseconds
+		 * \param fullTurnCount the number of full turns played; used to estimate the number of moves left in the game
+		 * \param startTime the time the search for the move started; earlier than now when the search began while pondering
+		 */
+		TimeManager(const double timeRemaining, const int fullTurnCount, const std::chrono::steady_clock::time_point& startTime = std::chrono::steady_clock::now());
+
+		/**
+		 * Creates a new TimeManager that spends a fixed time on the move and starts timing the move.
+		 *
+		 * Both limits are the move time, so iterations keep starting until it runs out.
+		 *
+		 * \param moveTime the time to spend on the move in nanoseconds
+		 * \param startTime the time the search for the move started; earlier than now when the search began while pondering
+		 */
+		TimeManager(const double moveTime, const std::chrono::steady_clock::time_point& startTime = std::chrono::steady_clock::now());
+
+		/**
+		 * Adjusts the soft limit based on the result of a completed iteration.
+		 *
+		 * \param bestMove the best move found by the iteration
+		 * \param value the score of the best move
+		 */
+		void completeIteration(const move::Move& bestMove, const Score value);
+
+		/**
+		 * Determines if another iteration should be started.
+		 *
+		 * \return true if the soft limit has been reached, false otherwise
+		 */
+		bool isSoftLimitReached() const;
+
+		/**
+		 * Determines if the search must be aborted.
+		 *
+		 * \return true if the hard limit has been reached, false otherwise
+		 */
+		bool isHardLimitReached() const;
+
+		/**
+		 * Get the time spent on the move so far.
+		 *
+		 * \return the elapsed time in nanoseconds
+		 */
+		double getElapsedTime() const;
+
+	private:
+		std::chrono::steady_clock::time_point _startTime;
+		double _baseTime, // time allocated to the move before adjustments
+			_softLimit,
+			_hardLimit;
+		std::optional<move::Move> _bestMove;
+		Score _bestValue;
+		int _stableIterationCount; // number of consecutive iterations without a change in best move
+		bool _isFixed; // whether the soft limit stays at the move time instead of adapting to the search
+	};
+}
@@ -0,0 +1,167 @@
+#include "transpositionTable.h"
+
+#include "../constants.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace search
+{
+	// Layout of an entry's data: move (12 bits), score (16 bits), depth (8 bits), bound (2 bits), generation (8 bits)
+	const int MOVE_SHIFT = 0, VALUE_SHIFT = 16, DEPTH_SHIFT = 32, BOUND_SHIFT = 40, GENERATION_SHIFT = 42;
+	const uint64_t NO_MOVE = 0; // a move from and to the same position cannot occur, so a zero move marks its absence
+
+	/**
+	 * Converts a score relative to the root into a score relative to the game state being stored,
+	 * so a mate score stays correct when the game state is reached at a different distance from the root.
+	 *
+	 * \param value score relative to the root
+	 * \param ply the distance of the game state from the root
+	 * \return score relative to the game state
+	 */
+	Score toStoredValue(const Score value, const int ply)
+	{
+		if (value >= SCORE_MATE_IN_MAX_PLY)
+		{
+			return value + ply;
+		}
+		else if (value <= -SCORE_MATE_IN_MAX_PLY)
+		{
+			return value - ply;
+		}
+		return value;
+	}
+
+	/**
+	 * Converts a score relative to a stored game state back into a score relative to the root.
+	 *
+	 * \param value score relative to the game state
+	 * \param ply the distance of the game state from the root
+	 * \return score relative to the root
+	 */
+	Score fromStoredValue(const Score value, const int ply)
+	{
+		if (value >= SCORE_MATE_IN_MAX_PLY)
+		{
+			return value - ply;
+		}
+		else if (value <= -SCORE_MATE_IN_MAX_PLY)
+		{
+			return value + ply;
+		}
+		return value;
+	}
+
+	/**
+	 * Packs a move into the 12 bits reserved for it in an entry.
+	 *
+	 * \param move the move being packed
+	 * \return the packed move, NO_MOVE if there is no move
+	 */
+	uint64_t encodeMove(const std::optional<move::Move>& move)
+	{
+		if (!move.has_value())
+		{
+			return NO_MOVE;
+		}
+
+		const int sourceIndex = move->source.y * FILE_COUNT + move->source.x;
+		const int destinationIndex = move->destination.y * FILE_COUNT + move->destination.x;
+		return (uint64_t)sourceIndex | ((uint64_t)destinationIndex << 6);
+	}
+
+	/**
+	 * Unpacks a move packed by encodeMove().
+	 *
+	 * \param encodedMove the packed move
+	 * \return the unpacked move, std::nullopt if there is no move
+	 */
+	std::optional<move::Move> decodeMove(const uint64_t encodedMove)
+	{
+		if (encodedMove == NO_MOVE)
+		{
+			return std::nullopt;
+		}
+
+		const int sourceIndex = encodedMove & 0x3F;
+		const int destinationIndex = (encodedMove >> 6) & 0x3F;
+		return move::Move(
+			util::Position(sourceIndex % FILE_COUNT, sourceIndex / FILE_COUNT),
+			util::Position(destinationIndex % FILE_COUNT, destinationIndex / FILE_COUNT)
+		);
+	}
+
+	TranspositionTable::TranspositionTable(const size_t sizeInMegabytes) :
+		_slotCount(std::bit_floor(std::max<size_t>(sizeInMegabytes * 1024 * 1024 / sizeof(Slot), 1))),
+		_slots(std::make_unique<Slot[]>(_slotCount)),
+		_generation(0)
+	{
+		clear();
+	}
+
+	std::optional<TranspositionEntry> TranspositionTable::probe(const uint64_t key, const int ply) const
+	{
+		const Slot& slot = _slots[key & (_slotCount - 1)];
+		const uint64_t data = slot.data.load(std::memory_order_relaxed);
+		const uint64_t checksum = slot.checksum.load(std::memory_order_relaxed);
+
+		if ((checksum ^ data) != key || data == 0)
+		{
+			return std::nullopt;
+		}
+
+		TranspositionEntry result;
+		result.move = decodeMove((data >> MOVE_SHIFT) & 0xFFF);
+		result.value = fromStoredValue((int16_t)((data >> VALUE_SHIFT) & 0xFFFF), ply);
+		result.depth = (int)((data >> DEPTH_SHIFT) & 0xFF);
+		result.bound = (Bound)((data >> BOUND_SHIFT) & 0x3);
+
+		return result;
+	}
+
+	void TranspositionTable::store(const uint64_t key, const int ply, const std::optional<move::Move>& move, const Score value, const int depth, const Bound bound)
+	{
+		Slot& slot = _slots[key & (_slotCount - 1)];
+		const uint64_t existingData = slot.data.load(std::memory_order_relaxed);
+		const bool isSameGameState = (slot.checksum.load(std::memory_order_relaxed) ^ existingData) == key;
+		const uint8_t generation = _generation.load(std::memory_order_relaxed);
+
+		// Deeper results from the current search are kept over shallower ones, but anything from an older search is replaced
+		const int existingDepth = (int)((existingData >> DEPTH_SHIFT) & 0xFF);
+		const uint8_t existingGeneration = (uint8_t)((existingData >> GENERATION_SHIFT) & 0xFF);
+		if (existingData != 0 && existingGeneration == generation && !isSameGameState && depth < existingDepth && bound != Bound::EXACT)
+		{
+			return;
+		}
+
+		// A result without a move should not erase the move previously found for the same game state
+		uint64_t encodedMove = encodeMove(move);
+		if (encodedMove == NO_MOVE && isSameGameState)
+		{
+			encodedMove = (existingData >> MOVE_SHIFT) & 0xFFF;
+		}
+
+		const uint64_t data = (encodedMove << MOVE_SHIFT)
+			| ((uint64_t)(uint16_t)(int16_t)toStoredValue(value, ply) << VALUE_SHIFT)
+			| ((uint64_t)(uint8_t)std::max(depth, 0) << DEPTH_SHIFT)
+			| ((uint64_t)bound << BOUND_SHIFT)
+			| ((uint64_t)generation << GENERATION_SHIFT);
+
+		slot.checksum.store(key ^ data, std::memory_order_relaxed);
+		slot.data.store(data, std::memory_order_relaxed);
+	}
+
+	void TranspositionTable::incrementGeneration()
+	{
+		_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void TranspositionTable::clear()
+	{
+		for (size_t i = 0; i < _slotCount; i++)
+		{
+			_slots[i].checksum.store(0, std::memory_order_relaxed);
+			_slots[i].data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
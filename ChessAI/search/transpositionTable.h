@@ -0,0 +1,95 @@
+#pragma once
+
+#include "score.h"
+#include "../move/move.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace search
+{
+	/**
+	 * Indicates how a stored score relates to the true score of a game state.
+	 */
+	enum Bound
+	{
+		UPPER = 0, // the search failed low; the true score is at most the stored score
+		LOWER = 1, // the search failed high; the true score is at least the stored score
+		EXACT = 2
+	};
+
+	/**
+	 * Result of a previous search of a game state.
+	 */
+	struct TranspositionEntry
+	{
+		std::optional<move::Move> move;
+		Score value;
+		int depth;
+		Bound bound;
+	};
+
+	/**
+	 * Fixed-size hash table of search results, shared by every thread searching for an agent.
+	 *
+	 * Entries are stored without locks: each slot holds its data alongside the key XORed with that data,
+	 * so a slot torn by concurrent writes fails verification and reads as a miss.
+	 */
+	class TranspositionTable
+	{
+	public:
+		TranspositionTable() = delete;
+		TranspositionTable(const TranspositionTable& source) = delete;
+
+		/**
+		 * Creates a new TranspositionTable.
+		 *
+		 * \param sizeInMegabytes the memory used by the table; rounded down to a power of two number of entries
+		 */
+		TranspositionTable(const size_t sizeInMegabytes);
+
+		/**
+		 * Retrieves the stored result for a game state.
+		 *
+		 * \param key the Zobrist key of the game state
+		 * \param ply the distance of the game state from the root; used to adjust mate scores
+		 * \return the stored result, std::nullopt if the game state has no stored result
+		 */
+		std::optional<TranspositionEntry> probe(const uint64_t key, const int ply) const;
+
+		/**
+		 * Stores the result of searching a game state, replacing the existing entry in its slot if it is less valuable.
+		 *
+		 * \param key the Zobrist key of the game state
+		 * \param ply the distance of the game state from the root; used to adjust mate scores
+		 * \param move the best move found, if any
+		 * \param value the score found by the search
+		 * \param depth the remaining depth the game state was searched to
+		 * \param bound how value relates to the true score of the game state
+		 */
+		void store(const uint64_t key, const int ply, const std::optional<move::Move>& move, const Score value, const int depth, const Bound bound);
+
+		/**
+		 * Marks the start of a new search so entries from previous searches are replaced first.
+		 */
+		void incrementGeneration();
+
+		/**
+		 * Removes every entry.
+		 */
+		void clear();
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> checksum; // key XOR data
+			std::atomic<uint64_t> data;
+		};
+
+		size_t _slotCount;
+		std::unique_ptr<Slot[]> _slots;
+		std::atomic<uint8_t> _generation;
+	};
+}
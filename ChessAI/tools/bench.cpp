@@ -0,0 +1,402 @@
+#include "bench.h"
+
+#include "../agent.h"
+#include "../chess.h"
+#include "../move/moveLookupTable.h"
+#include "../move/moveUtil.h"
+#include "../search/searchParameters.h"
+#include "../search/parameterRegistry.h"
+#include "../search/searchStatistics.h"
+#include "../evaluation/evaluation.h"
+#include "../evaluation/network.h"
+#include "../evaluation/attackEvaluation.h"
+#include "../evaluation/evaluators.h"
+#include "../util/utility.h"
+#include "../util/fen.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace tools
+{
+	const int DEFAULT_BENCH_DEPTH = 4;
+	const int EVALUATION_BENCH_ITERATIONS = 1000000;
+	const int NETWORK_BENCH_ITERATIONS = 200000;
+	const int ATTACK_BENCH_ITERATIONS = 1000000;
+	const int MOVE_GENERATION_BENCH_ITERATIONS = 2000;
+	const int FEN_BENCH_ITERATIONS = 200000;
+	const uint32_t NETWORK_BENCH_SEED = 1;
+
+	// Openings, middlegames and endgames with tactics, castling, en passant and promotions available
+	const std::vector<std::string> BENCH_POSITIONS = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+		"r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10",
+		"r1bq1rk1/ppp2ppp/2np1n2/2b1p3/2B1P3/2NP1N2/PPP2PPP/R1BQ1RK1 w - - 0 7",
+		"rnbqkb1r/pp3ppp/4pn2/2pp4/3P4/2P1PN2/PP3PPP/RNBQKB1R b KQkq - 0 5",
+		"2r3k1/5ppp/p3p3/1p1nP3/3P4/1B3N2/PP3PPP/2R3K1 b - - 0 25",
+		"6k1/5p2/6p1/8/7p/8/6PP/6K1 b - - 0 1",
+		"8/8/4k3/3pP3/3K4/8/8/8 w - d6 0 1",
+		"8/P5k1/8/8/8/8/5K2/8 w - - 0 1",
+		"4r1k1/pp3ppp/8/3q4/8/1P3Q2/P4PPP/4R1K1 w - - 0 30",
+	};
+
+	/**
+	 * Times the incrementally maintained evaluation against recalculating it from every piece on the board, and the
+	 * sweep over every piece's attacks.
+	 *
+	 * \return process exit code
+	 */
+	int runEvaluationBenchmark()
+	{
+		double totalIncrementalNanoseconds = 0.0, totalRecalculatedNanoseconds = 0.0, totalAttackNanoseconds = 0.0;
+		volatile search::Score sink = 0; // keeps the evaluations from being optimized away
+
+		move::populateLookupTables();
+
+		for (const std::string& fen : BENCH_POSITIONS)
+		{
+			const ChessState chessState(fen);
+			const util::bitboard::BitboardSet& board = chessState.getBoard();
+			const Color player = chessState.getNextTurn();
+
+			if (evaluation::getPieceSquareValue(board, player) != evaluation::calculatePieceSquareValue(board, player))
+			{
+				std::cout << "Incremental evaluation does not match recalculated evaluation: " << fen << std::endl;
+				return 1;
+			}
+
+			auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < EVALUATION_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + evaluation::getPieceSquareValue(board, (Color)(i & 1));
+			}
+			const double incrementalNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / EVALUATION_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < EVALUATION_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + evaluation::calculatePieceSquareValue(board, (Color)(i & 1));
+			}
+			const double recalculatedNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / EVALUATION_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < EVALUATION_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + evaluation::calculateAttackEvaluation(board).middlegameScore;
+			}
+			const double attackNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / EVALUATION_BENCH_ITERATIONS;
+
+			totalIncrementalNanoseconds += incrementalNanoseconds;
+			totalRecalculatedNanoseconds += recalculatedNanoseconds;
+			totalAttackNanoseconds += attackNanoseconds;
+
+			std::cout << std::left << std::setw(72) << fen
+				<< "incremental " << std::fixed << std::setprecision(1) << incrementalNanoseconds << "ns"
+				<< "  recalculated " << recalculatedNanoseconds << "ns"
+				<< "  attacks " << attackNanoseconds << "ns" << std::endl;
+		}
+
+		const double positionCount = (double)BENCH_POSITIONS.size();
+		std::cout << "Incremental: " << std::fixed << std::setprecision(1) << totalIncrementalNanoseconds / positionCount << "ns/eval" << std::endl;
+		std::cout << "Recalculated: " << totalRecalculatedNanoseconds / positionCount << "ns/eval" << std::endl;
+		std::cout << "Attacks: " << totalAttackNanoseconds / positionCount << "ns/eval" << std::endl;
+
+		return 0;
+	}
+
+	/**
+	 * Times the evaluation network's inference and the recalculation of its accumulators.
+	 *
+	 * Uses the network loaded with --network, or random weights if none was loaded.
+	 *
+	 * \return process exit code
+	 */
+	int runNetworkBenchmark()
+	{
+		if (evaluation::getNetwork() == nullptr)
+		{
+			std::unique_ptr<evaluation::Network> network = std::make_unique<evaluation::Network>();
+			network->randomize(NETWORK_BENCH_SEED);
+			evaluation::setNetwork(std::move(network));
+			std::cout << "No network loaded; using random weights" << std::endl;
+		}
+		const evaluation::Network& network = *evaluation::getNetwork();
+
+		double totalSimdNanoseconds = 0.0, totalScalarNanoseconds = 0.0, totalRefreshNanoseconds = 0.0;
+		volatile search::Score sink = 0; // keeps the evaluations from being optimized away
+
+		for (const std::string& fen : BENCH_POSITIONS)
+		{
+			ChessState chessState(fen);
+			evaluation::Accumulator accumulator;
+			network.refreshAccumulator(accumulator, chessState.getBoard(), Color::WHITE);
+			network.refreshAccumulator(accumulator, chessState.getBoard(), Color::BLACK);
+
+			auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < NETWORK_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + network.getValue(accumulator, (Color)(i & 1));
+			}
+			const double simdNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / NETWORK_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < NETWORK_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + network.getValueScalar(accumulator, (Color)(i & 1));
+			}
+			const double scalarNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / NETWORK_BENCH_ITERATIONS;
+
+			evaluation::Accumulator refreshedAccumulator;
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < NETWORK_BENCH_ITERATIONS; i++)
+			{
+				network.refreshAccumulator(refreshedAccumulator, chessState.getBoard(), (Color)(i & 1));
+				sink = sink + refreshedAccumulator.values[i & 1][0];
+			}
+			const double refreshNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / NETWORK_BENCH_ITERATIONS;
+
+			totalSimdNanoseconds += simdNanoseconds;
+			totalScalarNanoseconds += scalarNanoseconds;
+			totalRefreshNanoseconds += refreshNanoseconds;
+
+			std::cout << std::left << std::setw(72) << fen
+				<< "inference " << std::fixed << std::setprecision(1) << simdNanoseconds << "ns"
+				<< "  scalar " << scalarNanoseconds << "ns"
+				<< "  refresh " << refreshNanoseconds << "ns" << std::endl;
+		}
+
+		const double positionCount = (double)BENCH_POSITIONS.size();
+		std::cout << "Inference: " << std::fixed << std::setprecision(1) << totalSimdNanoseconds / positionCount << "ns/eval, "
+			<< (uint64_t)(positionCount * 1e9 / totalSimdNanoseconds) << " evals/second" << std::endl;
+		std::cout << "Scalar inference: " << totalScalarNanoseconds / positionCount << "ns/eval, "
+			<< (uint64_t)(positionCount * 1e9 / totalScalarNanoseconds) << " evals/second" << std::endl;
+		std::cout << "Accumulator refresh: " << totalRefreshNanoseconds / positionCount << "ns/perspective" << std::endl;
+
+		return 0;
+	}
+
+	/**
+	 * Times the attack boards maintained by the board against recalculating them, and the legal move generation that
+	 * relies on them to detect check.
+	 *
+	 * \return process exit code
+	 */
+	int runAttackBenchmark()
+	{
+		double totalMaintainedNanoseconds = 0.0, totalRecalculatedNanoseconds = 0.0, totalMoveGenerationNanoseconds = 0.0;
+		volatile Bitboard sink = 0; // keeps the attack boards from being optimized away
+
+		for (const std::string& fen : BENCH_POSITIONS)
+		{
+			const ChessState chessState(fen);
+			const util::bitboard::BitboardSet& board = chessState.getBoard();
+			const Color player = chessState.getNextTurn();
+
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				if (board.getAttackBoard((Color)color) != board.calculateAttackBoard((Color)color))
+				{
+					std::cout << "Maintained attack board does not match recalculated attack board: " << fen << std::endl;
+					return 1;
+				}
+			}
+
+			auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < ATTACK_BENCH_ITERATIONS; i++)
+			{
+				sink = sink ^ board.getAttackBoard((Color)(i & 1)) ^ board.getCheckers((Color)(i & 1));
+			}
+			const double maintainedNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / ATTACK_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < ATTACK_BENCH_ITERATIONS; i++)
+			{
+				sink = sink ^ board.calculateAttackBoard((Color)(i & 1));
+			}
+			const double recalculatedNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / ATTACK_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < MOVE_GENERATION_BENCH_ITERATIONS; i++)
+			{
+				sink = sink ^ move::getValidMoves(chessState, player).size();
+			}
+			const double moveGenerationNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / MOVE_GENERATION_BENCH_ITERATIONS;
+
+			totalMaintainedNanoseconds += maintainedNanoseconds;
+			totalRecalculatedNanoseconds += recalculatedNanoseconds;
+			totalMoveGenerationNanoseconds += moveGenerationNanoseconds;
+
+			std::cout << std::left << std::setw(72) << fen
+				<< "maintained " << std::fixed << std::setprecision(1) << maintainedNanoseconds << "ns"
+				<< "  recalculated " << recalculatedNanoseconds << "ns"
+				<< "  legal moves " << moveGenerationNanoseconds / 1000.0 << "us" << std::endl;
+		}
+
+		const double positionCount = (double)BENCH_POSITIONS.size();
+		std::cout << "Maintained: " << std::fixed << std::setprecision(1) << totalMaintainedNanoseconds / positionCount << "ns/query" << std::endl;
+		std::cout << "Recalculated: " << totalRecalculatedNanoseconds / positionCount << "ns/query" << std::endl;
+		std::cout << "Legal moves: " << totalMoveGenerationNanoseconds / positionCount / 1000.0 << "us/position" << std::endl;
+
+		return 0;
+	}
+
+	/**
+	 * Times parsing and writing FEN strings through a game state against the allocation-free parser and writer.
+	 *
+	 * \return process exit code
+	 */
+	int runFenBenchmark()
+	{
+		double totalStateNanoseconds = 0.0, totalParserNanoseconds = 0.0;
+		volatile size_t sink = 0; // keeps the FEN strings from being optimized away
+
+		move::populateLookupTables();
+
+		for (const std::string& fen : BENCH_POSITIONS)
+		{
+			util::FenPosition fenPosition;
+			char buffer[util::MAX_FEN_LENGTH];
+			if (util::parseFen(fen, fenPosition) || std::string_view(buffer, util::writeFen(fenPosition, buffer)) != fen)
+			{
+				std::cout << "FEN string does not survive parsing and writing: " << fen << std::endl;
+				return 1;
+			}
+
+			auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < FEN_BENCH_ITERATIONS; i++)
+			{
+				sink = sink + ChessState(fen).getFenString().size();
+			}
+			const double stateNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / FEN_BENCH_ITERATIONS;
+
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < FEN_BENCH_ITERATIONS; i++)
+			{
+				util::parseFen(fen, fenPosition);
+				sink = sink + util::writeFen(fenPosition, buffer);
+			}
+			const double parserNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count() / FEN_BENCH_ITERATIONS;
+
+			totalStateNanoseconds += stateNanoseconds;
+			totalParserNanoseconds += parserNanoseconds;
+
+			std::cout << std::left << std::setw(72) << fen
+				<< "game state " << std::fixed << std::setprecision(1) << stateNanoseconds << "ns"
+				<< "  parser " << parserNanoseconds << "ns" << std::endl;
+		}
+
+		const double positionCount = (double)BENCH_POSITIONS.size();
+		std::cout << "Game state: " << std::fixed << std::setprecision(1) << totalStateNanoseconds / positionCount << "ns/FEN, "
+			<< (uint64_t)(positionCount * 1e9 / totalStateNanoseconds) << " FENs/second" << std::endl;
+		std::cout << "Parser: " << totalParserNanoseconds / positionCount << "ns/FEN, "
+			<< (uint64_t)(positionCount * 1e9 / totalParserNanoseconds) << " FENs/second" << std::endl;
+
+		return 0;
+	}
+
+	int runBenchmark(const std::vector<std::string>& args)
+	{
+		if (!args.empty() && args[0] == "eval")
+		{
+			return runEvaluationBenchmark();
+		}
+		if (!args.empty() && args[0] == "nnue")
+		{
+			return runNetworkBenchmark();
+		}
+		if (!args.empty() && args[0] == "attacks")
+		{
+			return runAttackBenchmark();
+		}
+		if (!args.empty() && args[0] == "fen")
+		{
+			return runFenBenchmark();
+		}
+
+		int depth = DEFAULT_BENCH_DEPTH;
+		search::SearchParameters searchParameters;
+		evaluation::EvaluatorType evaluatorType = evaluation::getDefaultEvaluatorType();
+
+		for (size_t argIndex = 0; argIndex < args.size(); argIndex++)
+		{
+			const std::string& arg = args[argIndex];
+			if (arg == "--evaluator" && argIndex + 1 < args.size())
+			{
+				evaluatorType = evaluation::getEvaluatorTypeFromString(args[++argIndex]);
+			}
+			else if (arg == "--param" && argIndex + 1 < args.size())
+			{
+				search::setTunableParameter(searchParameters, args[++argIndex]);
+			}
+			else if (arg == "--no-pvs")
+			{
+				searchParameters.principalVariationSearch = false;
+			}
+			else if (arg == "--no-aspiration")
+			{
+				searchParameters.aspirationWindows = false;
+			}
+			else if (arg == "--no-null-move")
+			{
+				searchParameters.nullMovePruning = false;
+			}
+			else if (arg == "--no-lmr")
+			{
+				searchParameters.lateMoveReductions = false;
+			}
+			else if (arg == "--no-futility")
+			{
+				searchParameters.futilityPruning = false;
+			}
+			else if (arg == "--no-reverse-futility")
+			{
+				searchParameters.reverseFutilityPruning = false;
+			}
+			else
+			{
+				depth = std::stoi(arg);
+			}
+		}
+
+		move::populateLookupTables();
+
+		uint64_t totalNodes = 0;
+		double totalMilliseconds = 0.0;
+		search::SearchStatistics totalStatistics; // only the rates are reported, since elapsed times are not summed
+
+		for (const std::string& fen : BENCH_POSITIONS)
+		{
+			ChessState chessState(fen);
+			const std::unique_ptr<Agent> agent = createAgent(evaluatorType, chessState, chessState.getNextTurn(), depth, searchParameters);
+
+			const auto startTime = std::chrono::steady_clock::now();
+			const move::Move move = agent->getMove();
+			const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+			totalNodes += agent->getNodeCount();
+			totalMilliseconds += milliseconds;
+			totalStatistics += agent->getSearchStatistics();
+
+			std::cout << std::left << std::setw(72) << fen
+				<< util::toFileAndRank(move.source) << util::toFileAndRank(move.destination)
+				<< "  nodes " << std::setw(10) << agent->getNodeCount()
+				<< " time " << std::fixed << std::setprecision(1) << milliseconds << "ms" << std::endl;
+		}
+
+		std::cout << "Evaluator: " << evaluation::toString(evaluatorType) << std::endl;
+		std::cout << "Depth: " << depth << std::endl;
+		std::cout << "Nodes: " << totalNodes << std::endl;
+		std::cout << "Time: " << std::fixed << std::setprecision(1) << totalMilliseconds << "ms" << std::endl;
+		std::cout << "Nodes/second: " << (uint64_t)(totalNodes / (totalMilliseconds / 1000.0)) << std::endl;
+		std::cout << "Beta cutoffs: " << totalStatistics.getBetaCutoffRate() * 100.0 << "%" << std::endl;
+		std::cout << "First move beta cutoffs: " << totalStatistics.getFirstMoveBetaCutoffRate() * 100.0 << "%" << std::endl;
+		std::cout << "Transposition table hits: " << totalStatistics.getTranspositionHitRate() * 100.0 << "%" << std::endl;
+		std::cout << "Pawn hash table hits: " << totalStatistics.getPawnHashHitRate() * 100.0 << "%" << std::endl;
+		std::cout << "Evaluation cache hits: " << totalStatistics.getEvaluationCacheHitRate() * 100.0 << "%" << std::endl;
+		std::cout << "Quiescence nodes: " << totalStatistics.getQuiescenceNodeRate() * 100.0 << "%" << std::endl;
+
+		return 0;
+	}
+}
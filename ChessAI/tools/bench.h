@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Searches a fixed suite of positions and reports the nodes searched and time taken for each.
+	 *
+	 * Usage: bench [depth] [--evaluator MATERIAL|PIECE_SQUARE|ATTACK|NETWORK] [--param name=value] [--no-pvs] [--no-aspiration] [--no-null-move] [--no-lmr] [--no-futility] [--no-reverse-futility]
+	 *        bench eval
+	 *        bench nnue
+	 *        bench attacks
+	 *        bench fen
+	 *
+	 * The eval form times the static evaluation of each position instead of searching it, the nnue form times the
+	 * evaluation network's inference, the attacks form times the attack boards and legal move generation, and the fen
+	 * form times parsing and writing FEN strings with and without a game state. Each --param sets a tunable search
+	 * parameter by name; see search/parameterRegistry.h.
+	 *
+	 * \param args the command line arguments following the "bench" command
+	 * \return process exit code
+	 */
+	int runBenchmark(const std::vector<std::string>& args);
+}
@@ -0,0 +1,188 @@
+#include "dataGenerator.h"
+
+#include "selfPlay.h"
+#include "trainingData.h"
+#include "../move/moveLookupTable.h"
+#include "../move/moveUtil.h"
+#include "../evaluation/evaluators.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace tools
+{
+	const size_t DEFAULT_GENERATED_GAMES = 1000;
+	const uint64_t DEFAULT_GENERATION_NODES = 5000;
+	const int DEFAULT_GENERATION_OPENING_PLIES = 8;
+	const uint64_t DEFAULT_GENERATION_SEED = 1;
+	const size_t GENERATION_REPORT_INTERVAL = 100; // games between progress reports
+	const size_t MERGE_BUFFER_SIZE = 1 << 20; // bytes copied at a time when merging part files
+
+	/**
+	 * Appends a part file to the output file and deletes it.
+	 *
+	 * \param partPath the path of the part file
+	 * \param output the output file, opened for appending in binary mode
+	 * \return true if the part file was appended, false otherwise
+	 */
+	bool appendPartFile(const std::string& partPath, std::ofstream& output)
+	{
+		{
+			std::ifstream input(partPath, std::ios::binary);
+			if (!input)
+			{
+				return false;
+			}
+
+			std::vector<char> buffer(MERGE_BUFFER_SIZE);
+			while (input.read(buffer.data(), buffer.size()) || input.gcount() > 0)
+			{
+				output.write(buffer.data(), input.gcount());
+			}
+		}
+
+		return std::remove(partPath.c_str()) == 0;
+	}
+
+	int runDataGenerator(const std::vector<std::string>& args)
+	{
+		if (args.empty())
+		{
+			std::cout << "Usage: datagen <output path> [--games count] [--nodes count] [--concurrency count] [--opening-plies count] "
+				"[--sample-rate fraction] [--evaluator name] [--seed seed]" << std::endl;
+			return 1;
+		}
+
+		const std::string outputPath = args[0];
+		size_t gameCount = DEFAULT_GENERATED_GAMES;
+		size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+		int openingPlies = DEFAULT_GENERATION_OPENING_PLIES;
+		double sampleRate = 1.0;
+		uint64_t seed = DEFAULT_GENERATION_SEED;
+		EngineConfiguration engine;
+		engine.evaluatorType = evaluation::getDefaultEvaluatorType();
+		GameSettings gameSettings;
+		gameSettings.moveTime = std::nullopt;
+		gameSettings.maxNodes = DEFAULT_GENERATION_NODES;
+
+		for (size_t argIndex = 1; argIndex + 1 < args.size(); argIndex += 2)
+		{
+			const std::string& arg = args[argIndex];
+			const std::string& value = args[argIndex + 1];
+			if (arg == "--games")
+			{
+				gameCount = std::stoul(value);
+			}
+			else if (arg == "--nodes")
+			{
+				gameSettings.maxNodes = std::stoull(value);
+			}
+			else if (arg == "--concurrency")
+			{
+				concurrency = std::max<size_t>(std::stoul(value), 1);
+			}
+			else if (arg == "--opening-plies")
+			{
+				openingPlies = std::stoi(value);
+			}
+			else if (arg == "--sample-rate")
+			{
+				sampleRate = std::stod(value);
+			}
+			else if (arg == "--evaluator")
+			{
+				engine.evaluatorType = evaluation::getEvaluatorTypeFromString(value);
+			}
+			else if (arg == "--seed")
+			{
+				seed = std::stoull(value);
+			}
+		}
+
+		move::populateLookupTables();
+
+		std::cout << "Generating " << gameCount << " games at " << gameSettings.maxNodes.value() << " nodes per move, "
+			<< concurrency << " at a time, with " << evaluation::toString(engine.evaluatorType) << std::endl;
+
+		std::atomic<size_t> nextGameIndex = 0, finishedGameCount = 0, positionCount = 0;
+		std::mutex reportMutex;
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// One writer per thread, so threads never wait on each other to write; part files left by an interrupted run are
+		// truncated so their records are not merged into this run's output
+		runConcurrently(concurrency, concurrency, [&](const size_t threadIndex) {
+			TrainingDataWriter writer(outputPath + ".part" + std::to_string(threadIndex), true);
+			std::vector<TrainingRecord> gameRecords;
+
+			for (size_t gameIndex = nextGameIndex++; gameIndex < gameCount; gameIndex = nextGameIndex++)
+			{
+				// Every game's openings and samples depend only on the seed and the game's index
+				std::mt19937_64 randomEngine(seed + gameIndex);
+				std::bernoulli_distribution sample(sampleRate);
+				const std::string opening = createRandomOpenings(1, openingPlies + (int)(randomEngine() % 2), randomEngine()).front();
+
+				gameRecords.clear();
+				const GameResult result = playGame(opening, engine, engine, gameSettings, [&](const ChessState& chessState, const move::Move& move, const search::Score score) {
+					const Color player = chessState.getNextTurn();
+					if (search::isMateScore(score)
+						|| move::inCheck(player, chessState)
+						|| move::isCapture(chessState, player, move)
+						|| move::isPromotion(chessState, player, move)
+						|| !sample(randomEngine))
+					{
+						return;
+					}
+
+					// The result is filled in once the game is over
+					gameRecords.push_back(encodeTrainingRecord(chessState, score, 0.5));
+				});
+
+				for (TrainingRecord& record : gameRecords)
+				{
+					setTrainingResult(record, result.whiteScore);
+					writer.write(record);
+				}
+				positionCount += gameRecords.size();
+
+				const size_t finishedGames = ++finishedGameCount;
+				if (finishedGames % GENERATION_REPORT_INTERVAL == 0)
+				{
+					const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+					std::lock_guard<std::mutex> lock(reportMutex);
+					std::cout << "Games " << finishedGames << ": " << positionCount.load() << " positions, "
+						<< std::fixed << std::setprecision(0) << positionCount.load() / elapsedSeconds << " positions/s" << std::defaultfloat << std::endl;
+				}
+			}
+		});
+
+		std::ofstream output(outputPath, std::ios::binary | std::ios::app);
+		if (!output)
+		{
+			std::cout << "Unable to open output file: " << outputPath << std::endl;
+			return 1;
+		}
+
+		for (size_t threadIndex = 0; threadIndex < concurrency; threadIndex++)
+		{
+			const std::string partPath = outputPath + ".part" + std::to_string(threadIndex);
+			if (!appendPartFile(partPath, output))
+			{
+				std::cout << "Unable to merge part file: " << partPath << std::endl;
+				return 1;
+			}
+		}
+
+		const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Wrote " << positionCount.load() << " positions from " << gameCount << " games to " << outputPath << " in "
+			<< std::fixed << std::setprecision(1) << elapsedSeconds << "s" << std::defaultfloat << std::endl;
+		return 0;
+	}
+}
\ No newline at end of file
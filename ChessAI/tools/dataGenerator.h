@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Generates training data by playing fixed-node self-play games in parallel.
+	 *
+	 * Usage: datagen <output path> [--games count] [--nodes count] [--concurrency count] [--opening-plies count]
+	 *                [--sample-rate fraction] [--evaluator MATERIAL|PIECE_SQUARE|ATTACK|NETWORK] [--seed seed]
+	 *
+	 * Each game starts from a random opening. Quiet positions, where the side to move is not in check, the chosen move
+	 * is neither a capture nor a promotion and the score is not a mate score, are sampled and labelled with their
+	 * searched score and the game's result. Each thread appends its positions to its own part file, and the part files
+	 * are appended to the output file once every game has finished. The output is in the training record format of
+	 * tools/trainingData.h, which the tune command reads directly.
+	 *
+	 * \param args the command line arguments following the "datagen" command
+	 * \return process exit code
+	 */
+	int runDataGenerator(const std::vector<std::string>& args);
+}
\ No newline at end of file
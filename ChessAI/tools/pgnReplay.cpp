@@ -0,0 +1,81 @@
+#include "pgnReplay.h"
+
+#include "../util/pgn.h"
+#include "../move/moveLookupTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+namespace tools
+{
+	const size_t DEFAULT_MAX_REPORTED_PGN_ERRORS = 10;
+	const size_t PGN_ERROR_CONTEXT_LENGTH = 16; // characters of the game's text shown after an error
+
+	int runPgnReplay(const std::vector<std::string>& args)
+	{
+		if (args.empty())
+		{
+			std::cout << "Usage: pgn <pgn path> [--batch-size count] [--max-errors count]" << std::endl;
+			return 1;
+		}
+
+		size_t batchSize = util::DEFAULT_PGN_BATCH_SIZE;
+		size_t maxReportedErrors = DEFAULT_MAX_REPORTED_PGN_ERRORS;
+		for (size_t argIndex = 1; argIndex + 1 < args.size(); argIndex += 2)
+		{
+			const std::string& arg = args[argIndex];
+			const std::string& value = args[argIndex + 1];
+			if (arg == "--batch-size")
+			{
+				batchSize = std::max<size_t>(std::stoul(value), 1);
+			}
+			else if (arg == "--max-errors")
+			{
+				maxReportedErrors = std::stoul(value);
+			}
+		}
+
+		move::populateLookupTables();
+
+		const util::PgnReader reader(args[0]);
+		std::atomic<size_t> gameCount = 0, moveCount = 0, failedGameCount = 0;
+		std::mutex reportMutex;
+		const auto startTime = std::chrono::steady_clock::now();
+
+		reader.parallelForEachGame([&](const std::string_view gameText, const size_t gameIndex) {
+			// Each thread reuses its game's storage, so parsing only allocates while the longest game so far grows it
+			thread_local util::PgnGame game;
+			std::optional<util::PgnError> error = util::parsePgnGame(gameText, game);
+			if (!error)
+			{
+				error = util::replayPgnGame(game);
+			}
+
+			gameCount++;
+			if (!error)
+			{
+				moveCount += game.moves.size();
+				return;
+			}
+
+			if (failedGameCount++ < maxReportedErrors)
+			{
+				std::lock_guard<std::mutex> lock(reportMutex);
+				std::cout << "Game " << gameIndex + 1 << ": " << error->message << " at \""
+					<< gameText.substr(error->offset, PGN_ERROR_CONTEXT_LENGTH) << "\"" << std::endl;
+			}
+		}, batchSize);
+
+		const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Replayed " << gameCount - failedGameCount << " of " << gameCount << " games (" << moveCount << " moves) in "
+			<< std::fixed << std::setprecision(1) << elapsedSeconds << "s" << std::endl;
+		std::cout << std::setprecision(0) << gameCount / elapsedSeconds * 60.0 << " games/minute, "
+			<< moveCount / elapsedSeconds << " moves/s" << std::defaultfloat << std::endl;
+
+		return failedGameCount == 0 ? 0 : 1;
+	}
+}
\ No newline at end of file
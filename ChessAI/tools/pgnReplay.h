@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Replays every game of a PGN file through the move generator in parallel and reports the throughput.
+	 *
+	 * Usage: pgn <pgn path> [--batch-size count] [--max-errors count]
+	 *
+	 * Each move is resolved from standard algebraic notation to a legal move and played, so the command doubles as a
+	 * check that an archive only holds legal games. Games that cannot be parsed or replayed are reported by their index
+	 * in the file, up to --max-errors of them.
+	 *
+	 * \param args the command line arguments following the "pgn" command
+	 * \return process exit code; 1 if any game could not be replayed
+	 */
+	int runPgnReplay(const std::vector<std::string>& args);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "selfPlay.h"
+
+#include "../agent.h"
+#include "../chess.h"
+#include "../move/moveUtil.h"
+#include "../search/searchLimits.h"
+#include "../evaluation/evaluation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace tools
+{
+	const int FIFTY_MOVE_RULE_HALF_TURNS = 100;
+
+	/**
+	 * Creates an agent for a self-play game.
+	 *
+	 * \param chessState game state
+	 * \param player the player the agent will be playing as
+	 * \param configuration the agent's evaluator and search parameters
+	 * \param gameSettings the time control of the game
+	 * \return the new agent
+	 */
+	std::unique_ptr<Agent> createSelfPlayAgent(ChessState& chessState, const Color player, const EngineConfiguration& configuration, const GameSettings& gameSettings)
+	{
+		search::SearchParameters searchParameters = configuration.searchParameters;
+		searchParameters.transpositionTableSize = std::min(searchParameters.transpositionTableSize, DEFAULT_SELF_PLAY_TABLE_SIZE);
+
+		std::unique_ptr<Agent> agent = createAgent(configuration.evaluatorType, chessState, player, gameSettings.searchDepth, searchParameters);
+		// Games are played concurrently, so the agents search on their game's thread rather than competing for the
+		// shared thread pool, which would overrun their move times
+		agent->setSearchLimits(search::SearchLimits{ gameSettings.maxNodes, std::nullopt, gameSettings.moveTime, true });
+		return agent;
+	}
+
+	GameResult playGame(const std::string& openingFen, const EngineConfiguration& white, const EngineConfiguration& black, const GameSettings& gameSettings,
+		const std::function<void(const ChessState&, const move::Move&, const search::Score)>& onMove)
+	{
+		const AdjudicationSettings& adjudication = gameSettings.adjudication;
+		ChessState chessState(openingFen);
+		std::unique_ptr<Agent> agents[COLOR_COUNT] = {
+			createSelfPlayAgent(chessState, Color::WHITE, white, gameSettings),
+			createSelfPlayAgent(chessState, Color::BLACK, black, gameSettings)
+		};
+
+		// Consecutive half turns each side has been winning for, and the game has looked drawn for
+		int winningPlies[COLOR_COUNT] = { 0, 0 }, drawnPlies = 0;
+		int ply = 0;
+		for (; !chessState.getWinner().has_value(); ply++)
+		{
+			const Color player = chessState.getNextTurn();
+			if (ply >= gameSettings.maxPlies
+				|| chessState.getHalfTurnCount() >= FIFTY_MOVE_RULE_HALF_TURNS
+				|| move::getValidMoves(chessState, player).empty())
+			{
+				return GameResult{ 0.5, ply, false };
+			}
+
+			const move::Move move = agents[player]->getMove(TOTAL_PLAYER_TURN_TIME);
+			const search::SearchStatistics& statistics = agents[player]->getSearchStatistics();
+			const search::Score score = player == Color::WHITE ? statistics.score : -statistics.score;
+			if (onMove && statistics.depth > 0)
+			{
+				onMove(chessState, move, score);
+			}
+
+			chessState.update(player, move);
+			if (!adjudication.enabled || statistics.depth == 0)
+			{
+				continue;
+			}
+
+			const search::Score material = evaluation::getMaterialValue(chessState.getBoard(), Color::WHITE);
+			for (const Color side : { Color::WHITE, Color::BLACK })
+			{
+				const int sign = side == Color::WHITE ? 1 : -1;
+				const bool winning = sign * score >= adjudication.winScore || sign * material >= adjudication.winMaterial;
+				winningPlies[side] = winning ? winningPlies[side] + 1 : 0;
+				if (winningPlies[side] >= adjudication.winPlies)
+				{
+					return GameResult{ side == Color::WHITE ? 1.0 : 0.0, ply + 1, true };
+				}
+			}
+
+			drawnPlies = std::abs(score) <= adjudication.drawScore ? drawnPlies + 1 : 0;
+			if (ply + 1 >= adjudication.drawMinPly && drawnPlies >= adjudication.drawPlies)
+			{
+				return GameResult{ 0.5, ply + 1, true };
+			}
+		}
+
+		switch (chessState.getWinner().value())
+		{
+			case Color::WHITE:
+				return GameResult{ 1.0, ply, false };
+			case Color::BLACK:
+				return GameResult{ 0.0, ply, false };
+			default:
+				return GameResult{ 0.5, ply, false };
+		}
+	}
+
+	std::vector<std::string> createRandomOpenings(const size_t openingCount, const int plyCount, const uint64_t seed)
+	{
+		std::mt19937_64 randomEngine(seed);
+		std::vector<std::string> openings;
+		openings.reserve(openingCount);
+
+		while (openings.size() < openingCount)
+		{
+			ChessState chessState;
+			bool playable = true;
+			for (int ply = 0; ply < plyCount && playable; ply++)
+			{
+				const Color player = chessState.getNextTurn();
+				const std::vector<move::Move> validMoves = move::getValidMoves(chessState, player);
+				if (validMoves.empty())
+				{
+					playable = false;
+					break;
+				}
+
+				chessState.update(player, validMoves[std::uniform_int_distribution<size_t>(0, validMoves.size() - 1)(randomEngine)]);
+				playable = !chessState.getWinner().has_value();
+			}
+
+			// Openings that end the game or leave no moves are discarded
+			if (playable && !move::getValidMoves(chessState, chessState.getNextTurn()).empty())
+			{
+				openings.push_back(chessState.getFenString());
+			}
+		}
+
+		return openings;
+	}
+
+	void runConcurrently(const size_t taskCount, const size_t threadCount, const std::function<void(const size_t)>& task)
+	{
+		std::atomic<size_t> nextTaskIndex = 0;
+		std::exception_ptr firstException;
+		std::mutex exceptionMutex;
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < std::max<size_t>(std::min(threadCount, taskCount), 1); i++)
+		{
+			threads.emplace_back([&nextTaskIndex, taskCount, &task, &firstException, &exceptionMutex]() {
+				for (size_t taskIndex = nextTaskIndex++; taskIndex < taskCount; taskIndex = nextTaskIndex++)
+				{
+					try
+					{
+						task(taskIndex);
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(exceptionMutex);
+						if (!firstException)
+						{
+							firstException = std::current_exception();
+						}
+						nextTaskIndex = taskCount;
+						return;
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		if (firstException)
+		{
+			std::rethrow_exception(firstException);
+		}
+	}
+}
\ No newline at end of file
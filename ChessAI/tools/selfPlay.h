@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../chess.h"
+#include "../move/move.h"
+#include "../search/score.h"
+#include "../search/searchParameters.h"
+#include "../evaluation/evaluators.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	const int DEFAULT_MAX_GAME_PLIES = 400; // games still running after this many half turns are adjudicated as draws
+	const size_t DEFAULT_SELF_PLAY_TABLE_SIZE = 4; // megabytes per transposition table; many agents are alive at once
+
+	/**
+	 * The evaluator and search parameters of an agent taking part in self-play.
+	 */
+	struct EngineConfiguration
+	{
+		evaluation::EvaluatorType evaluatorType = evaluation::EvaluatorType::ATTACK;
+		search::SearchParameters searchParameters;
+	};
+
+	/**
+	 * Thresholds for ending games early once their result is clear.
+	 *
+	 * Scores are white's, taken from the score of each agent's search and from the material on the board.
+	 */
+	struct AdjudicationSettings
+	{
+		bool enabled = true;
+		search::Score winScore = 800; // searched score at which a side is considered winning
+		search::Score winMaterial = 1200; // material lead at which a side is considered winning
+		int winPlies = 6; // consecutive half turns one side must be winning for before the game is awarded to it
+		search::Score drawScore = 10; // searched score within which the game is considered drawn
+		int drawPlies = 16; // consecutive half turns the game must be considered drawn for before it is adjudicated
+		int drawMinPly = 80; // half turns played before draws are adjudicated
+	};
+
+	/**
+	 * Settings shared by both agents of a self-play game.
+	 */
+	struct GameSettings
+	{
+		std::optional<double> moveTime = 20.0 * 1000000.0; // fixed time spent on every move in nanoseconds
+		std::optional<uint64_t> maxNodes; // maximum nodes searched for every move; fixes the cost of a move regardless of the hardware
+		int searchDepth = 4; // depth of searches that are not timed; unused while moveTime limits every search
+		int maxPlies = DEFAULT_MAX_GAME_PLIES;
+		AdjudicationSettings adjudication;
+	};
+
+	/**
+	 * The outcome of a self-play game.
+	 */
+	struct GameResult
+	{
+		double whiteScore; // 1 for a win, 0.5 for a draw and 0 for a loss
+		int plyCount; // half turns played from the opening
+		bool adjudicated; // true if the game was ended early by the adjudication thresholds
+	};
+
+	/**
+	 * Plays a game between two agents in-process.
+	 *
+	 * Checkmate ends the game, while stalemate, repetition, the fifty move rule and reaching the maximum number of half
+	 * turns are scored as draws. Games whose result is clear are adjudicated by the game settings' thresholds.
+	 *
+	 * The agents search on the calling thread only, so games can be played concurrently, one per core, without
+	 * slowing each other's searches.
+	 *
+	 * \param openingFen FEN string of the position the game starts from
+	 * \param white the configuration of the agent playing white
+	 * \param black the configuration of the agent playing black
+	 * \param gameSettings the time control and adjudication thresholds of the game
+	 * \param onMove called after each searched move is chosen, before it is made, with the game state, the move and
+	 *               white's searched score; positions with a single legal move are not searched and not reported
+	 * \return the result of the game
+	 */
+	GameResult playGame(const std::string& openingFen, const EngineConfiguration& white, const EngineConfiguration& black, const GameSettings& gameSettings,
+		const std::function<void(const ChessState&, const move::Move&, const search::Score)>& onMove = nullptr);
+
+	/**
+	 * Creates opening positions by playing random legal moves from the starting position.
+	 *
+	 * \param openingCount the number of openings to create
+	 * \param plyCount the number of random half turns played for each opening
+	 * \param seed seeds the random moves, so the same seed always creates the same openings
+	 * \return FEN strings of the openings
+	 */
+	std::vector<std::string> createRandomOpenings(const size_t openingCount, const int plyCount, const uint64_t seed);
+
+	/**
+	 * Runs tasks on dedicated threads, each thread taking the next unstarted task until every task has run.
+	 *
+	 * Games are not run on the shared thread pool, since each one would hold a pool thread for its whole length. If a
+	 * task throws, no further tasks are started and the first exception is rethrown once every thread has finished.
+	 *
+	 * \param taskCount the number of tasks
+	 * \param threadCount the number of threads running tasks at once
+	 * \param task called with the index of each task
+	 */
+	void runConcurrently(const size_t taskCount, const size_t threadCount, const std::function<void(const size_t)>& task);
+}
\ No newline at end of file
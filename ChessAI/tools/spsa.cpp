@@ -0,0 +1,235 @@
+#include "spsa.h"
+
+#include "selfPlay.h"
+#include "../move/moveLookupTable.h"
+#include "../search/parameterRegistry.h"
+#include "../search/searchParameters.h"
+#include "../evaluation/evaluators.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using search::SearchParameters;
+using search::TunableParameter;
+
+namespace tools
+{
+	const int DEFAULT_SPSA_ITERATIONS = 500;
+	const double DEFAULT_SPSA_MOVE_TIME = 20.0; // milliseconds
+	const double DEFAULT_SPSA_LEARNING_RATE = 0.002; // learning rate of the final iteration, relative to each parameter's step
+	const uint64_t DEFAULT_SPSA_SEED = 1;
+	const std::string DEFAULT_SPSA_OUTPUT = "spsaParameters.txt";
+	const int SPSA_OPENING_PLIES = 8;
+	const int SPSA_REPORT_INTERVAL = 10; // iterations between writing the tuned values
+
+	// Decay exponents of the learning rate and perturbation sizes, and the stability constant as a fraction of the
+	// iteration count, as recommended for SPSA
+	const double LEARNING_RATE_DECAY = 0.602, PERTURBATION_DECAY = 0.101, STABILITY_FRACTION = 0.1;
+
+	/**
+	 * Applies real-valued parameter values to a set of search parameters.
+	 *
+	 * \param parameters the tuned parameters
+	 * \param values the value of each tuned parameter
+	 * \return the default search parameters with the tuned parameters set; integer parameters are rounded
+	 */
+	SearchParameters createSearchParameters(const std::vector<const TunableParameter*>& parameters, const std::vector<double>& values)
+	{
+		SearchParameters searchParameters;
+		for (size_t i = 0; i < parameters.size(); i++)
+		{
+			parameters[i]->set(searchParameters, values[i]);
+		}
+		return searchParameters;
+	}
+
+	/**
+	 * Writes the tuned values of the parameters as "name=value" lines.
+	 *
+	 * \param outputPath the path of the file being written
+	 * \param parameters the tuned parameters
+	 * \param values the unrounded value of each tuned parameter
+	 * \param iteration the number of completed iterations
+	 * \return true if the file was written, false otherwise
+	 */
+	bool writeTunedParameters(const std::string& outputPath, const std::vector<const TunableParameter*>& parameters, const std::vector<double>& values, const int iteration)
+	{
+		std::ofstream output(outputPath);
+		if (!output)
+		{
+			return false;
+		}
+
+		// Values are written as the agents apply them, with integer parameters rounded
+		const SearchParameters searchParameters = createSearchParameters(parameters, values);
+		output << "# Tuned over " << iteration << " SPSA iterations" << std::endl;
+		for (const TunableParameter* parameter : parameters)
+		{
+			output << parameter->name << "=" << parameter->get(searchParameters) << std::endl;
+		}
+		return true;
+	}
+
+	int runSpsa(const std::vector<std::string>& args)
+	{
+		int iterationCount = DEFAULT_SPSA_ITERATIONS;
+		size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+		size_t gameCount = 0; // defaults to two games per concurrent game slot
+		double moveTime = DEFAULT_SPSA_MOVE_TIME, learningRate = DEFAULT_SPSA_LEARNING_RATE;
+		uint64_t seed = DEFAULT_SPSA_SEED;
+		std::string outputPath = DEFAULT_SPSA_OUTPUT;
+		GameSettings gameSettings;
+		evaluation::EvaluatorType evaluatorType = evaluation::getDefaultEvaluatorType();
+
+		std::vector<const TunableParameter*> parameters;
+		for (size_t argIndex = 0; argIndex + 1 < args.size(); argIndex += 2)
+		{
+			const std::string& arg = args[argIndex];
+			const std::string& value = args[argIndex + 1];
+			if (arg == "--iterations")
+			{
+				iterationCount = std::stoi(value);
+			}
+			else if (arg == "--games")
+			{
+				gameCount = std::stoul(value);
+			}
+			else if (arg == "--move-time")
+			{
+				moveTime = std::stod(value);
+			}
+			else if (arg == "--concurrency")
+			{
+				concurrency = std::stoul(value);
+			}
+			else if (arg == "--learning-rate")
+			{
+				learningRate = std::stod(value);
+			}
+			else if (arg == "--parameters")
+			{
+				std::istringstream names(value);
+				std::string name;
+				while (std::getline(names, name, ','))
+				{
+					parameters.push_back(&search::getTunableParameter(name));
+				}
+			}
+			else if (arg == "--evaluator")
+			{
+				evaluatorType = evaluation::getEvaluatorTypeFromString(value);
+			}
+			else if (arg == "--seed")
+			{
+				seed = std::stoull(value);
+			}
+			else if (arg == "--output")
+			{
+				outputPath = value;
+			}
+		}
+
+		if (parameters.empty())
+		{
+			for (const TunableParameter& parameter : search::getTunableParameters())
+			{
+				parameters.push_back(&parameter);
+			}
+		}
+
+		// Games are played in pairs from the same opening with colors reversed
+		gameCount = std::max<size_t>(gameCount == 0 ? concurrency * 2 : gameCount, 2);
+		gameCount += gameCount % 2;
+		gameSettings.moveTime = moveTime * 1000000.0;
+
+		move::populateLookupTables();
+
+		const SearchParameters defaultParameters;
+		std::vector<double> values;
+		for (const TunableParameter* parameter : parameters)
+		{
+			values.push_back(parameter->get(defaultParameters));
+		}
+
+		std::cout << "Tuning " << parameters.size() << " parameters with " << gameCount << " games per iteration, "
+			<< concurrency << " at a time, " << moveTime << "ms per move" << std::endl;
+
+		std::mt19937_64 randomEngine(seed);
+		const double stability = STABILITY_FRACTION * iterationCount;
+		const auto startTime = std::chrono::steady_clock::now();
+		for (int iteration = 1; iteration <= iterationCount; iteration++)
+		{
+			// Perturbations shrink from larger at the start to each parameter's step by the final iteration, and the
+			// learning rate decays to its final value in the same way
+			const double perturbationScale = std::pow((double)iterationCount / iteration, PERTURBATION_DECAY);
+			const double learningRateScale = std::pow((stability + iterationCount) / (stability + iteration), LEARNING_RATE_DECAY);
+
+			std::vector<double> directions(parameters.size()), plusValues(values), minusValues(values);
+			for (size_t i = 0; i < parameters.size(); i++)
+			{
+				directions[i] = (randomEngine() & 1) ? 1.0 : -1.0;
+				const double perturbation = parameters[i]->step * perturbationScale * directions[i];
+				plusValues[i] = std::clamp(values[i] + perturbation, parameters[i]->minValue, parameters[i]->maxValue);
+				minusValues[i] = std::clamp(values[i] - perturbation, parameters[i]->minValue, parameters[i]->maxValue);
+			}
+
+			const EngineConfiguration plus{ evaluatorType, createSearchParameters(parameters, plusValues) };
+			const EngineConfiguration minus{ evaluatorType, createSearchParameters(parameters, minusValues) };
+			const std::vector<std::string> openings = createRandomOpenings(gameCount / 2, SPSA_OPENING_PLIES, randomEngine());
+
+			// Scores of the raised parameters; each game writes only its own entry
+			std::vector<double> plusScores(gameCount);
+			runConcurrently(gameCount, concurrency, [&](const size_t gameIndex) {
+				const std::string& opening = openings[gameIndex / 2];
+				plusScores[gameIndex] = gameIndex % 2 == 0
+					? playGame(opening, plus, minus, gameSettings).whiteScore
+					: 1.0 - playGame(opening, minus, plus, gameSettings).whiteScore;
+			});
+
+			int wins = 0, losses = 0;
+			for (const double score : plusScores)
+			{
+				wins += score == 1.0;
+				losses += score == 0.0;
+			}
+
+			// Each parameter moves by its learning rate over its perturbation, scaled by the raised side's net wins
+			const double result = wins - losses;
+			for (size_t i = 0; i < parameters.size(); i++)
+			{
+				const double step = parameters[i]->step;
+				const double iterationLearningRate = learningRate * step * step * learningRateScale;
+				const double iterationPerturbation = step * perturbationScale;
+				values[i] = std::clamp(values[i] + iterationLearningRate / iterationPerturbation * result * directions[i], parameters[i]->minValue, parameters[i]->maxValue);
+			}
+
+			std::cout << "Iteration " << iteration << ": +" << wins << " -" << losses << " =" << (gameCount - wins - losses)
+				<< " (" << std::fixed << std::setprecision(1) << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << "s)" << std::endl;
+			std::cout << std::defaultfloat << std::setprecision(6);
+
+			if (iteration % SPSA_REPORT_INTERVAL == 0 || iteration == iterationCount)
+			{
+				for (size_t i = 0; i < parameters.size(); i++)
+				{
+					std::cout << "  " << parameters[i]->name << " = " << values[i] << std::endl;
+				}
+
+				if (!writeTunedParameters(outputPath, parameters, values, iteration))
+				{
+					std::cout << "Unable to write tuned parameters to " << outputPath << std::endl;
+					return 1;
+				}
+			}
+		}
+
+		std::cout << "Wrote tuned parameters to " << outputPath << std::endl;
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Tunes the search parameters by simultaneous perturbation stochastic approximation (SPSA) over self-play games.
+	 *
+	 * Usage: spsa [--iterations count] [--games count] [--move-time milliseconds] [--concurrency count]
+	 *             [--learning-rate rate] [--parameters name,name,...] [--evaluator MATERIAL|PIECE_SQUARE|ATTACK|NETWORK]
+	 *             [--seed seed] [--output path]
+	 *
+	 * Every iteration perturbs each tuned parameter up or down at random, plays games between agents searching with
+	 * the raised and the lowered parameters from random openings with colors reversed, and moves the parameters
+	 * towards the side that scored better. Games run concurrently in-process. The tuned values are written as one
+	 * "name=value" line per parameter, the form accepted by bench's --param option.
+	 *
+	 * \param args the command line arguments following the "spsa" command
+	 * \return process exit code
+	 */
+	int runSpsa(const std::vector<std::string>& args);
+}
\ No newline at end of file
@@ -0,0 +1,375 @@
+#include "tournament.h"
+
+#include "selfPlay.h"
+#include "../move/moveLookupTable.h"
+#include "../search/parameterRegistry.h"
+#include "../evaluation/evaluators.h"
+#include "../util/fen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace tools
+{
+	const size_t DEFAULT_MATCH_GAMES = 2000;
+	const double DEFAULT_MATCH_MOVE_TIME = 20.0; // milliseconds
+	const double DEFAULT_SPRT_ERROR_RATE = 0.05;
+	const uint64_t DEFAULT_MATCH_SEED = 1;
+	const int MATCH_OPENING_PLIES = 8;
+	const int MATCH_REPORT_INTERVAL = 20; // games between progress reports
+	const double CONFIDENCE_Z_SCORE = 1.959964; // two-sided 95% confidence interval
+
+	/**
+	 * Wins, draws and losses of the first engine of a match.
+	 */
+	struct MatchScore
+	{
+		int wins = 0, draws = 0, losses = 0;
+
+		/**
+		 * Get the number of games played.
+		 *
+		 * \return the number of games
+		 */
+		int getGameCount() const
+		{
+			return wins + draws + losses;
+		}
+
+		/**
+		 * Get the mean score per game.
+		 *
+		 * \return the score in [0, 1], 0.5 if no games have been played
+		 */
+		double getMeanScore() const
+		{
+			return getGameCount() == 0 ? 0.5 : (wins + 0.5 * draws) / getGameCount();
+		}
+
+		/**
+		 * Get the variance of the score of a single game.
+		 *
+		 * \return the variance of the game results around the mean score
+		 */
+		double getVariance() const
+		{
+			if (getGameCount() == 0)
+			{
+				return 0.0;
+			}
+
+			const double meanScore = getMeanScore();
+			return (wins * std::pow(1.0 - meanScore, 2) + draws * std::pow(0.5 - meanScore, 2) + losses * std::pow(meanScore, 2)) / getGameCount();
+		}
+	};
+
+	/**
+	 * Converts an expected score to an Elo difference.
+	 *
+	 * \param score the expected score in (0, 1)
+	 * \return the Elo difference that expects the score
+	 */
+	double getEloDifference(const double score)
+	{
+		return -400.0 * std::log10(1.0 / score - 1.0);
+	}
+
+	/**
+	 * Converts an Elo difference to an expected score.
+	 *
+	 * \param eloDifference the rating difference
+	 * \return the expected score in (0, 1)
+	 */
+	double getExpectedScore(const double eloDifference)
+	{
+		return 1.0 / (1.0 + std::pow(10.0, -eloDifference / 400.0));
+	}
+
+	/**
+	 * Calculates the log-likelihood ratio of a match score under two Elo hypotheses, approximating the distribution of
+	 * the mean score as normal.
+	 *
+	 * \param matchScore the results so far
+	 * \param elo0 the Elo difference of the null hypothesis
+	 * \param elo1 the Elo difference of the alternative hypothesis
+	 * \return the log-likelihood ratio; positive values favor the alternative hypothesis
+	 */
+	double getLogLikelihoodRatio(const MatchScore& matchScore, const double elo0, const double elo1)
+	{
+		const double variance = matchScore.getVariance();
+		if (variance <= 0.0)
+		{
+			return 0.0;
+		}
+
+		const double score0 = getExpectedScore(elo0), score1 = getExpectedScore(elo1);
+		return (score1 - score0) * (2.0 * matchScore.getMeanScore() - score0 - score1) / (2.0 * variance / matchScore.getGameCount());
+	}
+
+	/**
+	 * Prints the results of a match with the Elo difference and its 95% confidence interval.
+	 *
+	 * \param matchScore the results so far
+	 * \param logLikelihoodRatio the SPRT log-likelihood ratio, if a test is running
+	 */
+	void printMatchScore(const MatchScore& matchScore, const std::optional<double>& logLikelihoodRatio)
+	{
+		// Scores of 0 and 1 have infinite Elo differences, so the score is kept half a game from either
+		const int gameCount = matchScore.getGameCount();
+		const double margin = 0.5 / std::max(gameCount, 1);
+		const double meanScore = std::clamp(matchScore.getMeanScore(), margin, 1.0 - margin);
+		const double scoreError = CONFIDENCE_Z_SCORE * std::sqrt(matchScore.getVariance() / std::max(gameCount, 1));
+		const double lowerElo = getEloDifference(std::clamp(meanScore - scoreError, margin, 1.0 - margin));
+		const double upperElo = getEloDifference(std::clamp(meanScore + scoreError, margin, 1.0 - margin));
+
+		std::cout << "Games " << gameCount << ": +" << matchScore.wins << " -" << matchScore.losses << " =" << matchScore.draws
+			<< std::fixed << std::setprecision(1) << ", Elo " << getEloDifference(meanScore) << " +/- " << (upperElo - lowerElo) / 2.0;
+		if (logLikelihoodRatio.has_value())
+		{
+			std::cout << std::setprecision(2) << ", LLR " << logLikelihoodRatio.value();
+		}
+		std::cout << std::defaultfloat << std::setprecision(6) << std::endl;
+	}
+
+	/**
+	 * Reads opening positions from a file holding one FEN string per line.
+	 *
+	 * Lines with only the first four FEN fields, as in EPD files, are given a half turn count of 0 and a full turn
+	 * count of 1; anything after the FEN fields is ignored, as are empty lines, lines starting with '#' and lines
+	 * that do not start with a valid FEN string.
+	 *
+	 * \param input the openings file
+	 * \return FEN strings of the openings
+	 */
+	std::vector<std::string> readOpenings(std::istream& input)
+	{
+		std::vector<std::string> openings;
+		std::string line;
+		while (std::getline(input, line))
+		{
+			const size_t fenStart = line.find_first_not_of(" \t");
+			if (fenStart == std::string::npos || line[fenStart] == '#')
+			{
+				continue;
+			}
+
+			util::FenPosition fenPosition;
+			size_t fenLength;
+			if (!util::parseFenPrefix(std::string_view(line).substr(fenStart), fenPosition, fenLength))
+			{
+				openings.push_back(line.substr(fenStart, fenLength));
+			}
+		}
+
+		return openings;
+	}
+
+	/**
+	 * Sets search parameters from a file of "name=value" lines; empty lines and lines starting with '#' are ignored.
+	 *
+	 * \param searchParameters the parameters being modified
+	 * \param path the path of the parameters file
+	 * \return true if the file was read, false otherwise
+	 */
+	bool readSearchParameters(search::SearchParameters& searchParameters, const std::string& path)
+	{
+		std::ifstream input(path);
+		if (!input)
+		{
+			return false;
+		}
+
+		std::string line;
+		while (std::getline(input, line))
+		{
+			line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+			if (!line.empty() && line[0] != '#')
+			{
+				search::setTunableParameter(searchParameters, line);
+			}
+		}
+		return true;
+	}
+
+	int runTournament(const std::vector<std::string>& args)
+	{
+		size_t gameCount = DEFAULT_MATCH_GAMES;
+		size_t concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+		double moveTime = DEFAULT_MATCH_MOVE_TIME;
+		double alpha = DEFAULT_SPRT_ERROR_RATE, beta = DEFAULT_SPRT_ERROR_RATE;
+		std::optional<std::pair<double, double>> sprtElo;
+		uint64_t seed = DEFAULT_MATCH_SEED;
+		std::string openingsPath;
+		EngineConfiguration engines[2];
+		engines[0].evaluatorType = engines[1].evaluatorType = evaluation::getDefaultEvaluatorType();
+		GameSettings gameSettings;
+
+		for (size_t argIndex = 0; argIndex < args.size(); argIndex++)
+		{
+			const std::string& arg = args[argIndex];
+			const bool hasValue = argIndex + 1 < args.size();
+			if (arg == "--games" && hasValue)
+			{
+				gameCount = std::stoul(args[++argIndex]);
+			}
+			else if (arg == "--openings" && hasValue)
+			{
+				openingsPath = args[++argIndex];
+			}
+			else if (arg == "--move-time" && hasValue)
+			{
+				moveTime = std::stod(args[++argIndex]);
+			}
+			else if (arg == "--concurrency" && hasValue)
+			{
+				concurrency = std::stoul(args[++argIndex]);
+			}
+			else if (arg == "--evaluator" && hasValue)
+			{
+				engines[0].evaluatorType = engines[1].evaluatorType = evaluation::getEvaluatorTypeFromString(args[++argIndex]);
+			}
+			else if ((arg == "--evaluator-a" || arg == "--evaluator-b") && hasValue)
+			{
+				engines[arg.back() == 'b'].evaluatorType = evaluation::getEvaluatorTypeFromString(args[++argIndex]);
+			}
+			else if ((arg == "--param-a" || arg == "--param-b") && hasValue)
+			{
+				search::setTunableParameter(engines[arg.back() == 'b'].searchParameters, args[++argIndex]);
+			}
+			else if ((arg == "--parameters-a" || arg == "--parameters-b") && hasValue)
+			{
+				if (!readSearchParameters(engines[arg.back() == 'b'].searchParameters, args[++argIndex]))
+				{
+					std::cout << "Unable to open parameters file: " << args[argIndex] << std::endl;
+					return 1;
+				}
+			}
+			else if (arg == "--sprt" && argIndex + 2 < args.size())
+			{
+				const double elo0 = std::stod(args[++argIndex]);
+				sprtElo = std::make_pair(elo0, std::stod(args[++argIndex]));
+			}
+			else if (arg == "--alpha" && hasValue)
+			{
+				alpha = std::stod(args[++argIndex]);
+			}
+			else if (arg == "--beta" && hasValue)
+			{
+				beta = std::stod(args[++argIndex]);
+			}
+			else if (arg == "--no-adjudication")
+			{
+				gameSettings.adjudication.enabled = false;
+			}
+			else if (arg == "--seed" && hasValue)
+			{
+				seed = std::stoull(args[++argIndex]);
+			}
+		}
+
+		gameSettings.moveTime = moveTime * 1000000.0;
+		gameCount += gameCount % 2;
+
+		move::populateLookupTables();
+
+		std::vector<std::string> openings;
+		if (!openingsPath.empty())
+		{
+			std::ifstream input(openingsPath);
+			if (!input)
+			{
+				std::cout << "Unable to open openings file: " << openingsPath << std::endl;
+				return 1;
+			}
+			openings = readOpenings(input);
+		}
+		else
+		{
+			openings = createRandomOpenings(gameCount / 2, MATCH_OPENING_PLIES, seed);
+		}
+
+		if (openings.empty())
+		{
+			std::cout << "No openings to play" << std::endl;
+			return 1;
+		}
+
+		// The test stops once the log-likelihood ratio leaves the bounds set by the error rates
+		const double lowerBound = std::log(beta / (1.0 - alpha)), upperBound = std::log((1.0 - beta) / alpha);
+
+		std::cout << "Playing " << gameCount << " games from " << openings.size() << " openings, " << concurrency << " at a time, "
+			<< moveTime << "ms per move: " << evaluation::toString(engines[0].evaluatorType) << " (A) vs "
+			<< evaluation::toString(engines[1].evaluatorType) << " (B)" << std::endl;
+		if (sprtElo.has_value())
+		{
+			std::cout << "SPRT: elo0 " << sprtElo->first << ", elo1 " << sprtElo->second << ", bounds ["
+				<< std::setprecision(3) << lowerBound << ", " << upperBound << "]" << std::setprecision(6) << std::endl;
+		}
+
+		MatchScore matchScore;
+		int adjudicatedCount = 0;
+		std::optional<bool> sprtResult; // true once the alternative hypothesis is accepted, false once the null hypothesis is
+		std::atomic<bool> stop = false;
+		std::mutex resultMutex;
+		const auto startTime = std::chrono::steady_clock::now();
+
+		runConcurrently(gameCount, concurrency, [&](const size_t gameIndex) {
+			if (stop.load())
+			{
+				return;
+			}
+
+			// Each opening is played by both engines as white
+			const std::string& opening = openings[(gameIndex / 2) % openings.size()];
+			const bool engineAIsWhite = gameIndex % 2 == 0;
+			const GameResult result = playGame(opening, engines[engineAIsWhite ? 0 : 1], engines[engineAIsWhite ? 1 : 0], gameSettings);
+			const double engineAScore = engineAIsWhite ? result.whiteScore : 1.0 - result.whiteScore;
+
+			std::lock_guard<std::mutex> lock(resultMutex);
+			if (sprtResult.has_value())
+			{
+				return;
+			}
+
+			matchScore.wins += engineAScore == 1.0;
+			matchScore.draws += engineAScore == 0.5;
+			matchScore.losses += engineAScore == 0.0;
+			adjudicatedCount += result.adjudicated;
+
+			std::optional<double> logLikelihoodRatio;
+			if (sprtElo.has_value())
+			{
+				logLikelihoodRatio = getLogLikelihoodRatio(matchScore, sprtElo->first, sprtElo->second);
+				if (logLikelihoodRatio.value() >= upperBound || logLikelihoodRatio.value() <= lowerBound)
+				{
+					sprtResult = logLikelihoodRatio.value() >= upperBound;
+					stop.store(true);
+				}
+			}
+
+			if (matchScore.getGameCount() % MATCH_REPORT_INTERVAL == 0 && !sprtResult.has_value())
+			{
+				printMatchScore(matchScore, logLikelihoodRatio);
+			}
+		});
+
+		const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << std::endl;
+		printMatchScore(matchScore, sprtElo.has_value() ? std::optional<double>(getLogLikelihoodRatio(matchScore, sprtElo->first, sprtElo->second)) : std::nullopt);
+		std::cout << "Adjudicated " << adjudicatedCount << " games in " << std::fixed << std::setprecision(1) << elapsedSeconds << "s" << std::defaultfloat << std::endl;
+		if (sprtElo.has_value())
+		{
+			std::cout << "SPRT: " << (!sprtResult.has_value() ? "inconclusive" : sprtResult.value() ? "H1 accepted (A is stronger)" : "H0 accepted (A is not stronger)") << std::endl;
+		}
+
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Plays a match between two engine configurations, A and B, and reports the Elo difference of A over B.
+	 *
+	 * Usage: match [--games count] [--openings path] [--move-time milliseconds] [--concurrency count]
+	 *              [--evaluator name] [--evaluator-a name] [--evaluator-b name]
+	 *              [--param-a name=value]... [--param-b name=value]... [--parameters-a path] [--parameters-b path]
+	 *              [--sprt elo0 elo1] [--alpha alpha] [--beta beta] [--no-adjudication] [--seed seed]
+	 *
+	 * Games run concurrently in-process, one game per thread, without a client. Each opening is played twice with
+	 * colors reversed; openings are read one FEN string per line from the openings file, or created from random moves
+	 * if no file is given. Parameter files hold "name=value" lines, as written by the spsa command. With --sprt, the
+	 * match stops as soon as a sequential probability ratio test accepts either that A is elo0 stronger than B or that
+	 * it is elo1 stronger, with the false positive and false negative rates alpha and beta.
+	 *
+	 * \param args the command line arguments following the "match" command
+	 * \return process exit code
+	 */
+	int runTournament(const std::vector<std::string>& args);
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "trainingData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+namespace tools
+{
+	const size_t WRITER_BUFFER_SIZE = 4096; // records buffered before they are appended to the file
+
+	TrainingRecord encodeTrainingRecord(const ChessState& chessState, const search::Score score, const double result)
+	{
+		TrainingRecord record;
+		record.position = util::encodePosition(chessState);
+		record.score = (int16_t)std::clamp(score, (search::Score)INT16_MIN, (search::Score)INT16_MAX);
+		setTrainingResult(record, result);
+		return record;
+	}
+
+	ChessState decodeTrainingRecord(const TrainingRecord& record)
+	{
+		return util::decodePosition(record.position);
+	}
+
+	double getTrainingResult(const TrainingRecord& record)
+	{
+		return record.result / 2.0;
+	}
+
+	void setTrainingResult(TrainingRecord& record, const double result)
+	{
+		record.result = (uint8_t)std::lround(result * 2.0);
+	}
+
+	TrainingDataWriter::TrainingDataWriter(const std::string& path, const bool truncate) :
+		_output(path, std::ios::binary | (truncate ? std::ios::trunc : std::ios::app)),
+		_recordCount(0)
+	{
+		if (!_output)
+		{
+			const std::string exceptionMessage = "Unable to open training data file \"" + path + "\"";
+			throw std::exception(exceptionMessage.c_str());
+		}
+		_buffer.reserve(WRITER_BUFFER_SIZE);
+	}
+
+	TrainingDataWriter::~TrainingDataWriter()
+	{
+		flush();
+	}
+
+	void TrainingDataWriter::write(const TrainingRecord& record)
+	{
+		_buffer.push_back(record);
+		_recordCount++;
+		if (_buffer.size() >= WRITER_BUFFER_SIZE)
+		{
+			flush();
+		}
+	}
+
+	void TrainingDataWriter::flush()
+	{
+		_output.write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size() * sizeof(TrainingRecord));
+		_output.flush();
+		_buffer.clear();
+	}
+
+	size_t TrainingDataWriter::getRecordCount() const
+	{
+		return _recordCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../chess.h"
+#include "../search/score.h"
+#include "../util/packedPosition.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	const std::string TRAINING_DATA_EXTENSION = ".bin"; // positions files with this extension hold training records
+	#pragma pack(push, 1)
+	/**
+	 * A position labelled with its searched score and its game's result, packed into 32 bytes so datasets of hundreds
+	 * of millions of positions fit in a few gigabytes and are read without parsing.
+	 *
+	 * Training data files are headerless sequences of records in little-endian byte order, so they can be appended to
+	 * and concatenated, and are read through util::MappedRecordFile.
+	 */
+	struct TrainingRecord
+	{
+		util::PackedPosition position;
+		int16_t score; // white's searched score in centipawns
+		uint8_t result; // white's result: 0 for a loss, 1 for a draw and 2 for a win
+	};
+	#pragma pack(pop)
+	static_assert(sizeof(TrainingRecord) == 32, "TrainingRecord must stay 32 bytes");
+
+	/**
+	 * Packs a labelled position.
+	 *
+	 * \param chessState the position; must hold at most 32 pieces
+	 * \param score white's searched score of the position
+	 * \param result white's score from the game: 1 for a win, 0.5 for a draw and 0 for a loss
+	 * \return the packed position
+	 */
+	TrainingRecord encodeTrainingRecord(const ChessState& chessState, const search::Score score, const double result);
+
+	/**
+	 * Unpacks the position of a training record.
+	 *
+	 * \param record the packed position
+	 * \return the game state of the position
+	 */
+	ChessState decodeTrainingRecord(const TrainingRecord& record);
+
+	/**
+	 * Retrieves the game result of a training record.
+	 *
+	 * \param record the packed position
+	 * \return white's score from the game: 1 for a win, 0.5 for a draw and 0 for a loss
+	 */
+	double getTrainingResult(const TrainingRecord& record);
+
+	/**
+	 * Sets the game result of a training record.
+	 *
+	 * \param record the packed position
+	 * \param result white's score from the game: 1 for a win, 0.5 for a draw and 0 for a loss
+	 */
+	void setTrainingResult(TrainingRecord& record, const double result);
+
+	/**
+	 * Buffers training records and appends them to a training data file.
+	 */
+	class TrainingDataWriter
+	{
+	public:
+		TrainingDataWriter() = delete;
+		TrainingDataWriter(const TrainingDataWriter& source) = delete;
+
+		/**
+		 * Creates a new TrainingDataWriter, opening the file for appending.
+		 *
+		 * \param path the path of the training data file; created if it does not exist
+		 * \param truncate true to discard any records already in the file
+		 */
+		TrainingDataWriter(const std::string& path, const bool truncate = false);
+
+		/**
+		 * Destructs the writer, appending any buffered records.
+		 */
+		~TrainingDataWriter();
+
+		/**
+		 * Buffers a record, appending the buffer to the file once it is full.
+		 *
+		 * \param record the record being written
+		 */
+		void write(const TrainingRecord& record);
+
+		/**
+		 * Appends the buffered records to the file.
+		 */
+		void flush();
+
+		/**
+		 * Retrieves the number of records written by the writer.
+		 *
+		 * \return the number of records written, including buffered records
+		 */
+		size_t getRecordCount() const;
+
+	private:
+		std::ofstream _output;
+		std::vector<TrainingRecord> _buffer;
+		size_t _recordCount;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,797 @@
+#include "tuner.h"
+
+#include "trainingData.h"
+#include "../chess.h"
+#include "../move/move.h"
+#include "../move/moveUtil.h"
+#include "../move/moveLookupTable.h"
+#include "../search/staticExchange.h"
+#include "../search/searchParameters.h"
+#include "../search/searchStatistics.h"
+#include "../evaluation/evaluation.h"
+#include "../evaluation/evaluators.h"
+#include "../evaluation/pieceSquareTables.h"
+#include "../util/bitboard/bitboardUtil.h"
+#include "../util/fen.h"
+#include "../util/mappedRecordFile.h"
+#include "../util/threadPool.h"
+#include "../util/utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <thread>
+
+using search::Score;
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+using util::operator~;
+
+namespace tools
+{
+	const int DEFAULT_TUNING_EPOCHS = 1000;
+	const double DEFAULT_LEARNING_RATE = 1.0;
+	const std::string DEFAULT_TUNING_OUTPUT = "tunedPieceSquareTables.h";
+	const size_t LOAD_CHUNK_SIZE = 65536; // lines read from the file before they are resolved in parallel
+	const size_t TRAINING_DATA_CHUNKS_PER_THREAD = 4; // training data is split into more chunks than threads to balance their work
+	const int TUNING_QUIESCENCE_MAX_PLY = 16;
+	const int TUNING_REPORT_INTERVAL = 50; // epochs between progress reports
+
+	// Decay rates of the optimizer's moment estimates
+	const double FIRST_MOMENT_DECAY = 0.9, SECOND_MOMENT_DECAY = 0.999, MOMENT_EPSILON = 1e-8;
+
+	// Each phase's parameters are its piece values followed by the piece-square table of each piece type
+	const int PARAMETERS_PER_PHASE = PIECE_TYPE_COUNT + PIECE_TYPE_COUNT * evaluation::SQUARE_COUNT;
+	const int PARAMETER_COUNT = evaluation::GAME_PHASE_COUNT * PARAMETERS_PER_PHASE;
+
+	// A piece of a tuning position, packed as its color, type and index into its piece-square table
+	using TuningPiece = uint16_t;
+	const int TUNING_PIECE_TYPE_SHIFT = 6, TUNING_PIECE_COLOR_SHIFT = 9;
+
+	/**
+	 * The captures of the best line found by the tuner's quiescence search.
+	 */
+	struct CaptureLine
+	{
+		move::Move moves[TUNING_QUIESCENCE_MAX_PLY];
+		int length = 0;
+	};
+
+	/**
+	 * A labelled position reduced to the inputs of the tuned evaluation.
+	 */
+	struct TuningPosition
+	{
+		uint32_t firstPiece; // index of the position's first piece in TuningData::pieces
+		uint8_t pieceCount;
+		uint8_t phase; // capped at evaluation::MAX_PHASE
+		Score fixedScore; // white's score from the evaluation terms that are not tuned
+		float result; // white's score from the game: 1 for a win, 0.5 for a draw and 0 for a loss
+	};
+
+	/**
+	 * Labelled positions stored compactly enough to hold millions in memory.
+	 */
+	struct TuningData
+	{
+		std::vector<TuningPosition> positions;
+		std::vector<TuningPiece> pieces;
+		size_t skippedCount = 0; // lines that could not be parsed and positions in check or already decided
+	};
+
+	/**
+	 * Get the index of a piece value in the tuned parameters.
+	 *
+	 * \param phase the phase the value applies to
+	 * \param pieceType the type of the piece
+	 * \return the index of the parameter
+	 */
+	int getParameterIndex(const int phase, const int pieceType)
+	{
+		return phase * PARAMETERS_PER_PHASE + pieceType;
+	}
+
+	/**
+	 * Get the index of a piece-square table entry in the tuned parameters.
+	 *
+	 * \param phase the phase the table applies to
+	 * \param pieceType the type of the piece
+	 * \param tableIndex the index into the table; mirrored vertically for black pieces
+	 * \return the index of the parameter
+	 */
+	int getParameterIndex(const int phase, const int pieceType, const int tableIndex)
+	{
+		return phase * PARAMETERS_PER_PHASE + PIECE_TYPE_COUNT + pieceType * evaluation::SQUARE_COUNT + tableIndex;
+	}
+
+	/**
+	 * Parses a game result.
+	 *
+	 * \param token the result, optionally surrounded by brackets or quotes and followed by semicolons
+	 * \return white's score from the game, std::nullopt if the token is not a result
+	 */
+	std::optional<double> parseResult(std::string token)
+	{
+		token.erase(std::remove_if(token.begin(), token.end(), [](const char c) {
+			return c == '[' || c == ']' || c == '"' || c == ';';
+		}), token.end());
+
+		if (token == "1-0")
+		{
+			return 1.0;
+		}
+		if (token == "0-1")
+		{
+			return 0.0;
+		}
+		if (token == "1/2-1/2")
+		{
+			return 0.5;
+		}
+
+		try
+		{
+			size_t parsedLength;
+			const double result = std::stod(token, &parsedLength);
+			if (parsedLength == token.size() && result >= 0.0 && result <= 1.0)
+			{
+				return result;
+			}
+		}
+		catch (const std::exception&) {}
+
+		return std::nullopt;
+	}
+
+	/**
+	 * Splits a line of the positions file into a FEN string and a result.
+	 *
+	 * Lines with only the first four FEN fields, as in EPD files, are given a half turn count of 0 and a full turn
+	 * count of 1.
+	 *
+	 * \param line the line being parsed
+	 * \return the parsed FEN fields and white's score from the game, std::nullopt if the line is malformed
+	 */
+	std::optional<std::pair<util::FenPosition, double>> parseLine(const std::string& line)
+	{
+		static const char* WHITESPACE = " \t\r";
+
+		// The result is the last token of the line, and the FEN string everything before it
+		const size_t fenStart = line.find_first_not_of(WHITESPACE), resultEnd = line.find_last_not_of(WHITESPACE);
+		if (fenStart == std::string::npos)
+		{
+			return std::nullopt;
+		}
+		const size_t resultStart = line.find_last_of(WHITESPACE, resultEnd) + 1;
+		if (resultStart <= fenStart)
+		{
+			return std::nullopt;
+		}
+
+		const std::optional<double> result = parseResult(line.substr(resultStart, resultEnd + 1 - resultStart));
+		if (!result.has_value())
+		{
+			return std::nullopt;
+		}
+
+		util::FenPosition fenPosition;
+		size_t fenLength;
+		if (util::parseFenPrefix(std::string_view(line).substr(fenStart, resultStart - fenStart), fenPosition, fenLength))
+		{
+			return std::nullopt;
+		}
+
+		return std::make_pair(fenPosition, result.value());
+	}
+
+	/**
+	 * Searches captures from a game state until the position is quiet, keeping the best line of captures.
+	 *
+	 * Unlike the agent's quiescence search, evasions are not searched when in check; positions in check are skipped
+	 * when loading, and checks deeper in the capture sequence are rare.
+	 *
+	 * \param chessState game state
+	 * \param player the player whose turn it is
+	 * \param alpha the greatest value that can be guaranteed by the player
+	 * \param beta the greatest value that can be guaranteed by the enemy
+	 * \param ply the number of captures made since the labelled position
+	 * \param evaluator the evaluator scoring quiet positions
+	 * \param statistics the search statistics of the calling thread
+	 * \param line set to the best line of captures; empty if the game state is best left as it is
+	 * \return the score of the game state for the player
+	 */
+	Score getQuiescenceValue(const ChessState& chessState, const Color player, Score alpha, const Score beta, const int ply,
+		evaluation::AttackEvaluator& evaluator, search::SearchStatistics& statistics, CaptureLine& line)
+	{
+		const Score standPat = evaluator.evaluate(chessState, player, statistics);
+		line.length = 0;
+		if (standPat >= beta || ply >= TUNING_QUIESCENCE_MAX_PLY)
+		{
+			return standPat;
+		}
+
+		Score maxValue = standPat;
+		alpha = std::max(standPat, alpha);
+
+		// Captures are searched best exchange first, and captures that lose material are not searched
+		std::vector<std::pair<Score, move::Move>> captures;
+		for (const move::Move& move : move::getValidCaptures(chessState, player))
+		{
+			const Score exchangeValue = search::getStaticExchangeValue(chessState, player, move);
+			if (exchangeValue >= 0)
+			{
+				captures.emplace_back(exchangeValue, move);
+			}
+		}
+		std::stable_sort(captures.begin(), captures.end(), [](const std::pair<Score, move::Move>& left, const std::pair<Score, move::Move>& right) {
+			return left.first > right.first;
+		});
+
+		for (const auto& [exchangeValue, move] : captures)
+		{
+			ChessState gameCopy(chessState);
+			gameCopy.update(player, move, PieceType::QUEEN, false);
+
+			CaptureLine childLine;
+			const Score value = -getQuiescenceValue(gameCopy, ~player, -beta, -alpha, ply + 1, evaluator, statistics, childLine);
+			if (value > maxValue)
+			{
+				maxValue = value;
+				line.moves[0] = move;
+				std::copy(childLine.moves, childLine.moves + childLine.length, line.moves + 1);
+				line.length = childLine.length + 1;
+			}
+
+			alpha = std::max(value, alpha);
+			if (alpha >= beta)
+			{
+				break;
+			}
+		}
+
+		return maxValue;
+	}
+
+	/**
+	 * Resolves a labelled position to a quiet position and reduces it to the inputs of the tuned evaluation.
+	 *
+	 * \param chessState the labelled position
+	 * \param gameResult white's score from the position's game
+	 * \param evaluator the evaluator of the resolving thread
+	 * \param statistics the search statistics of the resolving thread
+	 * \param result the resolved positions the position is added to; counts the position as skipped if it is in check
+	 *               or its game has already been decided
+	 */
+	void addResolvedPosition(const ChessState& chessState, const double gameResult, evaluation::AttackEvaluator& evaluator, search::SearchStatistics& statistics, TuningData& result)
+	{
+		const Color player = chessState.getNextTurn();
+		if (player == Color::NEUTRAL || move::inCheck(player, chessState))
+		{
+			result.skippedCount++;
+			return;
+		}
+
+		// Only the best line is kept by the search, so the position it ends in is reached by playing it afterwards
+		CaptureLine line;
+		getQuiescenceValue(chessState, player, -search::SCORE_INFINITE, search::SCORE_INFINITE, 0, evaluator, statistics, line);
+		ChessState leaf(chessState);
+		Color leafPlayer = player;
+		for (int i = 0; i < line.length; i++)
+		{
+			leaf.update(leafPlayer, line.moves[i], PieceType::QUEEN, false);
+			leafPlayer = ~leafPlayer;
+		}
+
+		const BitboardSet& board = leaf.getBoard();
+		const Score value = evaluator.evaluate(leaf, leafPlayer, statistics);
+		const Score whiteValue = leafPlayer == Color::WHITE ? value : -value;
+
+		TuningPosition position;
+		position.firstPiece = (uint32_t)result.pieces.size();
+		position.phase = (uint8_t)std::min(board.getPhase(), evaluation::MAX_PHASE);
+		position.fixedScore = whiteValue - evaluation::getPieceSquareValue(board, Color::WHITE);
+		position.result = (float)gameResult;
+
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				while (pieceBoard)
+				{
+					const int positionIndex = popLsb(pieceBoard);
+					const int tableIndex = color == Color::WHITE ? positionIndex : positionIndex ^ (evaluation::SQUARE_COUNT - FILE_COUNT);
+					result.pieces.push_back((TuningPiece)((color << TUNING_PIECE_COLOR_SHIFT) | (pieceType << TUNING_PIECE_TYPE_SHIFT) | tableIndex));
+				}
+			}
+		}
+		position.pieceCount = (uint8_t)(result.pieces.size() - position.firstPiece);
+
+		result.positions.push_back(position);
+	}
+
+	/**
+	 * Resolves the labelled positions of lines of a positions file.
+	 *
+	 * \param lines the lines being resolved
+	 * \return the resolved positions
+	 */
+	TuningData resolvePositions(const std::span<const std::string> lines)
+	{
+		TuningData result;
+		evaluation::AttackEvaluator evaluator{ search::SearchParameters() };
+		search::SearchStatistics statistics;
+
+		for (const std::string& line : lines)
+		{
+			const std::optional<std::pair<util::FenPosition, double>> labelledPosition = parseLine(line);
+			if (!labelledPosition.has_value())
+			{
+				result.skippedCount++;
+				continue;
+			}
+
+			try
+			{
+				addResolvedPosition(ChessState(labelledPosition.value().first), labelledPosition.value().second, evaluator, statistics, result);
+			}
+			catch (const std::exception&)
+			{
+				result.skippedCount++;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Resolves the labelled positions of training records.
+	 *
+	 * \param records the records being resolved
+	 * \return the resolved positions
+	 */
+	TuningData resolvePositions(const std::span<const TrainingRecord> records)
+	{
+		TuningData result;
+		evaluation::AttackEvaluator evaluator{ search::SearchParameters() };
+		search::SearchStatistics statistics;
+
+		for (const TrainingRecord& record : records)
+		{
+			try
+			{
+				addResolvedPosition(decodeTrainingRecord(record), getTrainingResult(record), evaluator, statistics, result);
+			}
+			catch (const std::exception&)
+			{
+				result.skippedCount++;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Adds resolved positions to the loaded positions.
+	 *
+	 * \param resolvedPositions the positions being added
+	 * \param result the loaded positions, which the resolved positions are appended to
+	 */
+	void appendTuningData(const TuningData& resolvedPositions, TuningData& result)
+	{
+		const uint32_t pieceOffset = (uint32_t)result.pieces.size();
+		for (TuningPosition position : resolvedPositions.positions)
+		{
+			position.firstPiece += pieceOffset;
+			result.positions.push_back(position);
+		}
+		result.pieces.insert(result.pieces.end(), resolvedPositions.pieces.begin(), resolvedPositions.pieces.end());
+		result.skippedCount += resolvedPositions.skippedCount;
+	}
+
+	/**
+	 * Reads and resolves every labelled position in a text file, resolving chunks of lines in parallel.
+	 *
+	 * \param input the positions file
+	 * \return the resolved positions, in the order of the file
+	 */
+	TuningData loadTuningData(std::istream& input)
+	{
+		util::ThreadPool& threadPool = util::ThreadPool::getInstance();
+		const size_t taskCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		TuningData result;
+
+		std::vector<std::string> lines;
+		lines.reserve(LOAD_CHUNK_SIZE);
+		std::string line;
+		bool isEndOfFile = false;
+
+		while (!isEndOfFile)
+		{
+			lines.clear();
+			while (lines.size() < LOAD_CHUNK_SIZE && std::getline(input, line))
+			{
+				lines.push_back(line);
+			}
+			isEndOfFile = lines.size() < LOAD_CHUNK_SIZE;
+
+			std::vector<std::future<TuningData>> futures;
+			const size_t linesPerTask = (lines.size() + taskCount - 1) / taskCount;
+			for (size_t begin = 0; begin < lines.size(); begin += linesPerTask)
+			{
+				const size_t end = std::min(begin + linesPerTask, lines.size());
+				futures.push_back(threadPool.submit([&lines, begin, end]() {
+					return resolvePositions(std::span<const std::string>(lines.data() + begin, end - begin));
+				}));
+			}
+
+			for (std::future<TuningData>& future : futures)
+			{
+				appendTuningData(future.get(), result);
+			}
+
+			std::cout << "\rLoaded " << result.positions.size() << " positions" << std::flush;
+		}
+		std::cout << std::endl;
+
+		return result;
+	}
+
+	/**
+	 * Resolves every labelled position in a training data file, resolving chunks of the mapped file in parallel.
+	 *
+	 * \param trainingData the mapped training data file
+	 * \return the resolved positions, in the order of the file
+	 */
+	TuningData loadTuningData(const util::MappedRecordFile<TrainingRecord>& trainingData)
+	{
+		const size_t chunkCount = std::max<size_t>(1, std::thread::hardware_concurrency()) * TRAINING_DATA_CHUNKS_PER_THREAD;
+		std::vector<TuningData> resolvedChunks(chunkCount);
+		trainingData.parallelForEach(chunkCount, [&resolvedChunks](const std::span<const TrainingRecord> records, const size_t chunkIndex) {
+			resolvedChunks[chunkIndex] = resolvePositions(records);
+		});
+
+		TuningData result;
+		for (const TuningData& resolvedChunk : resolvedChunks)
+		{
+			appendTuningData(resolvedChunk, result);
+		}
+		std::cout << "Loaded " << result.positions.size() << " positions" << std::endl;
+
+		return result;
+	}
+
+	/**
+	 * Calculates white's score of a tuning position with the tuned parameters.
+	 *
+	 * \param data the tuning data containing the position
+	 * \param position the position being scored
+	 * \param parameters the tuned parameters
+	 * \return white's score in centipawns
+	 */
+	double getTunedValue(const TuningData& data, const TuningPosition& position, const std::vector<double>& parameters)
+	{
+		double middlegameValue = 0.0, endgameValue = 0.0;
+
+		for (uint32_t i = position.firstPiece; i < position.firstPiece + position.pieceCount; i++)
+		{
+			const TuningPiece piece = data.pieces[i];
+			const int color = piece >> TUNING_PIECE_COLOR_SHIFT;
+			const int pieceType = (piece >> TUNING_PIECE_TYPE_SHIFT) & 0x7;
+			const int tableIndex = piece & (evaluation::SQUARE_COUNT - 1);
+			const double sign = color == Color::WHITE ? 1.0 : -1.0;
+
+			middlegameValue += sign * (parameters[getParameterIndex(evaluation::MIDDLEGAME, pieceType)] + parameters[getParameterIndex(evaluation::MIDDLEGAME, pieceType, tableIndex)]);
+			endgameValue += sign * (parameters[getParameterIndex(evaluation::ENDGAME, pieceType)] + parameters[getParameterIndex(evaluation::ENDGAME, pieceType, tableIndex)]);
+		}
+
+		const double middlegameWeight = (double)position.phase / evaluation::MAX_PHASE;
+		return middlegameValue * middlegameWeight + endgameValue * (1.0 - middlegameWeight) + position.fixedScore;
+	}
+
+	/**
+	 * Converts a score to the expected result of the game.
+	 *
+	 * \param value white's score in centipawns
+	 * \param scalingConstant scales scores to the range in which the results change
+	 * \return white's expected score from the game, between 0 and 1
+	 */
+	double getExpectedResult(const double value, const double scalingConstant)
+	{
+		return 1.0 / (1.0 + std::pow(10.0, -scalingConstant * value / 400.0));
+	}
+
+	/**
+	 * Sums the squared errors of a range of tuning positions and, optionally, their gradient.
+	 *
+	 * \param data the tuning data
+	 * \param parameters the tuned parameters
+	 * \param scalingConstant scales scores to the range in which the results change
+	 * \param begin the index of the first position
+	 * \param end the index after the last position
+	 * \param gradient if not null, the gradient of the summed error is added to it
+	 * \return the summed squared error
+	 */
+	double getError(const TuningData& data, const std::vector<double>& parameters, const double scalingConstant, const size_t begin, const size_t end,
+		std::vector<double>* gradient)
+	{
+		const double sigmoidScale = std::log(10.0) * scalingConstant / 400.0;
+		double error = 0.0;
+
+		for (size_t positionIndex = begin; positionIndex < end; positionIndex++)
+		{
+			const TuningPosition& position = data.positions[positionIndex];
+			const double expectedResult = getExpectedResult(getTunedValue(data, position, parameters), scalingConstant);
+			const double difference = position.result - expectedResult;
+			error += difference * difference;
+
+			if (gradient == nullptr)
+			{
+				continue;
+			}
+
+			// Derivative of the squared error with respect to the score
+			const double valueGradient = -2.0 * difference * expectedResult * (1.0 - expectedResult) * sigmoidScale;
+			const double middlegameWeight = (double)position.phase / evaluation::MAX_PHASE;
+			for (uint32_t i = position.firstPiece; i < position.firstPiece + position.pieceCount; i++)
+			{
+				const TuningPiece piece = data.pieces[i];
+				const int pieceType = (piece >> TUNING_PIECE_TYPE_SHIFT) & 0x7;
+				const int tableIndex = piece & (evaluation::SQUARE_COUNT - 1);
+				const double sign = (piece >> TUNING_PIECE_COLOR_SHIFT) == Color::WHITE ? 1.0 : -1.0;
+				const double middlegameGradient = sign * valueGradient * middlegameWeight;
+				const double endgameGradient = sign * valueGradient * (1.0 - middlegameWeight);
+
+				(*gradient)[getParameterIndex(evaluation::MIDDLEGAME, pieceType)] += middlegameGradient;
+				(*gradient)[getParameterIndex(evaluation::MIDDLEGAME, pieceType, tableIndex)] += middlegameGradient;
+				(*gradient)[getParameterIndex(evaluation::ENDGAME, pieceType)] += endgameGradient;
+				(*gradient)[getParameterIndex(evaluation::ENDGAME, pieceType, tableIndex)] += endgameGradient;
+			}
+		}
+
+		return error;
+	}
+
+	/**
+	 * Calculates the mean squared error of every tuning position and, optionally, its gradient, splitting the
+	 * positions into a chunk per core.
+	 *
+	 * \param data the tuning data
+	 * \param parameters the tuned parameters
+	 * \param scalingConstant scales scores to the range in which the results change
+	 * \param gradient if not null, set to the gradient of the mean squared error
+	 * \return the mean squared error
+	 */
+	double getMeanError(const TuningData& data, const std::vector<double>& parameters, const double scalingConstant, std::vector<double>* gradient = nullptr)
+	{
+		util::ThreadPool& threadPool = util::ThreadPool::getInstance();
+		const size_t positionCount = data.positions.size();
+		const size_t taskCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		const size_t positionsPerTask = (positionCount + taskCount - 1) / taskCount;
+		const bool isGradientNeeded = gradient != nullptr;
+
+		std::vector<std::future<std::pair<double, std::vector<double>>>> futures;
+		for (size_t begin = 0; begin < positionCount; begin += positionsPerTask)
+		{
+			const size_t end = std::min(begin + positionsPerTask, positionCount);
+			futures.push_back(threadPool.submit([&data, &parameters, scalingConstant, begin, end, isGradientNeeded]() {
+				std::vector<double> taskGradient(isGradientNeeded ? PARAMETER_COUNT : 0, 0.0);
+				const double error = getError(data, parameters, scalingConstant, begin, end, isGradientNeeded ? &taskGradient : nullptr);
+				return std::make_pair(error, std::move(taskGradient));
+			}));
+		}
+
+		if (isGradientNeeded)
+		{
+			gradient->assign(PARAMETER_COUNT, 0.0);
+		}
+
+		double error = 0.0;
+		for (std::future<std::pair<double, std::vector<double>>>& future : futures)
+		{
+			const std::pair<double, std::vector<double>> taskResult = future.get();
+			error += taskResult.first;
+			for (size_t i = 0; i < taskResult.second.size(); i++)
+			{
+				(*gradient)[i] += taskResult.second[i] / positionCount;
+			}
+		}
+
+		return error / positionCount;
+	}
+
+	/**
+	 * Finds the scaling constant that best fits the current evaluation to the results, narrowing the step of a
+	 * line search each round.
+	 *
+	 * \param data the tuning data
+	 * \param parameters the current parameters
+	 * \return the scaling constant with the lowest mean squared error
+	 */
+	double fitScalingConstant(const TuningData& data, const std::vector<double>& parameters)
+	{
+		static const int ROUND_COUNT = 3, STEPS_PER_SIDE = 10;
+
+		double bestConstant = 1.0, step = 0.1;
+		double bestError = getMeanError(data, parameters, bestConstant);
+
+		for (int round = 0; round < ROUND_COUNT; round++)
+		{
+			const double center = bestConstant;
+			for (int i = -STEPS_PER_SIDE; i <= STEPS_PER_SIDE; i++)
+			{
+				const double scalingConstant = center + i * step;
+				if (i == 0 || scalingConstant <= 0.0)
+				{
+					continue;
+				}
+
+				const double error = getMeanError(data, parameters, scalingConstant);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestConstant = scalingConstant;
+				}
+			}
+			step /= STEPS_PER_SIDE;
+		}
+
+		return bestConstant;
+	}
+
+	/**
+	 * Writes the tuned parameters as a header in the layout of evaluation/pieceSquareTables.h.
+	 *
+	 * \param output the stream the header is written to
+	 * \param parameters the tuned parameters
+	 * \param positionCount the number of positions the parameters were tuned on
+	 * \param error the final mean squared error
+	 */
+	void writeTunedTables(std::ostream& output, const std::vector<double>& parameters, const size_t positionCount, const double error)
+	{
+		output << "#pragma once" << std::endl << std::endl;
+		output << "#include \"pieceSquareTables.h\"" << std::endl << std::endl;
+		output << "namespace evaluation" << std::endl << "{" << std::endl;
+		output << "\t// Tuned on " << positionCount << " positions to a mean squared error of " << std::setprecision(6) << error << std::endl;
+		output << "\tconstexpr Score TUNED_PIECE_VALUES[GAME_PHASE_COUNT][PIECE_TYPE_COUNT] = {" << std::endl;
+		for (int phase = evaluation::MIDDLEGAME; phase < evaluation::GAME_PHASE_COUNT; phase++)
+		{
+			output << "\t\t{ ";
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				output << std::lround(parameters[getParameterIndex(phase, pieceType)]) << (pieceType + 1 < PIECE_TYPE_COUNT ? ", " : " }");
+			}
+			output << (phase + 1 < evaluation::GAME_PHASE_COUNT ? "," : "") << std::endl;
+		}
+		output << "\t};" << std::endl << std::endl;
+
+		output << "\tconstexpr Score TUNED_PIECE_SQUARE_TABLES[GAME_PHASE_COUNT][PIECE_TYPE_COUNT][SQUARE_COUNT] = {" << std::endl;
+		for (int phase = evaluation::MIDDLEGAME; phase < evaluation::GAME_PHASE_COUNT; phase++)
+		{
+			output << "\t\t{" << std::endl;
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				output << "\t\t\t{" << std::endl;
+				for (int y = 0; y < RANK_COUNT; y++)
+				{
+					output << "\t\t\t\t";
+					for (int x = 0; x < FILE_COUNT; x++)
+					{
+						const int tableIndex = y * FILE_COUNT + x;
+						output << std::lround(parameters[getParameterIndex(phase, pieceType, tableIndex)]) << (x + 1 < FILE_COUNT ? ", " : "");
+					}
+					output << (y + 1 < RANK_COUNT ? "," : "") << std::endl;
+				}
+				output << "\t\t\t}" << (pieceType + 1 < PIECE_TYPE_COUNT ? "," : "") << std::endl;
+			}
+			output << "\t\t}" << (phase + 1 < evaluation::GAME_PHASE_COUNT ? "," : "") << std::endl;
+		}
+		output << "\t};" << std::endl << "}";
+	}
+
+	int runTuner(const std::vector<std::string>& args)
+	{
+		if (args.empty())
+		{
+			std::cout << "Usage: tune <positions file> [--epochs count] [--learning-rate rate] [--output path]" << std::endl;
+			return 1;
+		}
+
+		int epochCount = DEFAULT_TUNING_EPOCHS;
+		double learningRate = DEFAULT_LEARNING_RATE;
+		std::string outputPath = DEFAULT_TUNING_OUTPUT;
+		for (size_t argIndex = 1; argIndex + 1 < args.size(); argIndex += 2)
+		{
+			if (args[argIndex] == "--epochs")
+			{
+				epochCount = std::stoi(args[argIndex + 1]);
+			}
+			else if (args[argIndex] == "--learning-rate")
+			{
+				learningRate = std::stod(args[argIndex + 1]);
+			}
+			else if (args[argIndex] == "--output")
+			{
+				outputPath = args[argIndex + 1];
+			}
+		}
+
+		std::ifstream input(args[0]);
+		if (!input)
+		{
+			std::cout << "Unable to open positions file: " << args[0] << std::endl;
+			return 1;
+		}
+
+		move::populateLookupTables();
+
+		auto startTime = std::chrono::steady_clock::now();
+		const TuningData data = args[0].ends_with(TRAINING_DATA_EXTENSION)
+			? loadTuningData(util::MappedRecordFile<TrainingRecord>(args[0]))
+			: loadTuningData(input);
+		std::cout << "Resolved " << data.positions.size() << " positions, skipped " << data.skippedCount << " in "
+			<< std::fixed << std::setprecision(1) << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << "s" << std::endl;
+		if (data.positions.empty())
+		{
+			return 1;
+		}
+
+		std::vector<double> parameters(PARAMETER_COUNT);
+		for (int phase = evaluation::MIDDLEGAME; phase < evaluation::GAME_PHASE_COUNT; phase++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				parameters[getParameterIndex(phase, pieceType)] = evaluation::PIECE_VALUES[phase][pieceType];
+				for (int tableIndex = 0; tableIndex < evaluation::SQUARE_COUNT; tableIndex++)
+				{
+					parameters[getParameterIndex(phase, pieceType, tableIndex)] = evaluation::PIECE_SQUARE_TABLES[phase][pieceType][tableIndex];
+				}
+			}
+		}
+
+		const double scalingConstant = fitScalingConstant(data, parameters);
+		std::cout << "Scaling constant: " << std::setprecision(3) << scalingConstant << std::endl;
+		std::cout << "Initial error: " << std::setprecision(6) << getMeanError(data, parameters, scalingConstant) << std::endl;
+
+		std::vector<double> gradient, firstMoments(PARAMETER_COUNT, 0.0), secondMoments(PARAMETER_COUNT, 0.0);
+		double error = 0.0;
+		startTime = std::chrono::steady_clock::now();
+		for (int epoch = 1; epoch <= epochCount; epoch++)
+		{
+			error = getMeanError(data, parameters, scalingConstant, &gradient);
+
+			for (int i = 0; i < PARAMETER_COUNT; i++)
+			{
+				// The king's value cancels out, so it is left at 0
+				if (i % PARAMETERS_PER_PHASE == PieceType::KING)
+				{
+					continue;
+				}
+
+				firstMoments[i] = FIRST_MOMENT_DECAY * firstMoments[i] + (1.0 - FIRST_MOMENT_DECAY) * gradient[i];
+				secondMoments[i] = SECOND_MOMENT_DECAY * secondMoments[i] + (1.0 - SECOND_MOMENT_DECAY) * gradient[i] * gradient[i];
+				const double correctedFirstMoment = firstMoments[i] / (1.0 - std::pow(FIRST_MOMENT_DECAY, epoch));
+				const double correctedSecondMoment = secondMoments[i] / (1.0 - std::pow(SECOND_MOMENT_DECAY, epoch));
+				parameters[i] -= learningRate * correctedFirstMoment / (std::sqrt(correctedSecondMoment) + MOMENT_EPSILON);
+			}
+
+			if (epoch % TUNING_REPORT_INTERVAL == 0 || epoch == epochCount)
+			{
+				std::cout << "Epoch " << epoch << ": error " << std::setprecision(6) << error << " ("
+					<< std::setprecision(1) << std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() << "s)" << std::endl;
+			}
+		}
+
+		std::ofstream output(outputPath);
+		writeTunedTables(output, parameters, data.positions.size(), getMeanError(data, parameters, scalingConstant));
+		std::cout << "Wrote tuned tables to " << outputPath << std::endl;
+
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tools
+{
+	/**
+	 * Tunes the piece values and piece-square tables against a file of labelled positions by minimizing the error
+	 * between each position's evaluation and its game's result.
+	 *
+	 * Usage: tune <positions file> [--epochs count] [--learning-rate rate] [--output path]
+	 *
+	 * Each line of the file holds a FEN string followed by the result of the game it was taken from, written as
+	 * "1-0", "0-1" or "1/2-1/2", or as white's score between 0 and 1, optionally in brackets or quotes. Positions are
+	 * resolved to the quiet position at the end of a capture search before tuning, and positions in check are skipped.
+	 * Files ending in TRAINING_DATA_EXTENSION are read as training records written by the datagen command instead.
+	 * The tuned tables are written as a header in the layout of evaluation/pieceSquareTables.h.
+	 *
+	 * \param args the command line arguments following the "tune" command
+	 * \return process exit code
+	 */
+	int runTuner(const std::vector<std::string>& args);
+}
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "../../constants.h"
 #include "bitboardUtil.h"
+#include "../zobrist.h"
+#include "../../move/moveLookupTable.h"
+
+#include <bit>
 
 using std::cout;
 using std::endl;
@@ -20,8 +24,21 @@ namespace util
 					_bitboards[color][pieceType] = 0;
 				}
 				_colorOccupancyBoards[color] = 0;
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] = 0;
+				_pieceSquareScores[evaluation::ENDGAME][color] = 0;
 			}
 			_allOccupancyBoard = 0;
+			_zobristKey = 0;
+			_pawnZobristKey = 0;
+			_phase = 0;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_attackBoards[color] = 0;
+				_sliderAttackBoards[color] = 0;
+				_checkers[color] = 0;
+				_sliderAttackBoardsValid[color] = true;
+			}
+			_attackBoardsValid = true;
 		}
 
 		BitboardSet::BitboardSet(const BitboardSet& source)
@@ -33,8 +50,21 @@ namespace util
 					_bitboards[color][pieceType] = source._bitboards[color][pieceType];
 				}
 				_colorOccupancyBoards[color] = source._colorOccupancyBoards[color];
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] = source._pieceSquareScores[evaluation::MIDDLEGAME][color];
+				_pieceSquareScores[evaluation::ENDGAME][color] = source._pieceSquareScores[evaluation::ENDGAME][color];
 			}
 			_allOccupancyBoard = source._allOccupancyBoard;
+			_zobristKey = source._zobristKey;
+			_pawnZobristKey = source._pawnZobristKey;
+			_phase = source._phase;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_attackBoards[color] = source._attackBoards[color];
+				_sliderAttackBoards[color] = source._sliderAttackBoards[color];
+				_checkers[color] = source._checkers[color];
+				_sliderAttackBoardsValid[color] = source._sliderAttackBoardsValid[color];
+			}
+			_attackBoardsValid = source._attackBoardsValid;
 		}
 
 		Bitboard BitboardSet::getBitboard(const Color color, const PieceType pieceType) const
@@ -42,6 +72,41 @@ namespace util
 			return _bitboards[color][pieceType];
 		}
 
+		uint64_t BitboardSet::getZobristKey() const
+		{
+			return _zobristKey;
+		}
+
+		uint64_t BitboardSet::getPawnZobristKey() const
+		{
+			return _pawnZobristKey;
+		}
+
+		evaluation::Score BitboardSet::getPieceSquareScore(const evaluation::GamePhase phase, const Color color) const
+		{
+			return _pieceSquareScores[phase][color];
+		}
+
+		int BitboardSet::getPhase() const
+		{
+			return _phase;
+		}
+
+		Bitboard BitboardSet::getAttackBoard(const Color color) const
+		{
+			return _attackBoardsValid ? _attackBoards[color] : calculateAttackBoard(color);
+		}
+
+		Bitboard BitboardSet::getCheckers(const Color color) const
+		{
+			return _attackBoardsValid ? _checkers[color] : calculateCheckers(color);
+		}
+
+		Bitboard BitboardSet::calculateAttackBoard(const Color color) const
+		{
+			return calculateLeaperAttackBoard(color) | calculateSliderAttackBoard(color);
+		}
+
 		Bitboard BitboardSet::getOccupancyBoard() const
 		{
 			return _allOccupancyBoard;
@@ -187,6 +252,13 @@ namespace util
 			_bitboards[Color::BLACK][PieceType::KING] = 0x000000000000010;
 
 			updateOccupancyBoards();
+			updateZobristKey();
+			updatePieceSquareScores();
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_sliderAttackBoardsValid[color] = false;
+			}
+			_attackBoardsValid = false;
 		}
 
 		void BitboardSet::clearPos(const int x, const int y)
@@ -197,6 +269,10 @@ namespace util
 			{
 				for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
 				{
+					const Bitboard removedBoard = _bitboards[color][pieceType] & ~binaryPosition;
+					toggleZobristKeys((Color)color, (PieceType)pieceType, removedBoard);
+					invalidateAttackBoards((Color)color, (PieceType)pieceType, removedBoard);
+					updatePieceSquareScores((Color)color, (PieceType)pieceType, removedBoard, false);
 					_bitboards[color][pieceType] &= binaryPosition;
 				}
 			}
@@ -214,6 +290,10 @@ namespace util
 
 			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
 			{
+				const Bitboard removedBoard = _bitboards[color][pieceType] & ~binaryPosition;
+				toggleZobristKeys(color, (PieceType)pieceType, removedBoard);
+				invalidateAttackBoards(color, (PieceType)pieceType, removedBoard);
+				updatePieceSquareScores(color, (PieceType)pieceType, removedBoard, false);
 				_bitboards[color][pieceType] &= binaryPosition;
 			}
 			updateOccupancyBoards(color);
@@ -226,7 +306,12 @@ namespace util
 
 		void BitboardSet::clearPos(const int x, const int y, const Color color, const PieceType pieceType)
 		{
-			_bitboards[color][pieceType] &= ~positionToBitboard(x, y);
+			const Bitboard binaryPosition = positionToBitboard(x, y);
+			const Bitboard removedBoard = _bitboards[color][pieceType] & binaryPosition;
+			toggleZobristKeys(color, pieceType, removedBoard);
+			invalidateAttackBoards(color, pieceType, removedBoard);
+			updatePieceSquareScores(color, pieceType, removedBoard, false);
+			_bitboards[color][pieceType] &= ~binaryPosition;
 			updateOccupancyBoards(color);
 		}
 
@@ -244,13 +329,31 @@ namespace util
 					_bitboards[color][pieceType] &= 0;
 				}
 				_colorOccupancyBoards[color] = 0;
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] = 0;
+				_pieceSquareScores[evaluation::ENDGAME][color] = 0;
 			}
 			_allOccupancyBoard = 0;
+			_zobristKey = 0;
+			_pawnZobristKey = 0;
+			_phase = 0;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_attackBoards[color] = 0;
+				_sliderAttackBoards[color] = 0;
+				_checkers[color] = 0;
+				_sliderAttackBoardsValid[color] = true;
+			}
+			_attackBoardsValid = true;
 		}
 
 		void BitboardSet::addPiece(const int x, const int y, const Color color, const PieceType pieceType)
 		{
-			_bitboards[color][pieceType] |= positionToBitboard(x, y);
+			const Bitboard binaryPosition = positionToBitboard(x, y);
+			const Bitboard addedBoard = ~_bitboards[color][pieceType] & binaryPosition;
+			toggleZobristKeys(color, pieceType, addedBoard);
+			invalidateAttackBoards(color, pieceType, addedBoard);
+			updatePieceSquareScores(color, pieceType, addedBoard, true);
+			_bitboards[color][pieceType] |= binaryPosition;
 			updateOccupancyBoards(color);
 		}
 
@@ -259,6 +362,31 @@ namespace util
 			addPiece(pos.x, pos.y, color, pieceType);
 		}
 
+		void BitboardSet::updateAttackBoards()
+		{
+			if (_attackBoardsValid)
+			{
+				return;
+			}
+
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				if (!_sliderAttackBoardsValid[color])
+				{
+					_sliderAttackBoards[color] = calculateSliderAttackBoard((Color)color);
+					_sliderAttackBoardsValid[color] = true;
+				}
+				_attackBoards[color] = calculateLeaperAttackBoard((Color)color) | _sliderAttackBoards[color];
+			}
+
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				const Color enemyColor = color == Color::WHITE ? Color::BLACK : Color::WHITE;
+				_checkers[color] = (_attackBoards[enemyColor] & _bitboards[color][PieceType::KING]) ? calculateCheckers((Color)color) : 0;
+			}
+			_attackBoardsValid = true;
+		}
+
 		BitboardSet& BitboardSet::operator=(const BitboardSet& rightOperand)
 		{
 			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
@@ -268,8 +396,21 @@ namespace util
 					_bitboards[color][pieceType] = rightOperand._bitboards[color][pieceType];
 				}
 				_colorOccupancyBoards[color] = rightOperand._colorOccupancyBoards[color];
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] = rightOperand._pieceSquareScores[evaluation::MIDDLEGAME][color];
+				_pieceSquareScores[evaluation::ENDGAME][color] = rightOperand._pieceSquareScores[evaluation::ENDGAME][color];
 			}
 			_allOccupancyBoard = rightOperand._allOccupancyBoard;
+			_zobristKey = rightOperand._zobristKey;
+			_pawnZobristKey = rightOperand._pawnZobristKey;
+			_phase = rightOperand._phase;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_attackBoards[color] = rightOperand._attackBoards[color];
+				_sliderAttackBoards[color] = rightOperand._sliderAttackBoards[color];
+				_checkers[color] = rightOperand._checkers[color];
+				_sliderAttackBoardsValid[color] = rightOperand._sliderAttackBoardsValid[color];
+			}
+			_attackBoardsValid = rightOperand._attackBoardsValid;
 
 			return *this;
 		}
@@ -322,5 +463,138 @@ namespace util
 			}
 			_allOccupancyBoard = _colorOccupancyBoards[Color::WHITE] | _colorOccupancyBoards[Color::BLACK];
 		}
+
+		void BitboardSet::updateZobristKey()
+		{
+			_zobristKey = 0;
+			_pawnZobristKey = 0;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+				{
+					toggleZobristKeys((Color)color, (PieceType)pieceType, _bitboards[color][pieceType]);
+				}
+			}
+		}
+
+		void BitboardSet::toggleZobristKeys(const Color color, const PieceType pieceType, Bitboard changedBoard)
+		{
+			while (changedBoard)
+			{
+				const uint64_t key = zobrist::KEYS.pieces[color][pieceType][popLsb(changedBoard)];
+				_zobristKey ^= key;
+				if (pieceType == PieceType::PAWN)
+				{
+					_pawnZobristKey ^= key;
+				}
+			}
+		}
+
+		void BitboardSet::updatePieceSquareScores()
+		{
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] = 0;
+				_pieceSquareScores[evaluation::ENDGAME][color] = 0;
+			}
+			_phase = 0;
+
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+				{
+					updatePieceSquareScores((Color)color, (PieceType)pieceType, _bitboards[color][pieceType], true);
+				}
+			}
+		}
+
+		void BitboardSet::updatePieceSquareScores(const Color color, const PieceType pieceType, Bitboard changedBoard, const bool isAdded)
+		{
+			const int sign = isAdded ? 1 : -1;
+
+			while (changedBoard)
+			{
+				const int positionIndex = popLsb(changedBoard);
+				_pieceSquareScores[evaluation::MIDDLEGAME][color] += sign * evaluation::PIECE_SQUARE_VALUES.values[evaluation::MIDDLEGAME][color][pieceType][positionIndex];
+				_pieceSquareScores[evaluation::ENDGAME][color] += sign * evaluation::PIECE_SQUARE_VALUES.values[evaluation::ENDGAME][color][pieceType][positionIndex];
+				_phase += sign * evaluation::PHASE_WEIGHTS[pieceType];
+			}
+		}
+
+		void BitboardSet::invalidateAttackBoards(const Color color, const PieceType pieceType, const Bitboard changedBoard)
+		{
+			if (!changedBoard)
+			{
+				return;
+			}
+
+			const bool isSlider = pieceType == PieceType::BISHOP || pieceType == PieceType::ROOK || pieceType == PieceType::QUEEN;
+			for (int attackerColor = Color::WHITE; attackerColor < COLOR_COUNT; attackerColor++)
+			{
+				if ((isSlider && attackerColor == color) || (changedBoard & _sliderAttackBoards[attackerColor]))
+				{
+					_sliderAttackBoardsValid[attackerColor] = false;
+				}
+			}
+			_attackBoardsValid = false;
+		}
+
+		Bitboard BitboardSet::calculateSliderAttackBoard(const Color color) const
+		{
+			Bitboard attackBoard = 0;
+
+			Bitboard diagonalSliders = _bitboards[color][PieceType::BISHOP] | _bitboards[color][PieceType::QUEEN];
+			while (diagonalSliders)
+			{
+				attackBoard |= move::getBishopMoveBoard(popLsb(diagonalSliders), _allOccupancyBoard);
+			}
+
+			Bitboard straightSliders = _bitboards[color][PieceType::ROOK] | _bitboards[color][PieceType::QUEEN];
+			while (straightSliders)
+			{
+				attackBoard |= move::getRookMoveBoard(popLsb(straightSliders), _allOccupancyBoard);
+			}
+
+			return attackBoard;
+		}
+
+		Bitboard BitboardSet::calculateLeaperAttackBoard(const Color color) const
+		{
+			Bitboard attackBoard = getPawnAttacks(_bitboards[color][PieceType::PAWN], color);
+
+			Bitboard knights = _bitboards[color][PieceType::KNIGHT];
+			while (knights)
+			{
+				attackBoard |= move::getKnightMoveBoard(popLsb(knights));
+			}
+
+			Bitboard king = _bitboards[color][PieceType::KING];
+			if (king)
+			{
+				attackBoard |= move::getKingMoveBoard(popLsb(king));
+			}
+
+			return attackBoard;
+		}
+
+		Bitboard BitboardSet::calculateCheckers(const Color color) const
+		{
+			const Bitboard kingBoard = _bitboards[color][PieceType::KING];
+			if (!kingBoard)
+			{
+				return 0;
+			}
+
+			const Color enemyColor = color == Color::WHITE ? Color::BLACK : Color::WHITE;
+			const Bitboard (&enemyBitboards)[PIECE_TYPE_COUNT] = _bitboards[enemyColor];
+			const int kingPositionIndex = std::countr_zero(kingBoard);
+
+			// Attacks are symmetric, so the king is attacked from wherever it would attack a piece of the same type
+			return (getPawnAttacks(kingBoard, color) & enemyBitboards[PieceType::PAWN])
+				| (move::getKnightMoveBoard(kingPositionIndex) & enemyBitboards[PieceType::KNIGHT])
+				| (move::getBishopMoveBoard(kingPositionIndex, _allOccupancyBoard) & (enemyBitboards[PieceType::BISHOP] | enemyBitboards[PieceType::QUEEN]))
+				| (move::getRookMoveBoard(kingPositionIndex, _allOccupancyBoard) & (enemyBitboards[PieceType::ROOK] | enemyBitboards[PieceType::QUEEN]))
+				| (move::getKingMoveBoard(kingPositionIndex) & enemyBitboards[PieceType::KING]);
+		}
 	}
 }
\ No newline at end of file
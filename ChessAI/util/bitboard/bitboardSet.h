@@ -4,6 +4,7 @@
 
 #include "../position.h"
 #include "../../enum.h"
+#include "../../evaluation/pieceSquareTables.h"
 
 using Bitboard = uint64_t;
 
@@ -131,6 +132,64 @@ namespace util
 			 */
 			bool posIsOccupied(const Position& pos, const Color color, const PieceType pieceType) const;
 
+			/**
+			 * Retrieves the Zobrist hash of the pieces on the board.
+			 *
+			 * \return the XOR of the Zobrist keys of every piece and its position
+			 */
+			uint64_t getZobristKey() const;
+
+			/**
+			 * Retrieves the Zobrist hash of the pawns on the board.
+			 *
+			 * \return the XOR of the Zobrist keys of every pawn and its position
+			 */
+			uint64_t getPawnZobristKey() const;
+
+			/**
+			 * Retrieves the sum of the values of a color's pieces and their positional bonuses.
+			 *
+			 * \param phase the stage of the game the values are taken from
+			 * \param color the color of the pieces
+			 * \return the material and piece-square score of the color's pieces in centipawns
+			 */
+			evaluation::Score getPieceSquareScore(const evaluation::GamePhase phase, const Color color) const;
+
+			/**
+			 * Retrieves the phase of the game based on the non-pawn material on the board.
+			 *
+			 * \return evaluation::MAX_PHASE in the starting position, falling towards 0 as pieces are captured
+			 */
+			int getPhase() const;
+
+			/**
+			 * Retrieves the positions attacked by a color's pieces, including positions occupied by its own pieces.
+			 *
+			 * Calculated from scratch if the board has changed since the last call to updateAttackBoards().
+			 *
+			 * \param color the color of the attacking pieces
+			 * \return bitboard of the attacked positions
+			 */
+			Bitboard getAttackBoard(const Color color) const;
+
+			/**
+			 * Retrieves the enemy pieces attacking a color's king.
+			 *
+			 * Calculated from scratch if the board has changed since the last call to updateAttackBoards().
+			 *
+			 * \param color the color of the king
+			 * \return bitboard of the pieces giving check; empty if the king is not in check
+			 */
+			Bitboard getCheckers(const Color color) const;
+
+			/**
+			 * Calculates the positions attacked by a color's pieces without using the maintained attack boards.
+			 *
+			 * \param color the color of the attacking pieces
+			 * \return bitboard of the attacked positions
+			 */
+			Bitboard calculateAttackBoard(const Color color) const;
+
 			/**
 			 * Retieves the PieceType at the specified position.
 			 *
@@ -256,6 +315,15 @@ namespace util
 			 */
 			void addPiece(const Position& pos, const Color color, const PieceType pieceType);
 
+			/**
+			 * Brings the attack boards and checkers up to date with the pieces on the board.
+			 *
+			 * Only the slider attacks of a color whose rays were affected by the changes since the last update are
+			 * recalculated.
+			 *
+			 */
+			void updateAttackBoards();
+
 			/* ----- Operators ----- */
 			/**
 			 * Assigns the calling object to the right operand.
@@ -295,9 +363,85 @@ namespace util
 			 */
 			void updateOccupancyBoards(const Color color);
 
+			/**
+			 * Recalculate the Zobrist keys from the bitboards.
+			 *
+			 */
+			void updateZobristKey();
+
+			/**
+			 * Recalculate the piece-square scores and the game phase from the bitboards.
+			 *
+			 */
+			void updatePieceSquareScores();
+
+			/**
+			 * Add or subtract the piece-square scores and phase weights of pieces being added to or removed from the board.
+			 *
+			 * \param color the color of the pieces
+			 * \param pieceType the type of the pieces
+			 * \param changedBoard bitboard of the positions the pieces are being added to or removed from
+			 * \param isAdded true if the pieces are being added, false if they are being removed
+			 */
+			void updatePieceSquareScores(const Color color, const PieceType pieceType, Bitboard changedBoard, const bool isAdded);
+
+			/**
+			 * Toggle the Zobrist keys of pieces being added to or removed from the board.
+			 *
+			 * \param color the color of the pieces
+			 * \param pieceType the type of the pieces
+			 * \param changedBoard bitboard of the positions the pieces are being added to or removed from
+			 */
+			void toggleZobristKeys(const Color color, const PieceType pieceType, Bitboard changedBoard);
+
+			/**
+			 * Invalidate the attack boards affected by pieces being added to or removed from the board.
+			 *
+			 * A color's slider attacks are only invalidated if the pieces are its own sliders or lie on one of its rays,
+			 * since any piece blocking or unblocking a ray occupies a position the ray attacks.
+			 *
+			 * \param color the color of the pieces
+			 * \param pieceType the type of the pieces
+			 * \param changedBoard bitboard of the positions the pieces are being added to or removed from
+			 */
+			void invalidateAttackBoards(const Color color, const PieceType pieceType, const Bitboard changedBoard);
+
+			/**
+			 * Calculate the positions attacked by a color's bishops, rooks and queens.
+			 *
+			 * \param color the color of the attacking pieces
+			 * \return bitboard of the attacked positions
+			 */
+			Bitboard calculateSliderAttackBoard(const Color color) const;
+
+			/**
+			 * Calculate the positions attacked by a color's pawns, knights and king.
+			 *
+			 * \param color the color of the attacking pieces
+			 * \return bitboard of the attacked positions
+			 */
+			Bitboard calculateLeaperAttackBoard(const Color color) const;
+
+			/**
+			 * Calculate the enemy pieces attacking a color's king.
+			 *
+			 * \param color the color of the king
+			 * \return bitboard of the pieces giving check
+			 */
+			Bitboard calculateCheckers(const Color color) const;
+
 			Bitboard _bitboards[COLOR_COUNT][PIECE_TYPE_COUNT];
 			Bitboard _allOccupancyBoard;
 			Bitboard _colorOccupancyBoards[COLOR_COUNT];
+			uint64_t _zobristKey;
+			uint64_t _pawnZobristKey; // Zobrist key of the pawns only; keys the pawn hash table
+			evaluation::Score _pieceSquareScores[evaluation::GAME_PHASE_COUNT][COLOR_COUNT];
+			int _phase;
+			Bitboard _attackBoards[COLOR_COUNT];
+			Bitboard _sliderAttackBoards[COLOR_COUNT];
+			Bitboard _checkers[COLOR_COUNT];
+			bool _sliderAttackBoardsValid[COLOR_COUNT];
+			bool _attackBoardsValid; // false if the board has changed since the last call to updateAttackBoards()
 		};
 	}
 }
@@ -157,5 +157,11 @@ namespace util
 
 			return bitboard;
 		}
+
+		Bitboard getPawnAttacks(const Bitboard pawnBoard, const Color color)
+		{
+			const Shift forward = color == Color::WHITE ? up(1) : down(1);
+			return shiftBitboard(pawnBoard, forward + left(1)) | shiftBitboard(pawnBoard, forward + right(1));
+		}
 	}
 }
@@ -81,5 +81,14 @@ namespace util
 		 * \return a shifted copy of the bitboad
 		 */
 		Bitboard shiftBitboard(Bitboard bitboard, const Shift& shift);
+
+		/**
+		 * Get the positions attacked by pawns.
+		 *
+		 * \param pawnBoard the attacking pawns
+		 * \param color the color of the pawns
+		 * \return the attacked positions
+		 */
+		Bitboard getPawnAttacks(const Bitboard pawnBoard, const Color color);
 	}
 }
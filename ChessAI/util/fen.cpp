@@ -0,0 +1,430 @@
+#include "fen.h"
+
+#include "bitboard/bitboardUtil.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <exception>
+
+using util::bitboard::popLsb;
+
+namespace util
+{
+	const int BOARD_SIZE = RANK_COUNT * FILE_COUNT;
+	const int MAX_TURN_COUNT_DIGITS = 9; // keeps turn counts within an int
+	const char EMPTY_FIELD = '-';
+	const char RANK_SEPARATOR = '/';
+	const char FIELD_SEPARATOR = ' ';
+	const int EN_PASSANT_RANK[COLOR_COUNT] = { 6, 3 }; // rank of the en passant square when each color is to move
+
+	// Maps each ASCII character to color * PIECE_TYPE_COUNT + piece type, or -1 if it is not a piece symbol
+	constexpr std::array<int8_t, 128> PIECE_CODES = [] {
+		std::array<int8_t, 128> pieceCodes{};
+		pieceCodes.fill(-1);
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				pieceCodes[PIECE_SYMBOLS[color][pieceType]] = (int8_t)(color * PIECE_TYPE_COUNT + pieceType);
+			}
+		}
+		return pieceCodes;
+	}();
+
+	/**
+	 * Consumes the space between two fields of a FEN string.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the expected space; advanced past it
+	 * \return an error if the space is missing
+	 */
+	std::optional<FenError> parseFieldSeparator(const std::string_view fenString, size_t& offset)
+	{
+		if (offset >= fenString.size() || fenString[offset] != FIELD_SEPARATOR)
+		{
+			return FenError{ offset, "Expected a space between fields" };
+		}
+		offset += 1;
+		return std::nullopt;
+	}
+
+	/**
+	 * Parses the piece placement field of a FEN string.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the field; advanced past it
+	 * \param pieces receives the positions of each color's pieces
+	 * \return the first error found in the field, if any
+	 */
+	std::optional<FenError> parsePiecePlacement(const std::string_view fenString, size_t& offset, Bitboard (&pieces)[COLOR_COUNT][PIECE_TYPE_COUNT])
+	{
+		std::fill(&pieces[0][0], &pieces[0][0] + COLOR_COUNT * PIECE_TYPE_COUNT, 0ULL);
+
+		int positionIndex = 0, rankEnd = FILE_COUNT;
+		for (; offset < fenString.size() && fenString[offset] != FIELD_SEPARATOR; offset++)
+		{
+			const char symbol = fenString[offset];
+			if (symbol == RANK_SEPARATOR)
+			{
+				if (positionIndex != rankEnd || rankEnd == BOARD_SIZE)
+				{
+					return FenError{ offset, positionIndex != rankEnd ? "Rank has fewer than eight files" : "Board has more than eight ranks" };
+				}
+				rankEnd += FILE_COUNT;
+			}
+			else if (symbol >= '1' && symbol <= '8')
+			{
+				positionIndex += symbol - '0';
+				if (positionIndex > rankEnd)
+				{
+					return FenError{ offset, "Rank has more than eight files" };
+				}
+			}
+			else
+			{
+				const int pieceCode = (unsigned char)symbol < PIECE_CODES.size() ? PIECE_CODES[(unsigned char)symbol] : -1;
+				if (pieceCode < 0)
+				{
+					return FenError{ offset, "Expected a piece symbol, an empty square count or '/'" };
+				}
+				if (positionIndex >= rankEnd)
+				{
+					return FenError{ offset, "Rank has more than eight files" };
+				}
+
+				pieces[pieceCode / PIECE_TYPE_COUNT][pieceCode % PIECE_TYPE_COUNT] |= 1ULL << positionIndex;
+				positionIndex += 1;
+			}
+		}
+
+		if (positionIndex != BOARD_SIZE)
+		{
+			return FenError{ offset, rankEnd != BOARD_SIZE ? "Board has fewer than eight ranks" : "Rank has fewer than eight files" };
+		}
+		return std::nullopt;
+	}
+
+	/**
+	 * Parses the castling rights field of a FEN string.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the field; advanced past it
+	 * \param fenPosition receives the castling rights
+	 * \return the first error found in the field, if any
+	 */
+	std::optional<FenError> parseCastlingRights(const std::string_view fenString, size_t& offset, FenPosition& fenPosition)
+	{
+		std::fill(std::begin(fenPosition.kingSideCastle), std::end(fenPosition.kingSideCastle), false);
+		std::fill(std::begin(fenPosition.queenSideCastle), std::end(fenPosition.queenSideCastle), false);
+
+		if (offset < fenString.size() && fenString[offset] == EMPTY_FIELD)
+		{
+			offset += 1;
+			return std::nullopt;
+		}
+
+		const size_t fieldStart = offset;
+		for (; offset < fenString.size() && fenString[offset] != FIELD_SEPARATOR; offset++)
+		{
+			const char symbol = fenString[offset];
+			bool recognized = false;
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				if (symbol == PIECE_SYMBOLS[color][PieceType::KING])
+				{
+					fenPosition.kingSideCastle[color] = recognized = true;
+				}
+				else if (symbol == PIECE_SYMBOLS[color][PieceType::QUEEN])
+				{
+					fenPosition.queenSideCastle[color] = recognized = true;
+				}
+			}
+
+			if (!recognized)
+			{
+				return FenError{ offset, "Expected 'K', 'Q', 'k', 'q' or '-' in castling rights" };
+			}
+		}
+
+		if (offset == fieldStart)
+		{
+			return FenError{ offset, "Castling rights are missing" };
+		}
+		return std::nullopt;
+	}
+
+	/**
+	 * Parses a turn count field of a FEN string.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the field; advanced past it
+	 * \param turnCount receives the turn count
+	 * \return the first error found in the field, if any
+	 */
+	std::optional<FenError> parseTurnCount(const std::string_view fenString, size_t& offset, int& turnCount)
+	{
+		const size_t fieldStart = offset;
+		turnCount = 0;
+		for (; offset < fenString.size() && fenString[offset] >= '0' && fenString[offset] <= '9'; offset++)
+		{
+			if (offset - fieldStart == MAX_TURN_COUNT_DIGITS)
+			{
+				return FenError{ offset, "Turn count is too large" };
+			}
+			turnCount = turnCount * 10 + (fenString[offset] - '0');
+		}
+
+		if (offset == fieldStart)
+		{
+			return FenError{ offset, "Expected a turn count" };
+		}
+		return std::nullopt;
+	}
+
+	/**
+	 * Parses the four fields of a FEN string that describe the position: piece placement, next turn, castling rights
+	 * and en passant square.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the first field; advanced past the en passant field
+	 * \param fenPosition receives the parsed fields
+	 * \return the first error found, std::nullopt if the fields were parsed
+	 */
+	std::optional<FenError> parsePositionFields(const std::string_view fenString, size_t& offset, FenPosition& fenPosition)
+	{
+		std::optional<FenError> error = parsePiecePlacement(fenString, offset, fenPosition.pieces);
+		if (error || (error = parseFieldSeparator(fenString, offset)))
+		{
+			return error;
+		}
+
+		if (offset < fenString.size() && (fenString[offset] == 'w' || fenString[offset] == 'b'))
+		{
+			fenPosition.nextTurn = fenString[offset] == 'w' ? Color::WHITE : Color::BLACK;
+			offset += 1;
+		}
+		else
+		{
+			return FenError{ offset, "Expected 'w' or 'b' for the next turn" };
+		}
+
+		if ((error = parseFieldSeparator(fenString, offset)) || (error = parseCastlingRights(fenString, offset, fenPosition))
+			|| (error = parseFieldSeparator(fenString, offset)))
+		{
+			return error;
+		}
+
+		fenPosition.enPassantFile = std::nullopt;
+		if (offset < fenString.size() && fenString[offset] == EMPTY_FIELD)
+		{
+			offset += 1;
+		}
+		else if (offset + 1 < fenString.size() && fenString[offset] >= 'a' && fenString[offset] < 'a' + FILE_COUNT
+			&& fenString[offset + 1] == '0' + EN_PASSANT_RANK[fenPosition.nextTurn])
+		{
+			fenPosition.enPassantFile = fenString[offset] - 'a';
+			offset += 2;
+		}
+		else
+		{
+			return FenError{ offset, "Expected '-' or an en passant square behind the last pawn moved" };
+		}
+
+		return std::nullopt;
+	}
+
+	/**
+	 * Parses the half turn and full turn count fields of a FEN string.
+	 *
+	 * \param fenString the FEN string
+	 * \param offset index of the space before the half turn count; advanced past the full turn count
+	 * \param fenPosition receives the parsed turn counts
+	 * \return the first error found, std::nullopt if the fields were parsed
+	 */
+	std::optional<FenError> parseTurnCounts(const std::string_view fenString, size_t& offset, FenPosition& fenPosition)
+	{
+		std::optional<FenError> error;
+		if ((error = parseFieldSeparator(fenString, offset)) || (error = parseTurnCount(fenString, offset, fenPosition.halfTurnCount))
+			|| (error = parseFieldSeparator(fenString, offset)) || (error = parseTurnCount(fenString, offset, fenPosition.fullTurnCount)))
+		{
+			return error;
+		}
+		return std::nullopt;
+	}
+
+	std::optional<FenError> parseFen(const std::string_view fenString, FenPosition& fenPosition)
+	{
+		size_t offset = 0;
+		std::optional<FenError> error = parsePositionFields(fenString, offset, fenPosition);
+		if (error)
+		{
+			return error;
+		}
+
+		// The turn counts are optional, as in EPD files
+		fenPosition.halfTurnCount = 0;
+		fenPosition.fullTurnCount = 1;
+		if (offset < fenString.size() && (error = parseTurnCounts(fenString, offset, fenPosition)))
+		{
+			return error;
+		}
+
+		if (offset != fenString.size())
+		{
+			return FenError{ offset, "Unexpected characters after the last field" };
+		}
+		return std::nullopt;
+	}
+
+	std::optional<FenError> parseFenPrefix(const std::string_view line, FenPosition& fenPosition, size_t& length)
+	{
+		length = 0;
+		const std::optional<FenError> error = parsePositionFields(line, length, fenPosition);
+		if (error)
+		{
+			return error;
+		}
+
+		// Whatever follows the en passant field is only taken as the turn counts if it is two whole numbers
+		size_t offset = length;
+		if (!parseTurnCounts(line, offset, fenPosition) && (offset == line.size() || std::isspace((unsigned char)line[offset])))
+		{
+			length = offset;
+		}
+		else
+		{
+			fenPosition.halfTurnCount = 0;
+			fenPosition.fullTurnCount = 1;
+		}
+		return std::nullopt;
+	}
+
+
+	/**
+	 * Writes the empty squares and rank separators between two squares of the piece placement field.
+	 *
+	 * \param buffer the buffer being written to
+	 * \param length the number of characters already written; advanced past the characters written
+	 * \param startIndex board index of the first empty square
+	 * \param endIndex board index of the next occupied square, or the board size if there are none left
+	 */
+	void writeEmptySquares(const std::span<char> buffer, size_t& length, int startIndex, const int endIndex)
+	{
+		while (startIndex < endIndex)
+		{
+			if (startIndex % FILE_COUNT == 0 && startIndex != 0)
+			{
+				buffer[length++] = RANK_SEPARATOR;
+			}
+
+			const int emptyCount = std::min(endIndex, (startIndex / FILE_COUNT + 1) * FILE_COUNT) - startIndex;
+			buffer[length++] = (char)('0' + emptyCount);
+			startIndex += emptyCount;
+		}
+
+		if (endIndex % FILE_COUNT == 0 && endIndex != 0 && endIndex != BOARD_SIZE)
+		{
+			buffer[length++] = RANK_SEPARATOR;
+		}
+	}
+
+	/**
+	 * Writes a turn count.
+	 *
+	 * \param buffer the buffer being written to
+	 * \param length the number of characters already written; advanced past the characters written
+	 * \param turnCount the turn count; negative counts are written as 0
+	 */
+	void writeTurnCount(const std::span<char> buffer, size_t& length, const int turnCount)
+	{
+		char digits[MAX_TURN_COUNT_DIGITS + 1];
+		int digitCount = 0;
+		unsigned int remaining = (unsigned int)std::max(turnCount, 0);
+		do
+		{
+			digits[digitCount++] = (char)('0' + remaining % 10);
+			remaining /= 10;
+		} while (remaining != 0);
+
+		while (digitCount > 0)
+		{
+			buffer[length++] = digits[--digitCount];
+		}
+	}
+
+	size_t writeFen(const FenPosition& fenPosition, const std::span<char> buffer)
+	{
+		if (buffer.size() < MAX_FEN_LENGTH)
+		{
+			throw std::exception("FEN buffer is smaller than MAX_FEN_LENGTH");
+		}
+
+		// Symbols are only read back for occupied squares, so the rest of the board is left uninitialized
+		char symbols[BOARD_SIZE];
+		Bitboard occupancy = 0;
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				Bitboard pieceBoard = fenPosition.pieces[color][pieceType];
+				occupancy |= pieceBoard;
+				while (pieceBoard)
+				{
+					symbols[popLsb(pieceBoard)] = PIECE_SYMBOLS[color][pieceType];
+				}
+			}
+		}
+
+		// Board indices run from a8 to h1, the order the piece placement field lists the squares in
+		size_t length = 0;
+		int nextIndex = 0;
+		while (occupancy)
+		{
+			const int positionIndex = popLsb(occupancy);
+			writeEmptySquares(buffer, length, nextIndex, positionIndex);
+			buffer[length++] = symbols[positionIndex];
+			nextIndex = positionIndex + 1;
+		}
+		writeEmptySquares(buffer, length, nextIndex, BOARD_SIZE);
+
+		buffer[length++] = FIELD_SEPARATOR;
+		buffer[length++] = fenPosition.nextTurn == Color::WHITE ? 'w' : 'b';
+		buffer[length++] = FIELD_SEPARATOR;
+
+		const size_t castlingStart = length;
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			if (fenPosition.kingSideCastle[color])
+			{
+				buffer[length++] = PIECE_SYMBOLS[color][PieceType::KING];
+			}
+			if (fenPosition.queenSideCastle[color])
+			{
+				buffer[length++] = PIECE_SYMBOLS[color][PieceType::QUEEN];
+			}
+		}
+		if (length == castlingStart)
+		{
+			buffer[length++] = EMPTY_FIELD;
+		}
+		buffer[length++] = FIELD_SEPARATOR;
+
+		if (fenPosition.enPassantFile.has_value())
+		{
+			buffer[length++] = (char)('a' + fenPosition.enPassantFile.value());
+			buffer[length++] = (char)('0' + EN_PASSANT_RANK[fenPosition.nextTurn]);
+		}
+		else
+		{
+			buffer[length++] = EMPTY_FIELD;
+		}
+		buffer[length++] = FIELD_SEPARATOR;
+
+		writeTurnCount(buffer, length, fenPosition.halfTurnCount);
+		buffer[length++] = FIELD_SEPARATOR;
+		writeTurnCount(buffer, length, fenPosition.fullTurnCount);
+
+		return length;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../constants.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+using Bitboard = uint64_t;
+
+namespace util
+{
+	const size_t MAX_FEN_LENGTH = 128; // longest FEN string writeFen() can produce, with room to spare
+
+	/**
+	 * The fields of a FEN string, held without any allocations so positions can be parsed and written in bulk.
+	 *
+	 * https://www.chess.com/terms/fen-chess
+	 */
+	struct FenPosition
+	{
+		Bitboard pieces[COLOR_COUNT][PIECE_TYPE_COUNT]; // positions of each color's pieces, by board index
+		Color nextTurn;
+		bool kingSideCastle[COLOR_COUNT];
+		bool queenSideCastle[COLOR_COUNT];
+		std::optional<int> enPassantFile; // file of the pawn that can be captured en passant, if any
+		int halfTurnCount;
+		int fullTurnCount;
+	};
+
+	/**
+	 * Describes why a FEN string could not be parsed.
+	 */
+	struct FenError
+	{
+		size_t offset; // index of the character the error was found at
+		const char* message;
+	};
+
+	/**
+	 * Parses a FEN string without allocating.
+	 *
+	 * The half turn and full turn counts may be omitted, as in EPD files, in which case they are 0 and 1.
+	 *
+	 * \param fenString FEN string describing a game state
+	 * \param fenPosition receives the parsed fields; left partially written if parsing fails
+	 * \return the first error found, std::nullopt if the string was parsed
+	 */
+	std::optional<FenError> parseFen(const std::string_view fenString, FenPosition& fenPosition);
+
+	/**
+	 * Parses the FEN string at the start of a line, ignoring anything that follows it, such as the operations of an
+	 * EPD record or the result of a labelled position.
+	 *
+	 * The turn counts are only read if both are present, otherwise they are 0 and 1.
+	 *
+	 * \param line the line starting with a FEN string
+	 * \param fenPosition receives the parsed fields; left partially written if parsing fails
+	 * \param length receives the number of characters taken up by the FEN string
+	 * \return the first error found, std::nullopt if the FEN string was parsed
+	 */
+	std::optional<FenError> parseFenPrefix(const std::string_view line, FenPosition& fenPosition, size_t& length);
+
+	/**
+	 * Writes the FEN string of a position without allocating.
+	 *
+	 * \param fenPosition the position
+	 * \param buffer receives the FEN string, which is not null-terminated; must hold at least MAX_FEN_LENGTH characters
+	 * \return the number of characters written
+	 */
+	size_t writeFen(const FenPosition& fenPosition, const std::span<char> buffer);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "threadPool.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+	/**
+	 * Read-only view of a file of fixed-size records, mapped into memory so multi-gigabyte files are paged in as they
+	 * are accessed instead of being read up front.
+	 *
+	 * \tparam Record the type of the records; must be trivially copyable and unpadded
+	 */
+	template <typename Record>
+	class MappedRecordFile
+	{
+	public:
+		MappedRecordFile() = delete;
+		MappedRecordFile(const MappedRecordFile& source) = delete;
+
+		/**
+		 * Maps a file of records into memory.
+		 *
+		 * A partially written record at the end of the file is ignored.
+		 *
+		 * \param path the path of the file
+		 */
+		MappedRecordFile(const std::string& path) :
+			_records(nullptr),
+			_recordCount(0)
+		{
+			std::error_code errorCode;
+			const uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+			if (errorCode)
+			{
+				const std::string exceptionMessage = "Unable to open record file \"" + path + "\"";
+				throw std::exception(exceptionMessage.c_str());
+			}
+
+			// Empty files cannot be mapped, and hold no records anyway
+			if (fileSize >= sizeof(Record))
+			{
+				_fileMapping = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+				_region = boost::interprocess::mapped_region(_fileMapping, boost::interprocess::read_only);
+				_records = static_cast<const Record*>(_region.get_address());
+				_recordCount = (size_t)(fileSize / sizeof(Record));
+			}
+		}
+
+		/**
+		 * Retrieves the number of records in the file.
+		 *
+		 * \return the number of complete records
+		 */
+		size_t size() const
+		{
+			return _recordCount;
+		}
+
+		/**
+		 * Retrieves a record.
+		 *
+		 * \param index the index of the record; must be less than size()
+		 * \return the record, valid for the lifetime of the mapping
+		 */
+		const Record& operator[](const size_t index) const
+		{
+			return _records[index];
+		}
+
+		/**
+		 * Retrieves every record.
+		 *
+		 * \return the records, valid for the lifetime of the mapping
+		 */
+		std::span<const Record> getRecords() const
+		{
+			return std::span<const Record>(_records, _recordCount);
+		}
+
+		/**
+		 * Calls a function on contiguous chunks of the records in parallel on the thread pool, returning once every
+		 * chunk has been processed.
+		 *
+		 * Must not be called from a task running on the thread pool, since it waits on the tasks it submits. If any call
+		 * throws, the first exception is rethrown once every chunk has been processed.
+		 *
+		 * \param chunkCount the number of chunks the records are split into; fewer chunks are used if there are fewer records
+		 * \param func called once per chunk with the chunk's records and the index of the chunk
+		 */
+		template <typename Func>
+		void parallelForEach(const size_t chunkCount, Func&& func) const
+		{
+			const size_t recordsPerChunk = std::max<size_t>((_recordCount + chunkCount - 1) / std::max<size_t>(chunkCount, 1), 1);
+			std::vector<std::future<void>> futures;
+			for (size_t begin = 0, chunkIndex = 0; begin < _recordCount; begin += recordsPerChunk, chunkIndex++)
+			{
+				const std::span<const Record> chunk(_records + begin, std::min(recordsPerChunk, _recordCount - begin));
+				futures.push_back(ThreadPool::getInstance().submit([&func, chunk, chunkIndex]() {
+					func(chunk, chunkIndex);
+				}));
+			}
+
+			waitForAll(futures);
+		}
+
+	private:
+		boost::interprocess::file_mapping _fileMapping;
+		boost::interprocess::mapped_region _region;
+		const Record* _records;
+		size_t _recordCount;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "packedPosition.h"
+
+#include "bitboard/bitboardUtil.h"
+
+#include <algorithm>
+#include <bit>
+#include <exception>
+
+using util::bitboard::BitboardSet;
+using util::bitboard::popLsb;
+
+namespace util
+{
+	const int PIECE_CODE_COLOR_SHIFT = 3, PIECE_CODE_BITS = 4;
+	const uint8_t PIECE_CODE_MASK = 0xF, PIECE_TYPE_CODE_MASK = 0x7;
+	const uint8_t BLACK_TO_MOVE_FLAG = 1;
+	const int CASTLING_RIGHTS_SHIFT = 1, CASTLING_RIGHT_COUNT = 4;
+
+	PackedPosition encodeBoard(const BitboardSet& board)
+	{
+		PackedPosition packedPosition{};
+		packedPosition.occupancy = board.getOccupancyBoard();
+		packedPosition.enPassantFile = NO_EN_PASSANT_FILE;
+
+		// Piece codes are read from the piece bitboards, so no square is looked up individually
+		for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+		{
+			for (int pieceType = PieceType::PAWN; pieceType < PIECE_TYPE_COUNT; pieceType++)
+			{
+				Bitboard pieceBoard = board.getBitboard((Color)color, (PieceType)pieceType);
+				while (pieceBoard)
+				{
+					const int positionIndex = popLsb(pieceBoard);
+					const int pieceIndex = std::popcount(packedPosition.occupancy & ((1ULL << positionIndex) - 1));
+					if (pieceIndex >= MAX_PACKED_PIECE_COUNT)
+					{
+						throw std::exception("Packed positions hold at most 32 pieces");
+					}
+
+					const uint8_t pieceCode = (uint8_t)((color << PIECE_CODE_COLOR_SHIFT) | pieceType);
+					packedPosition.pieces[pieceIndex / 2] |= pieceCode << ((pieceIndex % 2) * PIECE_CODE_BITS);
+				}
+			}
+		}
+
+		return packedPosition;
+	}
+
+	PackedPosition encodePosition(const ChessState& chessState)
+	{
+		PackedPosition packedPosition = encodeBoard(chessState.getBoard());
+
+		const bool castlingRights[CASTLING_RIGHT_COUNT] = {
+			chessState.canKingSideCastle(Color::WHITE),
+			chessState.canQueenSideCastle(Color::WHITE),
+			chessState.canKingSideCastle(Color::BLACK),
+			chessState.canQueenSideCastle(Color::BLACK)
+		};
+		packedPosition.state = chessState.getNextTurn() == Color::BLACK ? BLACK_TO_MOVE_FLAG : 0;
+		for (int i = 0; i < CASTLING_RIGHT_COUNT; i++)
+		{
+			packedPosition.state |= castlingRights[i] << (CASTLING_RIGHTS_SHIFT + i);
+		}
+
+		const std::optional<int> enPassantFile = chessState.getEnPassantFile();
+		if (enPassantFile.has_value())
+		{
+			packedPosition.enPassantFile = (uint8_t)enPassantFile.value();
+		}
+
+		packedPosition.halfTurnCount = (uint8_t)std::min(chessState.getHalfTurnCount(), (int)UINT8_MAX);
+		packedPosition.fullTurnCount = (uint16_t)std::min(chessState.getFullTurnCount(), (int)UINT16_MAX);
+		return packedPosition;
+	}
+
+	BitboardSet decodeBoard(const PackedPosition& packedPosition)
+	{
+		// Packed positions are read from external files, so they are validated before any piece is placed
+		if (std::popcount(packedPosition.occupancy) > MAX_PACKED_PIECE_COUNT)
+		{
+			throw std::exception("Packed position holds more than 32 pieces");
+		}
+
+		BitboardSet board;
+		Bitboard occupancy = packedPosition.occupancy;
+		for (int pieceIndex = 0; occupancy; pieceIndex++)
+		{
+			const int positionIndex = popLsb(occupancy);
+			const uint8_t pieceCode = (packedPosition.pieces[pieceIndex / 2] >> ((pieceIndex % 2) * PIECE_CODE_BITS)) & PIECE_CODE_MASK;
+			if ((pieceCode & PIECE_TYPE_CODE_MASK) >= PIECE_TYPE_COUNT)
+			{
+				throw std::exception("Packed position holds an invalid piece code");
+			}
+			board.addPiece(positionIndex % FILE_COUNT, positionIndex / FILE_COUNT, (Color)(pieceCode >> PIECE_CODE_COLOR_SHIFT), (PieceType)(pieceCode & PIECE_TYPE_CODE_MASK));
+		}
+
+		return board;
+	}
+
+	ChessState decodePosition(const PackedPosition& packedPosition)
+	{
+		if (packedPosition.enPassantFile >= FILE_COUNT && packedPosition.enPassantFile != NO_EN_PASSANT_FILE)
+		{
+			throw std::exception("Packed position holds an invalid en passant file");
+		}
+
+		const auto hasCastlingRight = [&packedPosition](const int index) {
+			return ((packedPosition.state >> (CASTLING_RIGHTS_SHIFT + index)) & 1) != 0;
+		};
+
+		return ChessState(decodeBoard(packedPosition),
+			getNextTurn(packedPosition),
+			hasCastlingRight(0),
+			hasCastlingRight(1),
+			hasCastlingRight(2),
+			hasCastlingRight(3),
+			packedPosition.enPassantFile == NO_EN_PASSANT_FILE ? std::nullopt : std::optional<int>(packedPosition.enPassantFile),
+			packedPosition.halfTurnCount,
+			packedPosition.fullTurnCount);
+	}
+
+	Color getNextTurn(const PackedPosition& packedPosition)
+	{
+		return (packedPosition.state & BLACK_TO_MOVE_FLAG) ? Color::BLACK : Color::WHITE;
+	}
+}
\ No newline at end of file
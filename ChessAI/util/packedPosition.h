@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../chess.h"
+#include "bitboard/bitboardSet.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace util
+{
+	const uint8_t NO_EN_PASSANT_FILE = 0xFF;
+	const int MAX_PACKED_PIECE_COUNT = 32;
+
+	#pragma pack(push, 1)
+	/**
+	 * A game state packed into 29 bytes, for storing datasets of positions without FEN strings.
+	 *
+	 * Records are stored in little-endian byte order and without padding, so they can be written to and mapped from
+	 * files as they are.
+	 */
+	struct PackedPosition
+	{
+		uint64_t occupancy; // squares holding a piece, by board index
+		uint8_t pieces[MAX_PACKED_PIECE_COUNT / 2]; // color << 3 | piece type of each occupied square in board index order; low nibble first
+		uint8_t state; // bit 0 is set if black is to move; bits 1 to 4 are white's and then black's king-side and queen-side castling rights
+		uint8_t enPassantFile; // file of the pawn that can be captured en passant, NO_EN_PASSANT_FILE if none
+		uint8_t halfTurnCount; // capped at 255
+		uint16_t fullTurnCount;
+	};
+	#pragma pack(pop)
+	static_assert(sizeof(PackedPosition) == 29, "PackedPosition must not be padded");
+
+	/**
+	 * Packs the pieces of a board; the side to move, castling rights, en passant file and clocks are left clear.
+	 *
+	 * \param board the board; must hold at most 32 pieces
+	 * \return the packed board
+	 */
+	PackedPosition encodeBoard(const bitboard::BitboardSet& board);
+
+	/**
+	 * Packs a game state.
+	 *
+	 * \param chessState the game state; must hold at most 32 pieces
+	 * \return the packed game state
+	 */
+	PackedPosition encodePosition(const ChessState& chessState);
+
+	/**
+	 * Unpacks the pieces of a packed position.
+	 *
+	 * Throws if the position holds more than 32 pieces or an invalid piece code.
+	 *
+	 * \param packedPosition the packed position
+	 * \return the board holding the position's pieces
+	 */
+	bitboard::BitboardSet decodeBoard(const PackedPosition& packedPosition);
+
+	/**
+	 * Unpacks a packed position.
+	 *
+	 * Throws if the position's pieces or en passant file are invalid.
+	 *
+	 * \param packedPosition the packed position
+	 * \return the game state
+	 */
+	ChessState decodePosition(const PackedPosition& packedPosition);
+
+	/**
+	 * Retrieves the player whose turn it is in a packed position.
+	 *
+	 * \param packedPosition the packed position
+	 * \return the player to move
+	 */
+	Color getNextTurn(const PackedPosition& packedPosition);
+}
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include "pgn.h"
+
+#include "fen.h"
+#include "../move/san.h"
+
+#include <algorithm>
+#include <future>
+
+namespace util
+{
+	const std::string_view PGN_WHITESPACE = " \t\r\n";
+	const std::string_view PGN_TOKEN_DELIMITERS = " \t\r\n{}();$[]";
+	const std::string_view PGN_RESULTS[] = { "1-0", "0-1", "1/2-1/2", "*" };
+	const std::string_view BYTE_ORDER_MARK = "\xEF\xBB\xBF";
+	const std::string_view FEN_TAG = "FEN";
+	const char TAG_START = '[', TAG_END = ']', TAG_QUOTE = '"', TAG_ESCAPE = '\\';
+	const char COMMENT_START = '{', COMMENT_END = '}', LINE_COMMENT = ';', ESCAPE_LINE = '%';
+	const char VARIATION_START = '(', VARIATION_END = ')', ANNOTATION_GLYPH = '$';
+
+	std::optional<std::string_view> PgnGame::getTag(const std::string_view name) const
+	{
+		for (const PgnTag& tag : tags)
+		{
+			if (tag.name == name)
+			{
+				return tag.value;
+			}
+		}
+		return std::nullopt;
+	}
+
+	std::string_view readPgnGame(const std::string_view text, size_t& offset)
+	{
+		const size_t start = text.find_first_not_of(PGN_WHITESPACE, offset);
+		if (start == std::string_view::npos)
+		{
+			offset = text.size();
+			return std::string_view();
+		}
+
+		// Games are split line by line; only move text lines are scanned for the braces of multi-line comments
+		bool inMoveText = false, inComment = false;
+		size_t lineStart = start;
+		while (lineStart < text.size())
+		{
+			const size_t newline = text.find('\n', lineStart);
+			const size_t lineEnd = newline == std::string_view::npos ? text.size() : newline;
+			const std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+
+			if (!inComment && !line.empty() && line.front() == TAG_START)
+			{
+				if (inMoveText)
+				{
+					break;
+				}
+			}
+			else if (inComment || (!line.empty() && line.front() != ESCAPE_LINE))
+			{
+				for (size_t index = line.find_first_of(inComment ? "}" : "{;"); index != std::string_view::npos; index = line.find_first_of(inComment ? "}" : "{;", index + 1))
+				{
+					if (line[index] == LINE_COMMENT)
+					{
+						break;
+					}
+					inComment = line[index] == COMMENT_START;
+				}
+				inMoveText = inMoveText || line.find_first_not_of(PGN_WHITESPACE) != std::string_view::npos;
+			}
+
+			lineStart = lineEnd + 1;
+		}
+
+		offset = std::min(lineStart, text.size());
+		return text.substr(start, offset - start);
+	}
+
+	/**
+	 * Parses a tag pair, such as [White "Carlsen, Magnus"].
+	 *
+	 * \param text the text of the game
+	 * \param offset index of the opening bracket; advanced past the closing bracket
+	 * \param tag receives the tag's name and value
+	 * \return an error if the tag pair is malformed
+	 */
+	std::optional<PgnError> parseTag(const std::string_view text, size_t& offset, PgnTag& tag)
+	{
+		const size_t nameStart = text.find_first_not_of(PGN_WHITESPACE, offset + 1);
+		const size_t nameEnd = nameStart == std::string_view::npos ? std::string_view::npos : text.find_first_of(" \t\"", nameStart);
+		if (nameEnd == std::string_view::npos || nameEnd == nameStart)
+		{
+			return PgnError{ offset, "Expected a tag name" };
+		}
+		tag.name = text.substr(nameStart, nameEnd - nameStart);
+
+		const size_t valueStart = text.find_first_not_of(" \t", nameEnd);
+		if (valueStart == std::string_view::npos || text[valueStart] != TAG_QUOTE)
+		{
+			return PgnError{ std::min(valueStart, text.size()), "Expected a quoted tag value" };
+		}
+
+		size_t valueEnd = valueStart + 1;
+		while (valueEnd < text.size() && text[valueEnd] != TAG_QUOTE && text[valueEnd] != '\n')
+		{
+			valueEnd += text[valueEnd] == TAG_ESCAPE ? 2 : 1;
+		}
+		if (valueEnd >= text.size() || text[valueEnd] != TAG_QUOTE)
+		{
+			return PgnError{ std::min(valueEnd, text.size()), "Tag value is not terminated" };
+		}
+		tag.value = text.substr(valueStart + 1, valueEnd - valueStart - 1);
+
+		const size_t tagEnd = text.find_first_not_of(" \t", valueEnd + 1);
+		if (tagEnd == std::string_view::npos || text[tagEnd] != TAG_END)
+		{
+			return PgnError{ std::min(tagEnd, text.size()), "Expected ']' after the tag value" };
+		}
+		offset = tagEnd + 1;
+		return std::nullopt;
+	}
+
+	/**
+	 * Skips a variation, including any variations and comments nested within it.
+	 *
+	 * \param text the text of the game
+	 * \param offset index of the opening parenthesis; advanced past the closing parenthesis
+	 * \return an error if the variation is not closed
+	 */
+	std::optional<PgnError> skipVariation(const std::string_view text, size_t& offset)
+	{
+		const size_t start = offset;
+		int depth = 0;
+		for (; offset < text.size(); offset++)
+		{
+			if (text[offset] == VARIATION_START)
+			{
+				depth += 1;
+			}
+			else if (text[offset] == VARIATION_END && --depth == 0)
+			{
+				offset += 1;
+				return std::nullopt;
+			}
+			else if (text[offset] == COMMENT_START)
+			{
+				offset = text.find(COMMENT_END, offset);
+				if (offset == std::string_view::npos)
+				{
+					break;
+				}
+			}
+		}
+
+		return PgnError{ start, "Variation is not closed" };
+	}
+
+	std::optional<PgnError> parsePgnGame(const std::string_view text, PgnGame& game)
+	{
+		game.text = text;
+		game.tags.clear();
+		game.moves.clear();
+		game.result = std::string_view();
+
+		size_t offset = text.find_first_not_of(PGN_WHITESPACE);
+		while (offset != std::string_view::npos && text[offset] == TAG_START)
+		{
+			PgnTag tag;
+			if (const std::optional<PgnError> error = parseTag(text, offset, tag))
+			{
+				return error;
+			}
+			game.tags.push_back(tag);
+			offset = text.find_first_not_of(PGN_WHITESPACE, offset);
+		}
+
+		while (offset != std::string_view::npos && offset < text.size())
+		{
+			const char symbol = text[offset];
+			if (symbol == COMMENT_START)
+			{
+				offset = text.find(COMMENT_END, offset);
+				if (offset == std::string_view::npos)
+				{
+					return PgnError{ text.size(), "Comment is not closed" };
+				}
+				offset += 1;
+			}
+			else if (symbol == LINE_COMMENT || (symbol == ESCAPE_LINE && (offset == 0 || text[offset - 1] == '\n')))
+			{
+				offset = text.find('\n', offset);
+			}
+			else if (symbol == VARIATION_START)
+			{
+				if (const std::optional<PgnError> error = skipVariation(text, offset))
+				{
+					return error;
+				}
+			}
+			else if (symbol == ANNOTATION_GLYPH)
+			{
+				offset = text.find_first_not_of("0123456789", offset + 1);
+			}
+			else if (PGN_TOKEN_DELIMITERS.find(symbol) != std::string_view::npos)
+			{
+				return PgnError{ offset, symbol == TAG_START ? "Tag pair found in move text" : "Unexpected character in move text" };
+			}
+			else
+			{
+				const size_t tokenEnd = std::min(text.find_first_of(PGN_TOKEN_DELIMITERS, offset), text.size());
+				std::string_view token = text.substr(offset, tokenEnd - offset);
+				offset = tokenEnd;
+
+				if (std::find(std::begin(PGN_RESULTS), std::end(PGN_RESULTS), token) != std::end(PGN_RESULTS))
+				{
+					game.result = token;
+					return std::nullopt;
+				}
+
+				// Move numbers may run into the move that follows them, as in "1.e4" or "12...Nf6"
+				const size_t moveStart = token.find_first_not_of("0123456789");
+				if (moveStart != 0 && moveStart != std::string_view::npos && token[moveStart] == '.')
+				{
+					token.remove_prefix(token.find_first_not_of('.', moveStart) == std::string_view::npos ? token.size() : token.find_first_not_of('.', moveStart));
+				}
+				else if (moveStart == std::string_view::npos)
+				{
+					token = std::string_view();
+				}
+
+				if (!token.empty() && token.find_first_not_of('.') != std::string_view::npos)
+				{
+					game.moves.push_back(token);
+				}
+			}
+
+			offset = offset == std::string_view::npos ? std::string_view::npos : text.find_first_not_of(PGN_WHITESPACE, offset);
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<PgnError> replayPgnGame(const PgnGame& game, const std::function<void(const ChessState&, const move::Move&)>& onMove)
+	{
+		FenPosition startingPosition;
+		const std::optional<std::string_view> fenTag = game.getTag(FEN_TAG);
+		if (fenTag.has_value())
+		{
+			if (const std::optional<FenError> fenError = parseFen(fenTag.value(), startingPosition))
+			{
+				return PgnError{ (size_t)(fenTag.value().data() - game.text.data()) + fenError->offset, fenError->message };
+			}
+		}
+
+		ChessState chessState = fenTag.has_value() ? ChessState(startingPosition) : ChessState();
+		for (const std::string_view san : game.moves)
+		{
+			const std::optional<move::Move> move = move::parseSan(chessState, san);
+			if (!move.has_value())
+			{
+				return PgnError{ (size_t)(san.data() - game.text.data()), "Move is illegal, ambiguous or malformed" };
+			}
+
+			if (onMove)
+			{
+				onMove(chessState, move.value());
+			}
+			chessState.update(chessState.getNextTurn(), move.value(), move.value().promotion == PieceType::NONE ? PieceType::QUEEN : move.value().promotion, false);
+		}
+
+		return std::nullopt;
+	}
+
+	PgnReader::PgnReader(const std::string& path) :
+		_file(path),
+		_text(_file.getRecords().data(), _file.size())
+	{
+		if (_text.starts_with(BYTE_ORDER_MARK))
+		{
+			_text.remove_prefix(BYTE_ORDER_MARK.size());
+		}
+	}
+
+	std::string_view PgnReader::getText() const
+	{
+		return _text;
+	}
+
+	void PgnReader::forEachGame(const std::function<void(const std::string_view, const size_t)>& func) const
+	{
+		size_t offset = 0, gameIndex = 0;
+		for (std::string_view gameText = readPgnGame(_text, offset); !gameText.empty(); gameText = readPgnGame(_text, offset))
+		{
+			func(gameText, gameIndex++);
+		}
+	}
+
+	void PgnReader::parallelForEachGame(const std::function<void(const std::string_view, const size_t)>& func, const size_t batchSize) const
+	{
+		std::vector<std::future<void>> futures;
+		size_t offset = 0, gameIndex = 0;
+		while (offset < _text.size())
+		{
+			std::vector<std::string_view> batch;
+			batch.reserve(batchSize);
+			for (std::string_view gameText; batch.size() < batchSize && !(gameText = readPgnGame(_text, offset)).empty();)
+			{
+				batch.push_back(gameText);
+			}
+
+			if (!batch.empty())
+			{
+				const size_t firstGameIndex = gameIndex;
+				gameIndex += batch.size();
+				futures.push_back(ThreadPool::getInstance().submit([&func, batch = std::move(batch), firstGameIndex]() {
+					for (size_t i = 0; i < batch.size(); i++)
+					{
+						func(batch[i], firstGameIndex + i);
+					}
+				}));
+			}
+		}
+
+		waitForAll(futures);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../chess.h"
+#include "../move/move.h"
+#include "mappedRecordFile.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace util
+{
+	const size_t DEFAULT_PGN_BATCH_SIZE = 256; // games handed to each thread pool task
+
+	/**
+	 * A tag pair from the header of a PGN game, such as [White "Carlsen, Magnus"].
+	 */
+	struct PgnTag
+	{
+		std::string_view name;
+		std::string_view value; // without the surrounding quotes; escaped characters are left escaped
+	};
+
+	/**
+	 * A game read from PGN text; every field is a view into that text.
+	 *
+	 * https://www.chess.com/terms/chess-pgn
+	 */
+	struct PgnGame
+	{
+		std::string_view text; // the game's tag pairs and move text
+		std::vector<PgnTag> tags;
+		std::vector<std::string_view> moves; // the main line in standard algebraic notation, without move numbers, comments or variations
+		std::string_view result; // "1-0", "0-1", "1/2-1/2", "*", or empty if the move text has no result
+
+		/**
+		 * Retrieves the value of a tag.
+		 *
+		 * \param name the name of the tag
+		 * \return the value of the first tag with the name, std::nullopt if the game has no such tag
+		 */
+		std::optional<std::string_view> getTag(const std::string_view name) const;
+	};
+
+	/**
+	 * Describes why a PGN game could not be parsed or replayed.
+	 */
+	struct PgnError
+	{
+		size_t offset; // index of the character in the game's text the error was found at
+		const char* message;
+	};
+
+	/**
+	 * Finds the next game in PGN text without parsing it.
+	 *
+	 * A game ends where a tag pair follows its move text, outside of any comment.
+	 *
+	 * \param text PGN text holding any number of games
+	 * \param offset index to search from; advanced past the game
+	 * \return the text of the game, empty if there are no games left
+	 */
+	std::string_view readPgnGame(const std::string_view text, size_t& offset);
+
+	/**
+	 * Parses the tag pairs and main line of a PGN game.
+	 *
+	 * Comments, variations, numeric annotation glyphs and move numbers are skipped. The moves are not checked against
+	 * the rules; see replayPgnGame().
+	 *
+	 * \param text the text of a single game, such as returned by readPgnGame()
+	 * \param game receives the parsed game; cleared first so its storage can be reused between games
+	 * \return the first error found, std::nullopt if the game was parsed
+	 */
+	std::optional<PgnError> parsePgnGame(const std::string_view text, PgnGame& game);
+
+	/**
+	 * Plays the moves of a parsed PGN game from its starting position.
+	 *
+	 * The game starts from its FEN tag if it has one, and from the standard starting position otherwise.
+	 *
+	 * \param game the parsed game
+	 * \param onMove called with the game state before each move and the move, whose promotion is set if it promotes a pawn
+	 * \return the first move that could not be resolved to a legal move, std::nullopt if every move was played
+	 */
+	std::optional<PgnError> replayPgnGame(const PgnGame& game, const std::function<void(const ChessState&, const move::Move&)>& onMove = nullptr);
+
+	/**
+	 * Reads the games of a PGN file, which is mapped into memory so archives of millions of games are paged in as they
+	 * are read instead of being loaded up front.
+	 */
+	class PgnReader
+	{
+	public:
+		PgnReader() = delete;
+		PgnReader(const PgnReader& source) = delete;
+
+		/**
+		 * Maps a PGN file into memory.
+		 *
+		 * \param path the path of the file
+		 */
+		PgnReader(const std::string& path);
+
+		/**
+		 * Retrieves the text of the file.
+		 *
+		 * \return the text, without any byte order mark; valid for the lifetime of the reader
+		 */
+		std::string_view getText() const;
+
+		/**
+		 * Calls a function on each game in the file, in order.
+		 *
+		 * \param func called with the text of each game and the index of the game in the file
+		 */
+		void forEachGame(const std::function<void(const std::string_view, const size_t)>& func) const;
+
+		/**
+		 * Calls a function on the games in the file in parallel on the thread pool, returning once every game has been
+		 * processed.
+		 *
+		 * The file is split into batches of games as the tasks are submitted, so processing starts before the whole
+		 * file has been read. Must not be called from a task running on the thread pool, since it waits on the tasks
+		 * it submits. If any call throws, the first exception is rethrown once every batch has been processed.
+		 *
+		 * \param func called concurrently with the text of each game and the index of the game in the file
+		 * \param batchSize the number of games handled by each task
+		 */
+		void parallelForEachGame(const std::function<void(const std::string_view, const size_t)>& func, const size_t batchSize = DEFAULT_PGN_BATCH_SIZE) const;
+
+	private:
+		MappedRecordFile<char> _file;
+		std::string_view _text;
+	};
+}
\ No newline at end of file
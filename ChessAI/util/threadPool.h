@@ -8,6 +8,7 @@
 #include <functional>
 #include <future>
 #include <atomic>
+#include <exception>
 
 namespace util
 {
@@ -128,5 +129,34 @@ namespace util
 		std::atomic<bool> _stop;
 	};
 
+	/**
+	 * Wait for every task of a batch to finish, then rethrow the first exception thrown by any of them.
+	 *
+	 * Rethrowing only once the whole batch has finished keeps the caller's frame alive while tasks still reference it.
+	 *
+	 * \param futures the futures of the batch's tasks
+	 */
+	inline void waitForAll(std::vector<std::future<void>>& futures)
+	{
+		std::exception_ptr firstException;
+		for (std::future<void>& future : futures)
+		{
+			try
+			{
+				future.get();
+			}
+			catch (...)
+			{
+				if (!firstException)
+				{
+					firstException = std::current_exception();
+				}
+			}
+		}
 
+		if (firstException)
+		{
+			std::rethrow_exception(firstException);
+		}
+	}
 }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "../constants.h"
+
+namespace util
+{
+	namespace zobrist
+	{
+		const int SQUARE_COUNT = FILE_COUNT * RANK_COUNT;
+		const int CASTLING_RIGHT_COUNT = 4;
+
+		/**
+		 * Random keys combined to form the hash of a game state.
+		 */
+		struct ZobristKeys
+		{
+			uint64_t pieces[COLOR_COUNT][PIECE_TYPE_COUNT][SQUARE_COUNT];
+			uint64_t blackToMove;
+			uint64_t castlingRights[CASTLING_RIGHT_COUNT]; // white king-side, white queen-side, black king-side, black queen-side
+			uint64_t enPassantFiles[FILE_COUNT];
+		};
+
+		/**
+		 * Generates the Zobrist keys from a fixed seed so hashes are identical across runs.
+		 *
+		 * \return the generated keys
+		 */
+		constexpr ZobristKeys generateKeys()
+		{
+			ZobristKeys result{};
+			uint64_t state = 0x9E3779B97F4A7C15;
+
+			// SplitMix64
+			const auto next = [&state]() {
+				state += 0x9E3779B97F4A7C15;
+				uint64_t value = state;
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+				return value ^ (value >> 31);
+			};
+
+			for (int color = 0; color < COLOR_COUNT; color++)
+			{
+				for (int pieceType = 0; pieceType < PIECE_TYPE_COUNT; pieceType++)
+				{
+					for (int positionIndex = 0; positionIndex < SQUARE_COUNT; positionIndex++)
+					{
+						result.pieces[color][pieceType][positionIndex] = next();
+					}
+				}
+			}
+
+			result.blackToMove = next();
+
+			for (int i = 0; i < CASTLING_RIGHT_COUNT; i++)
+			{
+				result.castlingRights[i] = next();
+			}
+
+			for (int i = 0; i < FILE_COUNT; i++)
+			{
+				result.enPassantFiles[i] = next();
+			}
+
+			return result;
+		}
+
+		inline constexpr ZobristKeys KEYS = generateKeys();
+	}
+}
@@ -4,6 +4,8 @@
 
 using namespace boost;
 
+const double NANOSECONDS_PER_MILLISECOND = 1000000.0;
+
 namespace websocket
 {
 	namespace message
@@ -22,6 +24,26 @@ namespace websocket
 		void StartGameRequest::fromJson(const json::object& json)
 		{
 			gameType = getGameTypeFromString(json.at("gameType").as_string().c_str());
+
+			searchLimits = search::SearchLimits();
+			if (json.contains("maxNodes"))
+			{
+				searchLimits.maxNodes = json.at("maxNodes").to_number<uint64_t>();
+			}
+			if (json.contains("maxDepth"))
+			{
+				searchLimits.maxDepth = json.at("maxDepth").to_number<int>();
+			}
+			if (json.contains("moveTime"))
+			{
+				searchLimits.moveTime = json.at("moveTime").to_number<double>() * NANOSECONDS_PER_MILLISECOND;
+			}
+
+			evaluatorType = std::nullopt;
+			if (json.contains("evaluator"))
+			{
+				evaluatorType = evaluation::getEvaluatorTypeFromString(json.at("evaluator").as_string().c_str());
+			}
 		}
 
 		json::object StartGameRequest::toJson() const
@@ -31,6 +53,23 @@ namespace websocket
 			json::object data;
 			data["gameType"] = toString(gameType);
 
+			if (searchLimits.maxNodes)
+			{
+				data["maxNodes"] = searchLimits.maxNodes.value();
+			}
+			if (searchLimits.maxDepth)
+			{
+				data["maxDepth"] = searchLimits.maxDepth.value();
+			}
+			if (searchLimits.moveTime)
+			{
+				data["moveTime"] = searchLimits.moveTime.value() / NANOSECONDS_PER_MILLISECOND;
+			}
+			if (evaluatorType)
+			{
+				data["evaluator"] = evaluation::toString(evaluatorType.value());
+			}
+
 			result["data"] = data;
 
 			return result;
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "message.h"
+#include "../../search/searchLimits.h"
+#include "../../evaluation/evaluators.h"
+
+#include <optional>
 
 namespace boost
 {
@@ -22,6 +26,8 @@ namespace websocket
 		struct StartGameRequest : Message
 		{
 			GameType gameType;
+			search::SearchLimits searchLimits; // Limits applied to every AI player's search; "moveTime" is sent in milliseconds
+			std::optional<evaluation::EvaluatorType> evaluatorType; // Evaluator of every AI player; the default evaluator if not sent
 
 			StartGameRequest() = default;
 
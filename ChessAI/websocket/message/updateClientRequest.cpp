@@ -28,6 +28,27 @@ namespace websocket
 			board = std::make_unique<const util::bitboard::BitboardSet>(util::bitboard::getBoardFromJson(boardJson));
 			nextTurn = util::getColorFromString(json.at("nextTurn").as_string().c_str());
 			winner = util::getColorFromString(json.at("winner").as_string().c_str());
+
+			searchStatistics.reset();
+			if (json.contains("searchStatistics"))
+			{
+				const json::object& statisticsJson = json.at("searchStatistics").as_object();
+				search::SearchStatistics statistics;
+				statistics.nodeCount = statisticsJson.at("nodeCount").to_number<uint64_t>();
+				statistics.quiescenceNodeCount = statisticsJson.at("quiescenceNodeCount").to_number<uint64_t>();
+				statistics.betaCutoffCount = statisticsJson.at("betaCutoffCount").to_number<uint64_t>();
+				statistics.firstMoveBetaCutoffCount = statisticsJson.at("firstMoveBetaCutoffCount").to_number<uint64_t>();
+				statistics.transpositionProbeCount = statisticsJson.at("transpositionProbeCount").to_number<uint64_t>();
+				statistics.transpositionHitCount = statisticsJson.at("transpositionHitCount").to_number<uint64_t>();
+				statistics.pawnHashProbeCount = statisticsJson.at("pawnHashProbeCount").to_number<uint64_t>();
+				statistics.pawnHashHitCount = statisticsJson.at("pawnHashHitCount").to_number<uint64_t>();
+				statistics.evaluationCacheProbeCount = statisticsJson.at("evaluationCacheProbeCount").to_number<uint64_t>();
+				statistics.evaluationCacheHitCount = statisticsJson.at("evaluationCacheHitCount").to_number<uint64_t>();
+				statistics.depth = statisticsJson.at("depth").to_number<int>();
+				statistics.selectiveDepth = statisticsJson.at("selectiveDepth").to_number<int>();
+				statistics.elapsedTime = statisticsJson.at("elapsedTime").to_number<double>();
+				searchStatistics = statistics;
+			}
 		}
 
 		json::object UpdateClientRequest::toJson() const
@@ -40,6 +61,26 @@ namespace websocket
 			data["nextTurn"] = util::toString(nextTurn);
 			data["winner"] = (winner ? boost::json::value(util::toString(winner.value())) : boost::json::value(nullptr));;
 
+			if (searchStatistics)
+			{
+				json::object statisticsJson;
+				statisticsJson["nodeCount"] = searchStatistics->nodeCount;
+				statisticsJson["quiescenceNodeCount"] = searchStatistics->quiescenceNodeCount;
+				statisticsJson["betaCutoffCount"] = searchStatistics->betaCutoffCount;
+				statisticsJson["firstMoveBetaCutoffCount"] = searchStatistics->firstMoveBetaCutoffCount;
+				statisticsJson["transpositionProbeCount"] = searchStatistics->transpositionProbeCount;
+				statisticsJson["transpositionHitCount"] = searchStatistics->transpositionHitCount;
+				statisticsJson["pawnHashProbeCount"] = searchStatistics->pawnHashProbeCount;
+				statisticsJson["pawnHashHitCount"] = searchStatistics->pawnHashHitCount;
+				statisticsJson["evaluationCacheProbeCount"] = searchStatistics->evaluationCacheProbeCount;
+				statisticsJson["evaluationCacheHitCount"] = searchStatistics->evaluationCacheHitCount;
+				statisticsJson["depth"] = searchStatistics->depth;
+				statisticsJson["selectiveDepth"] = searchStatistics->selectiveDepth;
+				statisticsJson["elapsedTime"] = searchStatistics->elapsedTime;
+				statisticsJson["nodesPerSecond"] = searchStatistics->getNodesPerSecond();
+				data["searchStatistics"] = statisticsJson;
+			}
+
 			result["data"] = data;
 
 			return result;
@@ -3,6 +3,7 @@
 #include "message.h"
 #include "../../util/utility.h"
 #include "../../util/bitboard/bitboardSet.h"
+#include "../../search/searchStatistics.h"
 
 namespace boost
 {
@@ -24,6 +25,7 @@ namespace websocket
 			std::unique_ptr<const util::bitboard::BitboardSet> board;
 			Color nextTurn;
 			std::optional<Color> winner;
+			std::optional<search::SearchStatistics> searchStatistics; // Statistics of the search that chose the move, if an agent moved
 
 			UpdateClientRequest() = default;
 
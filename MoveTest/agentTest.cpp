@@ -0,0 +1,269 @@
+#include "pch.h"
+
+#include "../ChessAI/agent.h"
+#include "../ChessAI/move/moveLookupTable.h"
+#include "../ChessAI/search/parameterRegistry.h"
+
+#include <chrono>
+
+using namespace testing;
+using namespace move;
+
+namespace agentTest
+{
+	class AgentTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+
+		void TearDown() override
+		{
+			if (chessState)
+			{
+				chessState.release();
+			}
+		}
+
+		std::unique_ptr<ChessState> chessState;
+	};
+
+	TEST_F(AgentTest, mateInOne_white)
+	{
+		const Color COLOR = Color::WHITE;
+		chessState = std::make_unique<ChessState>("k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		const Move move = agent.getMove();
+		chessState->update(COLOR, move);
+
+		ASSERT_TRUE(chessState->getWinner().has_value());
+		EXPECT_EQ(COLOR, chessState->getWinner().value());
+	}
+
+	TEST_F(AgentTest, mateInOne_black)
+	{
+		const Color COLOR = Color::BLACK;
+		chessState = std::make_unique<ChessState>("8/7q/8/8/8/1k6/8/K7 b - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		const Move move = agent.getMove();
+		chessState->update(COLOR, move);
+
+		ASSERT_TRUE(chessState->getWinner().has_value());
+		EXPECT_EQ(COLOR, chessState->getWinner().value());
+	}
+
+	TEST_F(AgentTest, laterRootMoveBeatsFirst)
+	{
+		// The captures are ordered ahead of the quiet mate, so the mate must beat the alpha they raise
+		const Color COLOR = Color::WHITE;
+		chessState = std::make_unique<ChessState>("6k1/5ppp/8/3p4/1n6/P1N5/8/4R1K1 w - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		const Move move = agent.getMove();
+		EXPECT_EQ(Move(util::Position(4, 7), util::Position(4, 0)), move);
+
+		chessState->update(COLOR, move);
+		ASSERT_TRUE(chessState->getWinner().has_value());
+		EXPECT_EQ(COLOR, chessState->getWinner().value());
+	}
+
+	TEST_F(AgentTest, singleThreaded_laterRootMoveBeatsFirst)
+	{
+		const Color COLOR = Color::WHITE;
+		chessState = std::make_unique<ChessState>("6k1/5ppp/8/3p4/1n6/P1N5/8/4R1K1 w - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+		search::SearchLimits searchLimits;
+		searchLimits.singleThreaded = true;
+		agent.setSearchLimits(searchLimits);
+
+		EXPECT_EQ(Move(util::Position(4, 7), util::Position(4, 0)), agent.getMove());
+	}
+
+	TEST_F(AgentTest, createAgent_everyEvaluatorFindsMateInOne)
+	{
+		const Color COLOR = Color::WHITE;
+		const std::vector<evaluation::EvaluatorType> evaluatorTypes = {
+			evaluation::EvaluatorType::MATERIAL,
+			evaluation::EvaluatorType::PIECE_SQUARE,
+			evaluation::EvaluatorType::ATTACK
+		};
+
+		for (const evaluation::EvaluatorType evaluatorType : evaluatorTypes)
+		{
+			chessState = std::make_unique<ChessState>("k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+			const std::unique_ptr<Agent> agent = createAgent(evaluatorType, *chessState, COLOR, 3);
+
+			const Move move = agent->getMove();
+			chessState->update(COLOR, move);
+
+			ASSERT_TRUE(chessState->getWinner().has_value()) << evaluation::toString(evaluatorType);
+			EXPECT_EQ(COLOR, chessState->getWinner().value()) << evaluation::toString(evaluatorType);
+		}
+	}
+
+	TEST_F(AgentTest, createAgent_networkWithoutLoadedNetwork)
+	{
+		chessState = std::make_unique<ChessState>();
+		EXPECT_ANY_THROW(createAgent(evaluation::EvaluatorType::NETWORK, *chessState, Color::WHITE, 3));
+	}
+
+	TEST_F(AgentTest, avoidStalemate)
+	{
+		const Color COLOR = Color::WHITE;
+		chessState = std::make_unique<ChessState>("k7/2Q5/1K6/8/8/8/8/8 w - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		const Move move = agent.getMove();
+		chessState->update(COLOR, move);
+
+		EXPECT_FALSE(chessState->getWinner().has_value() && chessState->getWinner().value() == Color::NEUTRAL);
+		EXPECT_FALSE(chessState->getNextTurn() == Color::BLACK && getValidMoves(*chessState, Color::BLACK).empty() && !inCheck(Color::BLACK, *chessState));
+	}
+
+	TEST_F(AgentTest, searchStatistics_aggregatedAcrossThreads)
+	{
+		const int SEARCH_DEPTH = 3;
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, Color::WHITE, SEARCH_DEPTH);
+
+		agent.getMove();
+		const search::SearchStatistics& statistics = agent.getSearchStatistics();
+
+		EXPECT_EQ(SEARCH_DEPTH, statistics.depth);
+		EXPECT_GE(statistics.selectiveDepth, SEARCH_DEPTH);
+		EXPECT_EQ(agent.getNodeCount(), statistics.nodeCount);
+		EXPECT_LE(statistics.quiescenceNodeCount, statistics.nodeCount);
+		EXPECT_LE(statistics.firstMoveBetaCutoffCount, statistics.betaCutoffCount);
+		EXPECT_LE(statistics.transpositionHitCount, statistics.transpositionProbeCount);
+		EXPECT_GT(statistics.pawnHashHitCount, 0);
+		EXPECT_LE(statistics.pawnHashHitCount, statistics.pawnHashProbeCount);
+		EXPECT_GT(statistics.evaluationCacheHitCount, 0);
+		EXPECT_LE(statistics.evaluationCacheHitCount, statistics.evaluationCacheProbeCount);
+		EXPECT_GT(statistics.elapsedTime, 0.0);
+	}
+
+	TEST_F(AgentTest, analysis_distinctLinesOrderedByScore)
+	{
+		const Color COLOR = Color::WHITE;
+		const int LINE_COUNT = 3, SEARCH_DEPTH = 3;
+		chessState = std::make_unique<ChessState>("k7/8/1K6/8/8/8/7Q/8 w - - 0 1");
+		SearchAgent<> agent(*chessState, COLOR, SEARCH_DEPTH);
+
+		const std::vector<search::AnalysisLine> lines = agent.getAnalysis(LINE_COUNT);
+
+		ASSERT_EQ(LINE_COUNT, lines.size());
+		EXPECT_EQ(search::mateIn(1), lines.front().value);
+		for (size_t i = 0; i < lines.size(); i++)
+		{
+			EXPECT_EQ(SEARCH_DEPTH, lines[i].depth);
+			ASSERT_FALSE(lines[i].principalVariation.empty());
+			EXPECT_EQ(lines[i].move, lines[i].principalVariation.front());
+			for (size_t j = 0; j < i; j++)
+			{
+				EXPECT_NE(lines[j].move, lines[i].move);
+				EXPECT_GE(lines[j].value, lines[i].value);
+			}
+		}
+	}
+
+	TEST_F(AgentTest, analysis_principalVariationIsLegal)
+	{
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, Color::WHITE, 4);
+
+		const std::vector<search::AnalysisLine> lines = agent.getAnalysis(1);
+		ASSERT_EQ(1, lines.size());
+		EXPECT_GE(lines.front().principalVariation.size(), 2);
+
+		ChessState lineState(*chessState);
+		for (const Move& move : lines.front().principalVariation)
+		{
+			const Color player = lineState.getNextTurn();
+			ASSERT_TRUE(isValidMove(player, move.source, move.destination, lineState));
+			lineState.update(player, move);
+		}
+	}
+
+	TEST_F(AgentTest, timedSearch_stopsBeforeClockRunsOut)
+	{
+		const Color COLOR = Color::WHITE;
+		const double TIME_REMAINING = 1000000000.0; // 1 second in nanoseconds
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		const Move move = agent.getMove(TIME_REMAINING);
+		const double elapsedTime = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+		EXPECT_LT(elapsedTime, TIME_REMAINING);
+		EXPECT_TRUE(isValidMove(COLOR, move.source, move.destination, *chessState));
+	}
+
+	TEST_F(AgentTest, pondering_continuesIntoNextMove)
+	{
+		const Color COLOR = Color::WHITE, ENEMY_COLOR = Color::BLACK;
+		const double TIME_REMAINING = 1000000000.0; // 1 second in nanoseconds
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, COLOR, 3);
+
+		chessState->update(COLOR, agent.getMove(TIME_REMAINING));
+		agent.startPondering();
+
+		const std::vector<Move> enemyMoves = getValidMoves(*chessState, ENEMY_COLOR);
+		ASSERT_FALSE(enemyMoves.empty());
+		chessState->update(ENEMY_COLOR, enemyMoves.front());
+
+		const Move move = agent.getMove(TIME_REMAINING);
+
+		EXPECT_TRUE(isValidMove(COLOR, move.source, move.destination, *chessState));
+	}
+
+	TEST_F(AgentTest, searchLimits_maxDepth)
+	{
+		const double TIME_REMAINING = 60.0 * 60.0 * 1000000000.0; // 1 hour in nanoseconds
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, Color::WHITE, 3);
+		search::SearchLimits searchLimits;
+		searchLimits.maxDepth = 2;
+		agent.setSearchLimits(searchLimits);
+
+		agent.getMove(TIME_REMAINING);
+
+		EXPECT_EQ(2, agent.getSearchStatistics().depth);
+	}
+
+	TEST_F(AgentTest, searchLimits_maxNodes)
+	{
+		const uint64_t MAX_NODES = 50000;
+		const double TIME_REMAINING = 60.0 * 60.0 * 1000000000.0; // 1 hour in nanoseconds
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		SearchAgent<> agent(*chessState, Color::WHITE, 3);
+		search::SearchLimits searchLimits;
+		searchLimits.maxNodes = MAX_NODES;
+		agent.setSearchLimits(searchLimits);
+
+		const Move move = agent.getMove(TIME_REMAINING);
+
+		// Threads only check the limit periodically, so the search may overshoot it slightly
+		EXPECT_LT(agent.getSearchStatistics().nodeCount, MAX_NODES * 2);
+		EXPECT_TRUE(isValidMove(Color::WHITE, move.source, move.destination, *chessState));
+	}
+
+	TEST(ParameterRegistryTest, setTunableParameter_roundsAndClamps)
+	{
+		search::SearchParameters searchParameters;
+
+		search::setTunableParameter(searchParameters, "futilityMargin=212.6");
+		search::setTunableParameter(searchParameters, "nullMoveReduction=100");
+		search::setTunableParameter(searchParameters, "lateMoveReductionBase=0.5");
+
+		EXPECT_EQ(213, searchParameters.futilityMargin);
+		EXPECT_EQ((int)search::getTunableParameter("nullMoveReduction").maxValue, searchParameters.nullMoveReduction);
+		EXPECT_DOUBLE_EQ(0.5, searchParameters.lateMoveReductionBase);
+		EXPECT_ANY_THROW(search::setTunableParameter(searchParameters, "notAParameter=1"));
+		EXPECT_ANY_THROW(search::setTunableParameter(searchParameters, "futilityMargin"));
+	}
+}
@@ -0,0 +1,165 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/evaluation/evaluation.h"
+#include "../ChessAI/evaluation/pawnHashTable.h"
+#include "../ChessAI/evaluation/evaluationCache.h"
+#include "../ChessAI/evaluation/attackEvaluation.h"
+#include "../ChessAI/util/bitboard/bitboardUtil.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace evaluationTest
+{
+	class EvaluationTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+
+		static void expectIncrementalMatchesRecalculated(const ChessState& chessState)
+		{
+			const bitboard::BitboardSet& board = chessState.getBoard();
+			EXPECT_EQ(evaluation::getPieceSquareValue(board, Color::WHITE), evaluation::calculatePieceSquareValue(board, Color::WHITE));
+			EXPECT_EQ(evaluation::getPieceSquareValue(board, Color::BLACK), evaluation::calculatePieceSquareValue(board, Color::BLACK));
+		}
+	};
+
+	TEST_F(EvaluationTest, startingPosition_balanced)
+	{
+		ChessState chessState;
+
+		EXPECT_EQ(evaluation::getPieceSquareValue(chessState.getBoard(), Color::WHITE), 0);
+		EXPECT_EQ(chessState.getBoard().getPhase(), evaluation::MAX_PHASE);
+	}
+
+	TEST_F(EvaluationTest, mirroredPosition_sameValueForEachPlayer)
+	{
+		ChessState chessState("r1bqkb1r/pppp1ppp/2n2n2/4p3/4P3/2N2N2/PPPP1PPP/R1BQKB1R w KQkq - 4 4");
+
+		EXPECT_EQ(evaluation::getPieceSquareValue(chessState.getBoard(), Color::WHITE), 0);
+		EXPECT_EQ(evaluation::getPieceSquareValue(chessState.getBoard(), Color::BLACK), 0);
+	}
+
+	TEST_F(EvaluationTest, incremental_matchesRecalculated)
+	{
+		ChessState captures;
+		captures.update(Color::WHITE, Move(Position(4, 6), Position(4, 4)));
+		captures.update(Color::BLACK, Move(Position(3, 1), Position(3, 3)));
+		captures.update(Color::WHITE, Move(Position(4, 4), Position(3, 3)));
+		captures.update(Color::BLACK, Move(Position(3, 0), Position(3, 3)));
+		expectIncrementalMatchesRecalculated(captures);
+		EXPECT_EQ(captures.getBoard().getPhase(), evaluation::MAX_PHASE);
+
+		ChessState enPassant("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3");
+		enPassant.update(Color::WHITE, Move(Position(4, 3), Position(5, 2)));
+		expectIncrementalMatchesRecalculated(enPassant);
+
+		ChessState castling("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+		castling.update(Color::WHITE, Move(Position(4, 7), Position(6, 7)));
+		castling.update(Color::BLACK, Move(Position(4, 0), Position(2, 0)));
+		expectIncrementalMatchesRecalculated(castling);
+
+		ChessState promotion("8/P5k1/8/8/8/8/5K2/8 w - - 0 1");
+		promotion.update(Color::WHITE, Move(Position(0, 1), Position(0, 0)), PieceType::KNIGHT);
+		expectIncrementalMatchesRecalculated(promotion);
+		EXPECT_EQ(promotion.getBoard().getPhase(), evaluation::PHASE_WEIGHTS[PieceType::KNIGHT]);
+	}
+	TEST_F(EvaluationTest, pawnZobristKey_onlyChangesWithPawns)
+	{
+		ChessState chessState;
+		const uint64_t startingKey = chessState.getBoard().getPawnZobristKey();
+
+		chessState.update(Color::WHITE, Move(Position(6, 7), Position(5, 5)));
+		EXPECT_EQ(chessState.getBoard().getPawnZobristKey(), startingKey);
+
+		chessState.update(Color::BLACK, Move(Position(4, 1), Position(4, 3)));
+		EXPECT_NE(chessState.getBoard().getPawnZobristKey(), startingKey);
+
+		const ChessState fenState(chessState.getFenString());
+		EXPECT_EQ(chessState.getBoard().getPawnZobristKey(), fenState.getBoard().getPawnZobristKey());
+	}
+
+	TEST_F(EvaluationTest, pawnStructure_passedIsolatedDoubled)
+	{
+		// White: passed pawn on d5, doubled and isolated pawns on h2 and h3. Black: pawns on a7 and b7.
+		ChessState chessState("4k3/pp6/8/3P4/8/7P/7P/4K3 w - - 0 1");
+		const evaluation::PawnStructure pawnStructure = evaluation::calculatePawnStructure(chessState.getBoard());
+
+		EXPECT_EQ(pawnStructure.passedPawns[Color::WHITE], bitboard::positionToBitboard(3, 3) | bitboard::positionToBitboard(7, 5) | bitboard::positionToBitboard(7, 6));
+		EXPECT_EQ(pawnStructure.passedPawns[Color::BLACK], bitboard::positionToBitboard(0, 1) | bitboard::positionToBitboard(1, 1));
+		EXPECT_LT(evaluation::getPawnStructureValue(pawnStructure, 0, Color::WHITE), evaluation::getPawnStructureValue(evaluation::calculatePawnStructure(ChessState("4k3/pp6/8/3P4/8/8/6PP/4K3 w - - 0 1").getBoard()), 0, Color::WHITE));
+	}
+
+	TEST_F(EvaluationTest, pawnHashTable_storeAndProbe)
+	{
+		const ChessState chessState("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+		const uint64_t pawnKey = chessState.getBoard().getPawnZobristKey();
+		const evaluation::PawnStructure pawnStructure = evaluation::calculatePawnStructure(chessState.getBoard());
+		evaluation::PawnHashTable pawnHashTable(1);
+
+		EXPECT_FALSE(pawnHashTable.probe(pawnKey).has_value());
+		pawnHashTable.store(pawnKey, pawnStructure);
+
+		const std::optional<evaluation::PawnStructure> storedPawnStructure = pawnHashTable.probe(pawnKey);
+		ASSERT_TRUE(storedPawnStructure.has_value());
+		EXPECT_EQ(storedPawnStructure->middlegameScore, pawnStructure.middlegameScore);
+		EXPECT_EQ(storedPawnStructure->endgameScore, pawnStructure.endgameScore);
+		EXPECT_EQ(storedPawnStructure->passedPawns[Color::WHITE], pawnStructure.passedPawns[Color::WHITE]);
+		EXPECT_EQ(storedPawnStructure->passedPawns[Color::BLACK], pawnStructure.passedPawns[Color::BLACK]);
+		EXPECT_FALSE(pawnHashTable.probe(pawnKey ^ 1).has_value());
+	}
+	TEST_F(EvaluationTest, evaluationCache_storeAndProbe)
+	{
+		const uint64_t KEY = 0x123456789abcdef0, OTHER_KEY = KEY ^ (1ULL << 40);
+		const search::Score VALUE = -1234;
+		evaluation::EvaluationCache evaluationCache(1);
+
+		EXPECT_FALSE(evaluationCache.probe(KEY).has_value());
+		evaluationCache.store(KEY, VALUE);
+
+		ASSERT_TRUE(evaluationCache.probe(KEY).has_value());
+		EXPECT_EQ(evaluationCache.probe(KEY).value(), VALUE);
+		EXPECT_FALSE(evaluationCache.probe(OTHER_KEY).has_value());
+	}
+
+	TEST_F(EvaluationTest, evaluationCache_storeAtRangeLimit)
+	{
+		const uint64_t KEY = 0x123456789abcdef0;
+		evaluation::EvaluationCache evaluationCache(1);
+
+		evaluationCache.store(KEY, INT16_MAX);
+		EXPECT_EQ(evaluationCache.probe(KEY).value(), INT16_MAX);
+		evaluationCache.store(KEY, INT16_MIN);
+		EXPECT_EQ(evaluationCache.probe(KEY).value(), INT16_MIN);
+
+		evaluationCache.store(KEY, INT16_MAX + 1);
+		EXPECT_EQ(evaluationCache.probe(KEY).value(), INT16_MAX);
+		evaluationCache.store(KEY, INT16_MIN - 1);
+		EXPECT_EQ(evaluationCache.probe(KEY).value(), INT16_MIN);
+	}
+	TEST_F(EvaluationTest, attackEvaluation_mirroredPositionBalanced)
+	{
+		ChessState chessState("r1bqkb1r/pppp1ppp/2n2n2/4p3/4P3/2N2N2/PPPP1PPP/R1BQKB1R w KQkq - 4 4");
+		const evaluation::AttackEvaluation attackEvaluation = evaluation::calculateAttackEvaluation(chessState.getBoard());
+
+		EXPECT_EQ(attackEvaluation.middlegameScore, 0);
+		EXPECT_EQ(attackEvaluation.endgameScore, 0);
+		EXPECT_EQ(attackEvaluation.attackedPositions[Color::WHITE] & bitboard::positionToBitboard(3, 3), bitboard::positionToBitboard(3, 3));
+	}
+
+	TEST_F(EvaluationTest, attackEvaluation_hangingPiecePenalized)
+	{
+		// The black knight on d5 is attacked by the white rook and defended in only one of the positions
+		ChessState defended("4k3/8/4p3/3n4/8/8/8/3RK3 w - - 0 1");
+		ChessState hanging("4k3/8/8/3n4/8/8/8/3RK3 w - - 0 1");
+
+		const search::Score defendedValue = evaluation::getAttackValue(evaluation::calculateAttackEvaluation(defended.getBoard()), 0, Color::BLACK);
+		const search::Score hangingValue = evaluation::getAttackValue(evaluation::calculateAttackEvaluation(hanging.getBoard()), 0, Color::BLACK);
+		EXPECT_LT(hangingValue, defendedValue);
+	}
+}
\ No newline at end of file
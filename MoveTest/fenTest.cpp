@@ -0,0 +1,93 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/util/fen.h"
+
+#include <string_view>
+
+using namespace testing;
+using namespace util;
+
+namespace fenTest
+{
+	TEST(FenTest, parseAndWrite_roundTrip)
+	{
+		const std::vector<std::string> FEN_STRINGS = {
+			"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			"r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R b Kq - 3 10",
+			"8/8/4k3/3pP3/3K4/8/8/8 w - d6 0 41",
+			"rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3",
+			"7k/8/8/8/8/8/8/K7 w - - 100 250"
+		};
+
+		for (const std::string& fenString : FEN_STRINGS)
+		{
+			FenPosition fenPosition;
+			char buffer[MAX_FEN_LENGTH];
+
+			ASSERT_FALSE(parseFen(fenString, fenPosition).has_value()) << fenString;
+			EXPECT_EQ(fenString, std::string_view(buffer, writeFen(fenPosition, buffer)));
+			EXPECT_EQ(fenString, ChessState(fenString).getFenString());
+		}
+	}
+
+	TEST(FenTest, parse_turnCountsOptional)
+	{
+		FenPosition fenPosition;
+
+		ASSERT_FALSE(parseFen("4k3/8/8/8/8/8/8/4K3 b - -", fenPosition).has_value());
+		EXPECT_EQ(Color::BLACK, fenPosition.nextTurn);
+		EXPECT_EQ(0, fenPosition.halfTurnCount);
+		EXPECT_EQ(1, fenPosition.fullTurnCount);
+	}
+
+	TEST(FenTest, parsePrefix_ignoresTrailingFields)
+	{
+		const std::string FEN_STRING = "4k3/8/8/8/8/8/8/4K3 b - -";
+		const std::vector<std::pair<std::string, size_t>> LINES = {
+			{ FEN_STRING, FEN_STRING.size() },
+			{ FEN_STRING + " 3 20", FEN_STRING.size() + 5 },
+			{ FEN_STRING + " bm Kd7; id \"test\";", FEN_STRING.size() },
+			{ FEN_STRING + " 1-0", FEN_STRING.size() },
+			{ FEN_STRING + " 3 20 [0.5]", FEN_STRING.size() + 5 }
+		};
+
+		for (const auto& [line, length] : LINES)
+		{
+			FenPosition fenPosition;
+			size_t fenLength;
+
+			ASSERT_FALSE(parseFenPrefix(line, fenPosition, fenLength).has_value()) << line;
+			EXPECT_EQ(length, fenLength) << line;
+			EXPECT_EQ(Color::BLACK, fenPosition.nextTurn) << line;
+			EXPECT_EQ(length == FEN_STRING.size() ? 1 : 20, fenPosition.fullTurnCount) << line;
+		}
+
+		FenPosition fenPosition;
+		size_t fenLength;
+		EXPECT_TRUE(parseFenPrefix("4k3/8/8/8/8/8/8 b - - 0 1", fenPosition, fenLength).has_value());
+	}
+
+	TEST(FenTest, parse_errorOffsets)
+	{
+		const std::vector<std::pair<std::string, size_t>> INVALID_FEN_STRINGS = {
+			{ "4k3/1p7/8/8/8/8/8/4K3 w - - 0 1", 6 },
+			{ "4k3/8/8/8/8/8/8 w - - 0 1", 15 },
+			{ "4k3/8/8/8/8/8/8/4K3 x - - 0 1", 20 },
+			{ "4k3/8/8/8/8/8/8/4K3 w KX - 0 1", 23 },
+			{ "4k3/8/8/8/8/8/8/4K3 w - e3 0 1", 24 },
+			{ "4k3/8/8/8/8/8/8/4K3 w - - 0", 27 },
+			{ "4k3/8/8/8/8/8/8/4x3 w - - 0 1", 17 }
+		};
+
+		for (const auto& [fenString, offset] : INVALID_FEN_STRINGS)
+		{
+			FenPosition fenPosition;
+			const std::optional<FenError> error = parseFen(fenString, fenPosition);
+
+			ASSERT_TRUE(error.has_value()) << fenString;
+			EXPECT_EQ(offset, error->offset) << fenString;
+		}
+		EXPECT_ANY_THROW(ChessState("4k3/1p7/8/8/8/8/8/4K3 w - - 0 1"));
+	}
+}
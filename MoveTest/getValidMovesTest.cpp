@@ -333,7 +333,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/1P7/4P3/3B4/2P5/5P2/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/1P6/4P3/3B4/2P5/5P2/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> invalidMoves = {
 				Move(SOURCE, Position(4, 2)),
@@ -348,7 +348,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/1p7/4p3/3B4/2p5/5p2/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/1p6/4p3/3B4/2p5/5p2/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> captureMoves = {
 				Move(SOURCE, Position(4, 2)),
@@ -395,7 +395,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/8/3P4/2PR1P1/8/3P4/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/8/3P4/2PR1P2/8/3P4/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> invalidMoves = {
 				Move(SOURCE, Position(3, 2)),
@@ -410,7 +410,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/8/3p4/2pR1p1/8/3p4/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/8/3p4/2pR1p2/8/3p4/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> captureMoves = {
 				Move(SOURCE, Position(3, 2)),
@@ -474,7 +474,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/1P7/3PP3/2PQ1P1/2P5/3P1P2/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/1P6/3PP3/2PQ1P2/2P5/3P1P2/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> invalidMoves = {
 				Move(SOURCE, Position(4, 2)),
@@ -494,7 +494,7 @@ namespace getValidMovesTest
 		{
 			const Color COLOR = Color::WHITE;
 			const Position SOURCE = Position(3, 3);
-			chessState = std::make_unique<ChessState>("4k3/1p7/3pp3/2pQ1p1/2p5/3p1p2/8/4K3 w - - 0 1");
+			chessState = std::make_unique<ChessState>("4k3/1p6/3pp3/2pQ1p2/2p5/3p1p2/8/4K3 w - - 0 1");
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			const std::vector<Move> captureMoves = {
 				Move(SOURCE, Position(4, 2)),
@@ -593,5 +593,15 @@ namespace getValidMovesTest
 			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
 			EXPECT_THAT(validMoves, Contains(Move(SOURCE, DESTINATION)));
 		}
+
+		TEST_F(GetValidMovesTest, king_castle_throughAttackedPosition)
+		{
+			const Color COLOR = Color::WHITE;
+			const Position SOURCE = Position(4, 7);
+			const Position DESTINATION = SOURCE + RIGHT * 2;
+			chessState = std::make_unique<ChessState>("4kr2/8/8/8/8/8/8/4K2R w K - 0 1");
+			const std::vector<Move> validMoves = getValidMoves(*chessState, COLOR);
+			EXPECT_THAT(validMoves, Not(Contains(Move(SOURCE, DESTINATION))));
+		}
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include "../ChessAI/util/bitboard/bitboardUtil.h"
+
 using namespace testing;
 using namespace move;
 
@@ -53,4 +55,32 @@ namespace inCheckTest
 		chessState->print();
 		EXPECT_TRUE(inCheck(COLOR, *chessState));
 	}
+
+	TEST_F(InCheckTest, checkers_doubleCheck)
+	{
+		const Color COLOR = Color::WHITE;
+		chessState = std::make_unique<ChessState>("4r1k1/8/8/8/1b6/8/8/4K3 w - - 0 1");
+		const Bitboard expectedCheckers = util::bitboard::positionToBitboard(4, 0) | util::bitboard::positionToBitboard(1, 4);
+		EXPECT_EQ(chessState->getBoard().getCheckers(COLOR), expectedCheckers);
+		EXPECT_EQ(chessState->getBoard().getCheckers(Color::BLACK), 0);
+	}
+
+	TEST_F(InCheckTest, attackBoards_matchRecalculated)
+	{
+		chessState = std::make_unique<ChessState>("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+
+		for (int ply = 0; ply < 40 && chessState->getNextTurn() != Color::NEUTRAL; ply++)
+		{
+			const Color player = chessState->getNextTurn();
+			const std::vector<Move> validMoves = getValidMoves(*chessState, player);
+			ASSERT_FALSE(validMoves.empty());
+
+			chessState->update(player, validMoves[(ply * 7) % validMoves.size()]);
+			const util::bitboard::BitboardSet& board = chessState->getBoard();
+			for (int color = Color::WHITE; color < COLOR_COUNT; color++)
+			{
+				EXPECT_EQ(board.getAttackBoard((Color)color), board.calculateAttackBoard((Color)color));
+			}
+		}
+	}
 }
@@ -56,7 +56,7 @@ namespace makeMoveTest
 		const Color COLOR = Color::WHITE;
 		const Position SOURCE = Position(4, 6);
 		const Position DESTINATION = SOURCE + RIGHT + UP * 2;
-		chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN3/4K3 w - - 0 1");
+		chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN2/4K3 w - - 0 1");
 		const int CURRENT_HALF_TURNS = chessState->getHalfTurnCount();
 
 		chessState->update(COLOR, SOURCE, DESTINATION);
@@ -83,7 +83,7 @@ namespace makeMoveTest
 	//	const PieceType PIECE_TYPE = PieceType::KNIGHT;
 	//	const Position SOURCE = Position(4, 6);
 	//	const Position DESTINATION = SOURCE + RIGHT + UP * 2;
-	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN3/4K3 w - - 0 1");
+	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN2/4K3 w - - 0 1");
 	//	chessState->getMoveHistory().resize(MAX_MOVE_HISTORY_SIZE, MoveHistoryNode());
 
 	//	chessState->update(COLOR, SOURCE, DESTINATION);
@@ -98,7 +98,7 @@ namespace makeMoveTest
 	//	const PieceType PIECE_TYPE = PieceType::KNIGHT;
 	//	const Position SOURCE = Position(4, 6);
 	//	const Position DESTINATION = SOURCE + RIGHT + UP * 2;
-	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN3/4K3 w - - 8 8");
+	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN2/4K3 w - - 8 8");
 
 	//	chessState->getMoveHistory().resize(MAX_MOVE_HISTORY_SIZE - 1);
 	//	for (int i = 0; i < (MAX_MOVE_HISTORY_SIZE / 2) - 1; i++)
@@ -120,7 +120,7 @@ namespace makeMoveTest
 	//	const PieceType PIECE_TYPE = PieceType::KNIGHT;
 	//	const Position SOURCE = Position(4, 6);
 	//	const Position DESTINATION = SOURCE + RIGHT + UP * 2;
-	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN3/4K3 w - - 8 8");
+	//	chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4NN2/4K3 w - - 8 8");
 
 	//	chessState->getMoveHistory().resize(MAX_MOVE_HISTORY_SIZE - 1);
 	//	for (int i = 0; i < (MAX_MOVE_HISTORY_SIZE / 2) - 1; i++)
@@ -395,4 +395,50 @@ namespace makeMoveTest
 			EXPECT_FALSE(chessState->canKingSideCastle(COLOR));
 		}
 	}
+
+	namespace nullMove
+	{
+		TEST_F(MakeMoveTest, nullMove_updateTurn)
+		{
+			chessState = std::make_unique<ChessState>("4k3/8/8/8/8/8/4N3/4K3 w - - 0 1");
+			const Color CURRENT_TURN = chessState->getNextTurn();
+
+			chessState->makeNullMove();
+			EXPECT_EQ(~CURRENT_TURN, chessState->getNextTurn());
+		}
+
+		TEST_F(MakeMoveTest, nullMove_disableEnPassant)
+		{
+			const Color COLOR = Color::BLACK;
+			const Position SOURCE = Position(4, 1);
+			const Position DESTINATION = Position(4, 3);
+			chessState = std::make_unique<ChessState>("4k3/4p3/8/3P4/8/8/8/4K3 b - - 0 1");
+
+			chessState->update(COLOR, SOURCE, DESTINATION);
+			chessState->makeNullMove();
+			chessState->makeNullMove();
+
+			const std::vector<Move> moves = getValidMoves(*chessState, ~COLOR);
+			EXPECT_EQ(moves.end(), std::find(moves.begin(), moves.end(), Move(Position(3, 3), Position(4, 2))));
+		}
+
+		TEST_F(MakeMoveTest, unmakeNullMove_restoreState)
+		{
+			chessState = std::make_unique<ChessState>("4k3/4p3/8/3P4/8/8/8/4K3 b - - 0 1");
+			chessState->update(Color::BLACK, Position(4, 1), Position(4, 3));
+			// Fill the move history so the next null move evicts the oldest move
+			for (int i = 1; i < MAX_MOVE_HISTORY_SIZE; i++)
+			{
+				chessState->makeNullMove();
+			}
+			const std::string FEN = chessState->getFenString();
+			const std::deque<MoveHistoryNode> MOVE_HISTORY = chessState->getMoveHistory();
+
+			const std::optional<MoveHistoryNode> evictedMove = chessState->makeNullMove();
+			chessState->unmakeNullMove(evictedMove);
+
+			EXPECT_EQ(FEN, chessState->getFenString());
+			EXPECT_EQ(MOVE_HISTORY, chessState->getMoveHistory());
+		}
+	}
 }
\ No newline at end of file
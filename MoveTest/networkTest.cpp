@@ -0,0 +1,204 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/evaluation/network.h"
+#include "../ChessAI/evaluation/accumulatorStack.h"
+#include "../ChessAI/evaluation/evaluators.h"
+#include "../ChessAI/move/moveLookupTable.h"
+#include "../ChessAI/search/score.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace networkTest
+{
+	const uint32_t SEED = 7;
+
+	class NetworkTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+
+		void SetUp() override
+		{
+			std::unique_ptr<evaluation::Network> network = std::make_unique<evaluation::Network>();
+			network->randomize(SEED);
+			evaluation::setNetwork(std::move(network));
+		}
+
+		void TearDown() override
+		{
+			evaluation::setNetwork(nullptr);
+		}
+
+		static void expectAccumulatorMatchesRefresh(const evaluation::Accumulator* accumulator, const ChessState& chessState)
+		{
+			ASSERT_NE(accumulator, nullptr);
+			evaluation::Accumulator refreshedAccumulator;
+			for (int perspective = Color::WHITE; perspective < COLOR_COUNT; perspective++)
+			{
+				evaluation::getNetwork()->refreshAccumulator(refreshedAccumulator, chessState.getBoard(), (Color)perspective);
+				ASSERT_TRUE(accumulator->isValid[perspective]);
+				EXPECT_TRUE(std::equal(accumulator->values[perspective], accumulator->values[perspective] + evaluation::ACCUMULATOR_SIZE, refreshedAccumulator.values[perspective]));
+			}
+
+			EXPECT_EQ(evaluation::getNetwork()->getValue(*accumulator, Color::WHITE), evaluation::getNetwork()->getValueScalar(*accumulator, Color::WHITE));
+			EXPECT_EQ(evaluation::getNetwork()->getValue(*accumulator, Color::BLACK), evaluation::getNetwork()->getValueScalar(*accumulator, Color::BLACK));
+		}
+
+		/**
+		 * Pushes every game state after the first onto a new accumulator stack and checks the last one's accumulator.
+		 *
+		 * \param line the game states in the order they were reached
+		 */
+		static void expectLineMatchesRefresh(const std::vector<ChessState>& line)
+		{
+			evaluation::AccumulatorStack accumulatorStack;
+			accumulatorStack.reset(*evaluation::getNetwork(), line.front().getBoard());
+			for (size_t i = 1; i < line.size(); i++)
+			{
+				accumulatorStack.push(line[i].getBoard());
+			}
+			expectAccumulatorMatchesRefresh(accumulatorStack.getAccumulator(*evaluation::getNetwork(), line.back().getBoard()), line.back());
+		}
+
+		/**
+		 * Adds the game state reached by a move to the end of a line.
+		 */
+		static void playMove(std::vector<ChessState>& line, const Color player, const Move& move, const PieceType promotion = PieceType::QUEEN)
+		{
+			line.push_back(line.back());
+			line.back().update(player, move, promotion);
+		}
+	};
+
+	TEST_F(NetworkTest, accumulatorStack_matchesRefreshAfterMoves)
+	{
+		std::vector<ChessState> captures = { ChessState() };
+		playMove(captures, Color::WHITE, Move(Position(4, 6), Position(4, 4)));
+		playMove(captures, Color::BLACK, Move(Position(3, 1), Position(3, 3)));
+		playMove(captures, Color::WHITE, Move(Position(4, 4), Position(3, 3)));
+		playMove(captures, Color::BLACK, Move(Position(3, 0), Position(3, 3)));
+		expectLineMatchesRefresh(captures);
+
+		std::vector<ChessState> enPassant = { ChessState("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3") };
+		playMove(enPassant, Color::WHITE, Move(Position(4, 3), Position(5, 2)));
+		expectLineMatchesRefresh(enPassant);
+
+		std::vector<ChessState> castling = { ChessState("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1") };
+		playMove(castling, Color::WHITE, Move(Position(4, 7), Position(6, 7)));
+		playMove(castling, Color::BLACK, Move(Position(4, 0), Position(2, 0)));
+		expectLineMatchesRefresh(castling);
+
+		std::vector<ChessState> promotion = { ChessState("8/P5k1/8/8/8/8/5K2/8 w - - 0 1") };
+		playMove(promotion, Color::WHITE, Move(Position(0, 1), Position(0, 0)), PieceType::KNIGHT);
+		expectLineMatchesRefresh(promotion);
+	}
+
+	TEST_F(NetworkTest, accumulatorStack_siblingAfterPop_matchesRefresh)
+	{
+		std::vector<ChessState> line = { ChessState() };
+		playMove(line, Color::WHITE, Move(Position(4, 6), Position(4, 4)));
+		playMove(line, Color::BLACK, Move(Position(3, 1), Position(3, 3)));
+		ChessState sibling(line[1]);
+		sibling.update(Color::BLACK, Move(Position(6, 0), Position(5, 2)));
+
+		evaluation::AccumulatorStack accumulatorStack;
+		accumulatorStack.reset(*evaluation::getNetwork(), line[0].getBoard());
+		accumulatorStack.push(line[1].getBoard());
+		accumulatorStack.push(line[2].getBoard());
+		expectAccumulatorMatchesRefresh(accumulatorStack.getAccumulator(*evaluation::getNetwork(), line[2].getBoard()), line[2]);
+
+		accumulatorStack.pop();
+		accumulatorStack.push(sibling.getBoard());
+		expectAccumulatorMatchesRefresh(accumulatorStack.getAccumulator(*evaluation::getNetwork(), sibling.getBoard()), sibling);
+
+		accumulatorStack.pop();
+		expectAccumulatorMatchesRefresh(accumulatorStack.getAccumulator(*evaluation::getNetwork(), line[1].getBoard()), line[1]);
+	}
+
+	TEST_F(NetworkTest, accumulatorStack_onlyUsedForLastBoardAndNetwork)
+	{
+		std::vector<ChessState> line = { ChessState("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4") };
+		playMove(line, Color::WHITE, Move(Position(5, 5), Position(6, 3)));
+
+		evaluation::AccumulatorStack accumulatorStack;
+		accumulatorStack.reset(*evaluation::getNetwork(), line[0].getBoard());
+		accumulatorStack.push(line[1].getBoard());
+		EXPECT_EQ(accumulatorStack.getAccumulator(*evaluation::getNetwork(), line[0].getBoard()), nullptr);
+
+		evaluation::Network otherNetwork;
+		otherNetwork.randomize(SEED + 1);
+		EXPECT_EQ(accumulatorStack.getAccumulator(otherNetwork, line[1].getBoard()), nullptr);
+		EXPECT_NE(accumulatorStack.getAccumulator(*evaluation::getNetwork(), line[1].getBoard()), nullptr);
+	}
+
+	TEST_F(NetworkTest, networkEvaluator_lineMatchesNetworkValue)
+	{
+		std::vector<ChessState> line = { ChessState("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4") };
+		playMove(line, Color::WHITE, Move(Position(5, 5), Position(6, 3)));
+		playMove(line, Color::BLACK, Move(Position(3, 1), Position(3, 3)));
+
+		evaluation::NetworkEvaluator evaluator{ search::SearchParameters() };
+		search::SearchStatistics statistics;
+		evaluator.setRootState(line[0]);
+		evaluator.pushGameState(line[1]);
+		evaluator.pushGameState(line[2]);
+		EXPECT_EQ(evaluator.evaluate(line[2], Color::WHITE, statistics), evaluation::getNetworkValue(line[2].getBoard(), Color::WHITE));
+
+		// Game states outside the line are scored from scratch
+		EXPECT_EQ(evaluator.evaluate(line[1], Color::BLACK, statistics), evaluation::getNetworkValue(line[1].getBoard(), Color::BLACK));
+		evaluator.popGameState();
+		evaluator.popGameState();
+	}
+
+	TEST_F(NetworkTest, saveAndLoad_sameValue)
+	{
+		const ChessState chessState("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4");
+		const search::Score expectedValue = evaluation::getNetworkValue(chessState.getBoard(), Color::WHITE);
+
+		const std::string path = (std::filesystem::temp_directory_path() / "networkTest.nnue").string();
+		evaluation::getNetwork()->save(path);
+		evaluation::setNetwork(nullptr);
+		evaluation::loadNetwork(path);
+		std::filesystem::remove(path);
+
+		EXPECT_EQ(evaluation::getNetworkValue(chessState.getBoard(), Color::WHITE), expectedValue);
+	}
+	TEST_F(NetworkTest, getValue_saturatedAccumulator_belowMateScores)
+	{
+		// Overwrite the saved output weights so the player's half is maximally positive and the enemy's half maximally
+		// negative, then reload the network
+		const std::string path = (std::filesystem::temp_directory_path() / "networkTest.nnue").string();
+		evaluation::getNetwork()->save(path);
+		{
+			std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(3 * sizeof(uint32_t) + ((size_t)evaluation::HALFKP_FEATURE_COUNT + 1) * evaluation::ACCUMULATOR_SIZE * sizeof(int16_t));
+			for (int i = 0; i < COLOR_COUNT * evaluation::ACCUMULATOR_SIZE; i++)
+			{
+				const int16_t weight = i < evaluation::ACCUMULATOR_SIZE ? INT16_MAX : -INT16_MAX;
+				file.write((const char*)&weight, sizeof(weight));
+			}
+		}
+		evaluation::loadNetwork(path);
+		std::filesystem::remove(path);
+
+		evaluation::Accumulator accumulator;
+		std::fill(accumulator.values[Color::WHITE], accumulator.values[Color::WHITE] + evaluation::ACCUMULATOR_SIZE, INT16_MAX);
+		std::fill(accumulator.values[Color::BLACK], accumulator.values[Color::BLACK] + evaluation::ACCUMULATOR_SIZE, 0);
+		accumulator.isValid[Color::WHITE] = accumulator.isValid[Color::BLACK] = true;
+
+		EXPECT_EQ(evaluation::getNetwork()->getValue(accumulator, Color::WHITE), search::SCORE_MATE_IN_MAX_PLY - 1);
+		EXPECT_EQ(evaluation::getNetwork()->getValueScalar(accumulator, Color::WHITE), search::SCORE_MATE_IN_MAX_PLY - 1);
+		EXPECT_EQ(evaluation::getNetwork()->getValue(accumulator, Color::BLACK), -(search::SCORE_MATE_IN_MAX_PLY - 1));
+		EXPECT_EQ(evaluation::getNetwork()->getValueScalar(accumulator, Color::BLACK), -(search::SCORE_MATE_IN_MAX_PLY - 1));
+		EXPECT_FALSE(search::isMateScore(evaluation::getNetwork()->getValue(accumulator, Color::WHITE)));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/util/packedPosition.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace packedPositionTest
+{
+	class PackedPositionTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+	};
+
+	TEST_F(PackedPositionTest, position_roundTrip)
+	{
+		const std::vector<std::string> FEN_STRINGS = {
+			"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			"r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R b Kq - 3 10",
+			"8/8/4k3/3pP3/3K4/8/8/8 w - d6 0 41",
+			"rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 3"
+		};
+
+		for (const std::string& fenString : FEN_STRINGS)
+		{
+			const ChessState chessState(fenString);
+
+			const ChessState decodedState = decodePosition(encodePosition(chessState));
+
+			EXPECT_EQ(fenString, decodedState.getFenString());
+			EXPECT_EQ(chessState.getZobristKey(), decodedState.getZobristKey());
+		}
+	}
+
+	TEST_F(PackedPositionTest, board_roundTrip)
+	{
+		const ChessState chessState("r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R w KQkq - 0 10");
+
+		const PackedPosition packedPosition = encodeBoard(chessState.getBoard());
+
+		EXPECT_TRUE(chessState.getBoard() == decodeBoard(packedPosition));
+		EXPECT_EQ(Color::WHITE, getNextTurn(packedPosition));
+		EXPECT_EQ(NO_EN_PASSANT_FILE, packedPosition.enPassantFile);
+	}
+
+	TEST_F(PackedPositionTest, position_enPassantWithoutPawnIgnored)
+	{
+		PackedPosition packedPosition = encodePosition(ChessState("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1"));
+		packedPosition.enPassantFile = 4;
+
+		const ChessState decodedState = decodePosition(packedPosition);
+
+		EXPECT_FALSE(decodedState.getEnPassantFile().has_value());
+		EXPECT_EQ("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1", decodedState.getFenString());
+	}
+
+	TEST_F(PackedPositionTest, position_invalidFieldsThrow)
+	{
+		const PackedPosition packedPosition = encodePosition(ChessState("4k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+
+		PackedPosition invalidPieceCode = packedPosition;
+		invalidPieceCode.pieces[0] = (uint8_t)((invalidPieceCode.pieces[0] & 0xF0) | PIECE_TYPE_COUNT);
+		EXPECT_ANY_THROW(decodeBoard(invalidPieceCode));
+
+		PackedPosition invalidEnPassantFile = packedPosition;
+		invalidEnPassantFile.enPassantFile = FILE_COUNT;
+		EXPECT_ANY_THROW(decodePosition(invalidEnPassantFile));
+
+		PackedPosition tooManyPieces = packedPosition;
+		tooManyPieces.occupancy = ~0ULL;
+		EXPECT_ANY_THROW(decodeBoard(tooManyPieces));
+	}
+}
@@ -0,0 +1,122 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/move/san.h"
+#include "../ChessAI/util/pgn.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+using namespace testing;
+using namespace move;
+using namespace util;
+
+namespace pgnTest
+{
+	class SanTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+	};
+
+	TEST_F(SanTest, parseSan_disambiguation)
+	{
+		const ChessState fileState("k7/8/8/8/8/8/8/R4R1K w - - 0 1");
+		EXPECT_EQ(Move(Position(0, 7), Position(3, 7)), parseSan(fileState, "Rad1"));
+		EXPECT_FALSE(parseSan(fileState, "Rd1").has_value());
+		EXPECT_EQ("Rad1", toSan(fileState, Move(Position(0, 7), Position(3, 7))));
+
+		const ChessState rankState("7k/8/8/R7/8/8/8/R6K w - - 0 1");
+		EXPECT_EQ(Move(Position(0, 7), Position(0, 5)), parseSan(rankState, "R1a3"));
+		EXPECT_EQ("R1a3", toSan(rankState, Move(Position(0, 7), Position(0, 5))));
+
+		// The pinned knight cannot reach d4, so the other knight needs no disambiguation
+		const ChessState pinState("4k3/8/8/8/4r3/8/2N1N3/4K3 w - - 0 1");
+		EXPECT_EQ(Move(Position(2, 6), Position(3, 4)), parseSan(pinState, "Nd4"));
+		EXPECT_EQ("Nd4", toSan(pinState, Move(Position(2, 6), Position(3, 4))));
+	}
+
+	TEST_F(SanTest, parseSan_specialMoves)
+	{
+		const ChessState castleState("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+		EXPECT_EQ(Move(Position(4, 7), Position(6, 7)), parseSan(castleState, "O-O"));
+		EXPECT_EQ(Move(Position(4, 7), Position(2, 7)), parseSan(castleState, "0-0-0"));
+		EXPECT_EQ("O-O-O", toSan(castleState, Move(Position(4, 7), Position(2, 7))));
+
+		const ChessState promotionState("8/P6k/8/8/8/8/8/K7 w - - 0 1");
+		EXPECT_EQ(Move(Position(0, 1), Position(0, 0), PieceType::KNIGHT), parseSan(promotionState, "a8=N"));
+		EXPECT_EQ(Move(Position(0, 1), Position(0, 0), PieceType::QUEEN), parseSan(promotionState, "a8"));
+		EXPECT_EQ("a8=R", toSan(promotionState, Move(Position(0, 1), Position(0, 0), PieceType::ROOK)));
+
+		const ChessState enPassantState("8/8/4k3/3pP3/3K4/8/8/8 w - d6 0 1");
+		EXPECT_EQ(Move(Position(4, 3), Position(3, 2)), parseSan(enPassantState, "exd6"));
+		EXPECT_EQ("exd6", toSan(enPassantState, Move(Position(4, 3), Position(3, 2))));
+
+		const ChessState mateState("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+		EXPECT_EQ(Move(Position(0, 7), Position(0, 0)), parseSan(mateState, "Ra8#"));
+		EXPECT_EQ("Ra8#", toSan(mateState, Move(Position(0, 7), Position(0, 0))));
+	}
+
+	TEST_F(SanTest, parseSan_illegal)
+	{
+		const ChessState chessState;
+
+		EXPECT_FALSE(parseSan(chessState, "e5").has_value());
+		EXPECT_FALSE(parseSan(chessState, "Nf6").has_value());
+		EXPECT_FALSE(parseSan(chessState, "O-O").has_value());
+		EXPECT_FALSE(parseSan(chessState, "e4=Q").has_value());
+		EXPECT_FALSE(parseSan(chessState, "Zz9").has_value());
+	}
+
+	TEST(PgnTest, readAndReplay)
+	{
+		const std::string_view PGN_TEXT =
+			"[Event \"One\"]\n"
+			"[White \"A \\\"quoted\\\" name\"]\n"
+			"\n"
+			"1.e4 {Best by test\n"
+			"[not a tag]} e5 2. Nf3 $1 (2. f4 exf4 (2... d5)) Nc6 3. Bb5 a6 ; line comment\n"
+			"4. Ba4 Nf6 5. O-O 1-0\n"
+			"\n"
+			"[Event \"Two\"]\n"
+			"[FEN \"8/P6k/8/8/8/8/8/K7 w - - 0 1\"]\n"
+			"\n"
+			"1. a8=N Kg6 2. Nc7 *\n";
+
+		size_t offset = 0;
+		const std::string_view firstGameText = readPgnGame(PGN_TEXT, offset);
+		const std::string_view secondGameText = readPgnGame(PGN_TEXT, offset);
+		EXPECT_TRUE(readPgnGame(PGN_TEXT, offset).empty());
+
+		PgnGame game;
+		ASSERT_FALSE(parsePgnGame(firstGameText, game).has_value());
+		EXPECT_EQ("One", game.getTag("Event"));
+		EXPECT_EQ("A \\\"quoted\\\" name", game.getTag("White"));
+		EXPECT_EQ(std::vector<std::string_view>({ "e4", "e5", "Nf3", "Nc6", "Bb5", "a6", "Ba4", "Nf6", "O-O" }), game.moves);
+		EXPECT_EQ("1-0", game.result);
+
+		std::vector<Move> moves;
+		EXPECT_FALSE(replayPgnGame(game, [&moves](const ChessState& chessState, const Move& move) { moves.push_back(move); }).has_value());
+		ASSERT_EQ(9, moves.size());
+		EXPECT_EQ(Move(Position(4, 7), Position(6, 7)), moves.back());
+
+		ASSERT_FALSE(parsePgnGame(secondGameText, game).has_value());
+		EXPECT_EQ("*", game.result);
+		moves.clear();
+		EXPECT_FALSE(replayPgnGame(game, [&moves](const ChessState& chessState, const Move& move) { moves.push_back(move); }).has_value());
+		ASSERT_EQ(3, moves.size());
+		EXPECT_EQ(PieceType::KNIGHT, moves.front().promotion);
+	}
+
+	TEST(PgnTest, replay_illegalMove)
+	{
+		const std::string_view GAME_TEXT = "[Event \"Illegal\"]\n\n1. e4 e5 2. Ke3 *\n";
+
+		PgnGame game;
+		ASSERT_FALSE(parsePgnGame(GAME_TEXT, game).has_value());
+
+		const std::optional<PgnError> error = replayPgnGame(game);
+		ASSERT_TRUE(error.has_value());
+		EXPECT_EQ(GAME_TEXT.find("Ke3"), error->offset);
+	}
+}
@@ -0,0 +1,33 @@
+#include "pch.h"
+
+#include "../ChessAI/tools/selfPlay.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace testing;
+
+namespace selfPlayTest
+{
+	TEST(SelfPlayTest, runConcurrently_runsEveryTask)
+	{
+		const size_t TASK_COUNT = 16;
+		std::atomic<size_t> indexSum = 0;
+
+		tools::runConcurrently(TASK_COUNT, 4, [&indexSum](const size_t taskIndex) {
+			indexSum += taskIndex;
+		});
+
+		EXPECT_EQ(TASK_COUNT * (TASK_COUNT - 1) / 2, indexSum.load());
+	}
+
+	TEST(SelfPlayTest, runConcurrently_rethrowsTaskException)
+	{
+		EXPECT_THROW(tools::runConcurrently(16, 4, [](const size_t taskIndex) {
+			if (taskIndex == 3)
+			{
+				throw std::runtime_error("Task failed");
+			}
+		}), std::runtime_error);
+	}
+}
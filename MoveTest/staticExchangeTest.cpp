@@ -0,0 +1,58 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/search/staticExchange.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace staticExchangeTest
+{
+	class StaticExchangeTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+
+		void TearDown() override
+		{
+			if (chessState)
+			{
+				chessState.release();
+			}
+		}
+
+		std::unique_ptr<ChessState> chessState;
+	};
+
+	TEST_F(StaticExchangeTest, undefendedCapture)
+	{
+		chessState = std::make_unique<ChessState>("4k3/8/8/3p4/8/8/8/3RK3 w - - 0 1");
+
+		EXPECT_EQ(100, search::getStaticExchangeValue(*chessState, Color::WHITE, Move(Position(3, 7), Position(3, 3))));
+	}
+
+	TEST_F(StaticExchangeTest, defendedCapture)
+	{
+		chessState = std::make_unique<ChessState>("4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1");
+
+		EXPECT_EQ(-400, search::getStaticExchangeValue(*chessState, Color::WHITE, Move(Position(3, 7), Position(3, 3))));
+	}
+
+	TEST_F(StaticExchangeTest, xRayRecapture)
+	{
+		chessState = std::make_unique<ChessState>("3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1");
+
+		EXPECT_EQ(100, search::getStaticExchangeValue(*chessState, Color::WHITE, Move(Position(3, 6), Position(3, 3))));
+	}
+
+	TEST_F(StaticExchangeTest, enPassant)
+	{
+		chessState = std::make_unique<ChessState>("4k3/8/8/3Pp3/8/8/8/4K3 w - e6 0 1");
+
+		EXPECT_EQ(100, search::getStaticExchangeValue(*chessState, Color::WHITE, Move(Position(3, 3), Position(4, 2))));
+	}
+}
@@ -0,0 +1,97 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/tools/trainingData.h"
+#include "../ChessAI/util/mappedRecordFile.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace trainingDataTest
+{
+	class TrainingDataTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+	};
+
+	TEST_F(TrainingDataTest, trainingDataFile_writeAndMap)
+	{
+		const std::string PATH = "trainingDataTest" + tools::TRAINING_DATA_EXTENSION;
+		const std::vector<std::string> FEN_STRINGS = {
+			"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			"r3k2r/pp1n1ppp/2pbpn2/q7/3P4/2NBPN2/PP3PPP/R2QK2R b Kq - 3 10",
+			"8/8/4k3/3pP3/3K4/8/8/8 w - d6 0 41"
+		};
+		std::remove(PATH.c_str());
+
+		{
+			tools::TrainingDataWriter writer(PATH);
+			for (size_t i = 0; i < FEN_STRINGS.size(); i++)
+			{
+				writer.write(tools::encodeTrainingRecord(ChessState(FEN_STRINGS[i]), (search::Score)i * 10, i / 2.0));
+			}
+		}
+
+		{
+			const util::MappedRecordFile<tools::TrainingRecord> trainingData(PATH);
+			ASSERT_EQ(FEN_STRINGS.size(), trainingData.size());
+			for (size_t i = 0; i < FEN_STRINGS.size(); i++)
+			{
+				EXPECT_EQ(FEN_STRINGS[i], tools::decodeTrainingRecord(trainingData[i]).getFenString());
+				EXPECT_EQ(i * 10, trainingData[i].score);
+				EXPECT_DOUBLE_EQ(i / 2.0, tools::getTrainingResult(trainingData[i]));
+			}
+
+			std::atomic<size_t> visitedCount = 0;
+			trainingData.parallelForEach(2, [&visitedCount](const std::span<const tools::TrainingRecord> records, const size_t chunkIndex) {
+				visitedCount += records.size();
+			});
+			EXPECT_EQ(FEN_STRINGS.size(), visitedCount.load());
+
+			// Every chunk is still processed when one of them throws
+			visitedCount = 0;
+			EXPECT_THROW(trainingData.parallelForEach(FEN_STRINGS.size(), [&visitedCount](const std::span<const tools::TrainingRecord> records, const size_t chunkIndex) {
+				visitedCount += records.size();
+				if (chunkIndex == 0)
+				{
+					throw std::runtime_error("Chunk failed");
+				}
+			}), std::runtime_error);
+			EXPECT_EQ(FEN_STRINGS.size(), visitedCount.load());
+		}
+
+		std::remove(PATH.c_str());
+	}
+
+	TEST_F(TrainingDataTest, trainingDataWriter_truncate)
+	{
+		const std::string PATH = "trainingDataTruncateTest" + tools::TRAINING_DATA_EXTENSION;
+		std::remove(PATH.c_str());
+
+		for (const bool truncate : { false, false, true })
+		{
+			tools::TrainingDataWriter writer(PATH, truncate);
+			writer.write(tools::encodeTrainingRecord(ChessState(), 0, 0.5));
+		}
+
+		EXPECT_EQ((size_t)1, util::MappedRecordFile<tools::TrainingRecord>(PATH).size());
+		std::remove(PATH.c_str());
+	}
+
+	TEST_F(TrainingDataTest, trainingRecord_scoreClamped)
+	{
+		const tools::TrainingRecord record = tools::encodeTrainingRecord(ChessState(), 100000, 1.0);
+
+		EXPECT_EQ(INT16_MAX, record.score);
+		EXPECT_DOUBLE_EQ(1.0, tools::getTrainingResult(record));
+	}
+}
@@ -0,0 +1,79 @@
+#include "pch.h"
+
+#include "../ChessAI/chess.h"
+#include "../ChessAI/search/transpositionTable.h"
+#include "../ChessAI/move/moveLookupTable.h"
+
+using namespace testing;
+using namespace util;
+using namespace move;
+
+namespace transpositionTableTest
+{
+	class TranspositionTableTest : public testing::Test {
+	protected:
+		static void SetUpTestSuite()
+		{
+			populateLookupTables();
+		}
+	};
+
+	TEST_F(TranspositionTableTest, zobristKey_transposition)
+	{
+		ChessState knightsFirst, bishopsFirst;
+
+		knightsFirst.update(Color::WHITE, Move(Position(6, 7), Position(5, 5)));
+		knightsFirst.update(Color::BLACK, Move(Position(6, 0), Position(5, 2)));
+		knightsFirst.update(Color::WHITE, Move(Position(1, 7), Position(2, 5)));
+		knightsFirst.update(Color::BLACK, Move(Position(1, 0), Position(2, 2)));
+
+		bishopsFirst.update(Color::WHITE, Move(Position(1, 7), Position(2, 5)));
+		bishopsFirst.update(Color::BLACK, Move(Position(1, 0), Position(2, 2)));
+		bishopsFirst.update(Color::WHITE, Move(Position(6, 7), Position(5, 5)));
+		bishopsFirst.update(Color::BLACK, Move(Position(6, 0), Position(5, 2)));
+
+		EXPECT_EQ(knightsFirst.getZobristKey(), bishopsFirst.getZobristKey());
+		EXPECT_EQ(ChessState(knightsFirst.getFenString()).getZobristKey(), knightsFirst.getZobristKey());
+	}
+
+	TEST_F(TranspositionTableTest, zobristKey_sideToMoveAndCastling)
+	{
+		const ChessState white("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+		const ChessState black("r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1");
+		const ChessState noCastling("r3k2r/8/8/8/8/8/8/R3K2R w - - 0 1");
+
+		EXPECT_NE(white.getZobristKey(), black.getZobristKey());
+		EXPECT_NE(white.getZobristKey(), noCastling.getZobristKey());
+	}
+
+	TEST_F(TranspositionTableTest, storeAndProbe)
+	{
+		search::TranspositionTable transpositionTable(1);
+		const Move move(Position(4, 6), Position(4, 4));
+
+		EXPECT_FALSE(transpositionTable.probe(12345, 0).has_value());
+
+		transpositionTable.store(12345, 0, move, -42, 5, search::Bound::LOWER);
+		const std::optional<search::TranspositionEntry> entry = transpositionTable.probe(12345, 0);
+
+		ASSERT_TRUE(entry.has_value());
+		EXPECT_EQ(move, entry->move);
+		EXPECT_EQ(-42, entry->value);
+		EXPECT_EQ(5, entry->depth);
+		EXPECT_EQ(search::Bound::LOWER, entry->bound);
+		EXPECT_FALSE(transpositionTable.probe(54321, 0).has_value());
+	}
+
+	TEST_F(TranspositionTableTest, storeAndProbe_mateScoreRelativeToPly)
+	{
+		search::TranspositionTable transpositionTable(1);
+
+		// Mate in 5 plies from a node 3 plies below the root is mate in 4 plies from a node 2 plies below the root
+		transpositionTable.store(12345, 3, std::nullopt, search::mateIn(8), 2, search::Bound::EXACT);
+		const std::optional<search::TranspositionEntry> entry = transpositionTable.probe(12345, 2);
+
+		ASSERT_TRUE(entry.has_value());
+		EXPECT_FALSE(entry->move.has_value());
+		EXPECT_EQ(search::mateIn(7), entry->value);
+	}
+}
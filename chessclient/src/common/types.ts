@@ -8,4 +8,10 @@ export type Piece = {
 export type Position = {
     x: number;
     y: number;
+};
+
+export type SearchLimits = {
+    maxNodes?: number;
+    maxDepth?: number;
+    moveTime?: number; // milliseconds
 };
\ No newline at end of file
@@ -1,5 +1,5 @@
 import { MessageType, GameType, Color, PieceType } from '../common/enums';
-import { PiecePayload, Position } from '../common/types'
+import { PiecePayload, Position, SearchLimits } from '../common/types'
 import { MessageError } from '../common/errors';
 
 /**
@@ -49,17 +49,19 @@ export abstract class Message {
 */
 export class StartGameRequest extends Message {
     gameType: GameType | null = null;
+    searchLimits: SearchLimits = {};
 
     /**
      * Creates an instance of StartGameRequest.
      * 
      * @param data The data used to populate the message
      */
-    constructor(data: { gameType: GameType } | null = null) {
+    constructor(data: { gameType: GameType, searchLimits?: SearchLimits } | null = null) {
         super(MessageType.StartGameRequest);
 
         if (data) {
             this.gameType = data.gameType;
+            this.searchLimits = data.searchLimits ?? {};
         }
     }
 
@@ -67,11 +69,17 @@ export class StartGameRequest extends Message {
         const data = JSON.parse(json)['data'];
 
         this.gameType = data['gameType'] as GameType;
+        this.searchLimits = {
+            maxNodes: data['maxNodes'],
+            maxDepth: data['maxDepth'],
+            moveTime: data['moveTime']
+        };
     }
 
     getData(): object {
         return {
-            gameType: this.gameType
+            gameType: this.gameType,
+            ...this.searchLimits
         };
     }
 }